@@ -1094,6 +1094,9 @@ static bool handle_hid_report_subscriber_event(const struct hid_report_subscribe
 
 		__ASSERT_NO_MSG(sub);
 
+		LOG_DBG("%" PRIu32 " HID reports coalesced",
+			hid_reportq_get_coalesced_cnt(sub->in_reportq));
+
 		hid_reportq_free(sub->in_reportq);
 		sub->in_reportq = NULL;
 		clear_hid_out_reports(sub);
@@ -25,6 +25,8 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(MODULE, CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_LOG_LEVEL);
 
+#define EVENTQ_SIZE	CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_EVENT_QUEUE_SIZE
+
 struct report_data {
 	struct hid_eventq eventq;
 	struct keys_state keys_state;
@@ -35,6 +37,7 @@ static const struct hid_state_api *hid_state_api;
 static const void *active_sub;
 static bool boot_mode;
 static struct report_data report_data;
+static struct hid_eventq_event eventq_buf[EVENTQ_SIZE];
 
 
 static void clear_report_data(struct report_data *rd)
@@ -300,8 +303,7 @@ static bool handle_button_event(const struct button_event *event)
 
 static void init(void)
 {
-	hid_eventq_init(&report_data.eventq,
-			CONFIG_DESKTOP_HID_REPORT_PROVIDER_KEYBOARD_EVENT_QUEUE_SIZE);
+	hid_eventq_init(&report_data.eventq, eventq_buf, ARRAY_SIZE(eventq_buf));
 	keys_state_init(&report_data.keys_state, KEYBOARD_REPORT_KEY_COUNT_MAX);
 
 	static const struct hid_report_provider_api provider_api_keyboard = {
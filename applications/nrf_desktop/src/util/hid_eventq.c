@@ -7,22 +7,12 @@
 #include "hid_eventq.h"
 
 #include <zephyr/types.h>
-#include <zephyr/sys/slist.h>
 #include <zephyr/kernel.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(hid_eventq, CONFIG_DESKTOP_HID_EVENTQ_LOG_LEVEL);
 
-struct hid_eventq_data {
-	uint16_t key_id;
-	bool pressed;
-};
-
-struct hid_eventq_event {
-	sys_snode_t node;
-	struct hid_eventq_data data;
-	int64_t timestamp;
-};
+#define POS_NOT_FOUND	(-1)
 
 
 static bool hid_eventq_is_initialized(const struct hid_eventq *q)
@@ -32,15 +22,17 @@ static bool hid_eventq_is_initialized(const struct hid_eventq *q)
 	return (q->cnt_max != 0);
 }
 
-void hid_eventq_init(struct hid_eventq *q, uint16_t max_queued)
+void hid_eventq_init(struct hid_eventq *q, struct hid_eventq_event *events, uint16_t max_queued)
 {
 	LOG_DBG("q:%p, max_queued:%" PRIu16, (void *)q, max_queued);
 
 	ARG_UNUSED(hid_eventq_is_initialized);
 	__ASSERT_NO_MSG(!hid_eventq_is_initialized(q));
+	__ASSERT_NO_MSG(events);
 	__ASSERT_NO_MSG(max_queued > 0);
 
-	sys_slist_init(&q->root);
+	q->events = events;
+	q->head = 0;
 	q->cnt = 0;
 	q->cnt_max = max_queued;
 }
@@ -61,26 +53,30 @@ bool hid_eventq_is_empty(const struct hid_eventq *q)
 	return (q->cnt == 0);
 }
 
+/* Get event at given position, counting from the oldest enqueued event. */
+static struct hid_eventq_event *event_at(struct hid_eventq *q, size_t pos)
+{
+	__ASSERT_NO_MSG(pos < q->cnt);
+
+	return &q->events[(q->head + pos) % q->cnt_max];
+}
+
 static void drop_oldest_hid_events(struct hid_eventq *q)
 {
 	LOG_DBG("q:%p", (void *)q);
 
 	__ASSERT_NO_MSG(hid_eventq_is_full(q));
 
-	sys_snode_t *i;
-
-	SYS_SLIST_FOR_EACH_NODE(&q->root, i) {
+	for (size_t pos = 0; pos < q->cnt; pos++) {
 		/* Try to remove events but only if key release was generated for each removed key
 		 * press.
 		 */
-		int64_t node_timestamp = CONTAINER_OF(i, struct hid_eventq_event, node)->timestamp;
+		int64_t timestamp = event_at(q, pos)->timestamp;
 
 		/* Use incremented event timestamp to drop the event. */
-		hid_eventq_cleanup(q, node_timestamp + 1);
+		hid_eventq_cleanup(q, timestamp + 1);
 		if (!hid_eventq_is_full(q)) {
-			/* At least one element was removed from the queue.
-			 * Do not continue list traverse, content was modified!
-			 */
+			/* At least one element was removed from the queue. */
 			break;
 		}
 	}
@@ -100,24 +96,18 @@ int hid_eventq_keypress_enqueue(struct hid_eventq *q, uint16_t id, bool pressed,
 		}
 	}
 
-	struct hid_eventq_event *evt = k_malloc(sizeof(*evt));
+	/* Add a new event to the queue. */
+	q->cnt++;
 
-	if (!evt) {
-		LOG_ERR("hid_eventq_event allocation failed");
-		return -ENOMEM;
-	}
+	struct hid_eventq_event *evt = event_at(q, q->cnt - 1);
 
 	evt->timestamp = k_uptime_get();
-	evt->data.key_id = id;
-	evt->data.pressed = pressed;
+	evt->key_id = id;
+	evt->pressed = pressed;
 
 	LOG_DBG("q:%p, ts:%" PRId64 ", id:%" PRIu16 ", %s",
 		(void *)q, evt->timestamp, id, pressed ? "press" : "release");
 
-	/* Add a new event to the queue. */
-	sys_slist_append(&q->root, &evt->node);
-	q->cnt++;
-
 	return 0;
 }
 
@@ -127,49 +117,33 @@ int hid_eventq_keypress_dequeue(struct hid_eventq *q, uint16_t *id, bool *presse
 	__ASSERT_NO_MSG(id);
 	__ASSERT_NO_MSG(pressed);
 
-	sys_snode_t *n = sys_slist_get(&q->root);
-
-	if (!n) {
+	if (q->cnt == 0) {
 		return -ENOENT;
 	}
 
-	struct hid_eventq_event *evt = CONTAINER_OF(n, struct hid_eventq_event, node);
+	const struct hid_eventq_event *evt = event_at(q, 0);
 
-	*id = evt->data.key_id;
-	*pressed = evt->data.pressed;
+	*id = evt->key_id;
+	*pressed = evt->pressed;
 
 	LOG_DBG("q:%p, ts:%" PRId64 ", id:%" PRIu16 ", %s",
 		(void *)q, evt->timestamp, *id, *pressed ? "press" : "release");
 
-	k_free(evt);
+	q->head = (q->head + 1) % q->cnt_max;
 	q->cnt--;
 
 	return 0;
 }
 
-static void hid_eventq_region_purge(struct hid_eventq *q, sys_snode_t *last_to_purge)
+static void hid_eventq_region_purge(struct hid_eventq *q, size_t purge_cnt)
 {
-	sys_snode_t *tmp;
-	sys_snode_t *tmp_safe;
-	size_t removed_cnt = 0;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&q->root, tmp, tmp_safe) {
-		__ASSERT_NO_MSG(tmp);
-
-		sys_slist_remove(&q->root, NULL, tmp);
-		k_free(CONTAINER_OF(tmp, struct hid_eventq_event, node));
-		removed_cnt++;
-
-		if (tmp == last_to_purge) {
-			break;
-		}
-	}
+	__ASSERT_NO_MSG(q->cnt >= purge_cnt);
 
-	__ASSERT_NO_MSG(q->cnt >= removed_cnt);
-	q->cnt -= removed_cnt;
+	q->head = (q->head + purge_cnt) % q->cnt_max;
+	q->cnt -= purge_cnt;
 
-	if (removed_cnt > 0) {
-		LOG_WRN("%u stale events removed from the queue %p", removed_cnt, (void *)q);
+	if (purge_cnt > 0) {
+		LOG_WRN("%zu stale events removed from the queue %p", purge_cnt, (void *)q);
 	}
 }
 
@@ -179,51 +153,45 @@ void hid_eventq_reset(struct hid_eventq *q)
 
 	LOG_DBG("q:%p", (void *)q);
 
-	hid_eventq_region_purge(q, NULL);
+	hid_eventq_region_purge(q, q->cnt);
 
 	__ASSERT_NO_MSG(q->cnt == 0);
-	__ASSERT_NO_MSG(sys_slist_is_empty(&q->root));
 }
 
-static sys_snode_t *get_first_valid_node(struct hid_eventq *q, int64_t min_timestamp)
+static size_t get_first_valid_pos(struct hid_eventq *q, int64_t min_timestamp)
 {
-	sys_snode_t *i;
+	/* Events are enqueued in timestamp order. */
+	size_t lo = 0;
+	size_t hi = q->cnt;
 
-	SYS_SLIST_FOR_EACH_NODE(&q->root, i) {
-		struct hid_eventq_event *evt = CONTAINER_OF(i, struct hid_eventq_event, node);
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
 
-		if (evt->timestamp >= min_timestamp) {
-			return i;
+		if (event_at(q, mid)->timestamp < min_timestamp) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
 		}
 	}
 
-	return NULL;
+	return lo;
 }
 
-static sys_snode_t *get_keypress_release_node(struct hid_eventq *q, struct hid_eventq_event *evt,
-					      int *evt_pos, sys_snode_t *limit)
+static int get_keypress_release_pos(struct hid_eventq *q, size_t pos, size_t limit)
 {
-	__ASSERT_NO_MSG(evt->data.pressed);
-
-	size_t hit_count = 1;
-	size_t pos_shift = 0;
-	sys_snode_t *i = &evt->node;
+	const struct hid_eventq_event *evt = event_at(q, pos);
 
-	SYS_SLIST_ITERATE_FROM_NODE(&q->root, i) {
-		pos_shift++;
+	__ASSERT_NO_MSG(evt->pressed);
 
-		if (i == limit) {
-			break;
-		}
+	size_t hit_count = 1;
 
-		const struct hid_eventq_event *cur = CONTAINER_OF(i, struct hid_eventq_event, node);
+	for (size_t i = pos + 1; i < limit; i++) {
+		const struct hid_eventq_event *cur = event_at(q, i);
 
-		if (cur->data.key_id == evt->data.key_id) {
-			hit_count += cur->data.pressed ? (1) : (-1);
+		if (cur->key_id == evt->key_id) {
+			hit_count += cur->pressed ? (1) : (-1);
 
 			if (hit_count == 0) {
-				*evt_pos += pos_shift;
-
 				/* Found matching keypress releases. */
 				return i;
 			}
@@ -231,7 +199,7 @@ static sys_snode_t *get_keypress_release_node(struct hid_eventq *q, struct hid_e
 	}
 
 	/* Not found. */
-	return NULL;
+	return POS_NOT_FOUND;
 }
 
 void hid_eventq_cleanup(struct hid_eventq *q, int64_t min_timestamp)
@@ -240,52 +208,37 @@ void hid_eventq_cleanup(struct hid_eventq *q, int64_t min_timestamp)
 
 	LOG_DBG("q:%p, min_timestamp:%" PRId64, (void *)q, min_timestamp);
 
-	sys_snode_t *first_valid = get_first_valid_node(q, min_timestamp);
+	size_t first_valid = get_first_valid_pos(q, min_timestamp);
+	int max_pos = POS_NOT_FOUND;
+	size_t cur_pos = 0;
 
-	sys_snode_t *max_node = NULL;
-	int max_pos = -1;
+	/* Remove events but only if key release was generated for each removed key press.
+	 * Positions are relative to the oldest event that was not yet removed.
+	 */
+	while (cur_pos < first_valid) {
+		const struct hid_eventq_event *cur_evt = event_at(q, cur_pos);
 
-	sys_snode_t *cur_node;
-	int cur_pos = 0;
+		if (cur_evt->pressed) {
+			int release_pos = get_keypress_release_pos(q, cur_pos, first_valid);
 
-	sys_snode_t *tmp_safe;
-
-	/* Remove events but only if key release was generated for each removed key press. */
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&q->root, cur_node, tmp_safe) {
-		if (cur_node == first_valid) {
-			break;
-		}
-
-		struct hid_eventq_event *cur_evt =
-			CONTAINER_OF(cur_node, struct hid_eventq_event, node);
-
-		if (cur_evt->data.pressed) {
-			int release_pos = cur_pos;
-			sys_snode_t *release_node = get_keypress_release_node(q, cur_evt,
-									      &release_pos,
-									      first_valid);
-
-			if (release_node) {
-				if (release_pos > max_pos) {
-					max_node = release_node;
-					max_pos = release_pos;
-				}
-			} else {
-				/* Node not found. Abort cleanup. */
+			if (release_pos == POS_NOT_FOUND) {
+				/* Release not found. Abort cleanup. */
 				break;
 			}
+
+			max_pos = MAX(max_pos, release_pos);
 		} else {
-			if (cur_pos > max_pos) {
-				max_node = cur_node;
-				max_pos = cur_pos;
-			}
+			max_pos = MAX(max_pos, (int)cur_pos);
 		}
 
-		if (cur_node == max_node) {
+		if ((int)cur_pos == max_pos) {
 			/* All keypresses up to this point have pairs and can be deleted. */
-			hid_eventq_region_purge(q, max_node);
+			hid_eventq_region_purge(q, cur_pos + 1);
+			first_valid -= cur_pos + 1;
+			max_pos = POS_NOT_FOUND;
+			cur_pos = 0;
+		} else {
+			cur_pos++;
 		}
-
-		cur_pos++;
 	}
 }
@@ -22,13 +22,22 @@
 extern "C" {
 #endif
 
-#include <zephyr/sys/slist.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/**@brief Enqueued HID event. */
+struct hid_eventq_event {
+	int64_t timestamp; /**< Enqueue timestamp. */
+	uint16_t key_id; /**< Key ID. */
+	bool pressed; /**< Information if the key was pressed or released. */
+};
 
 /**@brief Event queue structure. */
 struct hid_eventq {
-	sys_slist_t root;
-	uint16_t cnt;
-	uint16_t cnt_max;
+	struct hid_eventq_event *events; /**< Ring buffer of events. */
+	uint16_t head; /**< Index of the oldest event. */
+	uint16_t cnt; /**< Current number of enqueued events. */
+	uint16_t cnt_max; /**< Maximum number of enqueued events. */
 };
 
 /**
@@ -36,10 +45,15 @@ struct hid_eventq {
  *
  * A HID event queue object instance must be initialized before used.
  *
+ * The enqueued HID events are stored in the ring buffer provided by the caller. The buffer must
+ * be able to hold the limit of enqueued HID events and it must remain valid for as long as the
+ * HID event queue object instance is used.
+ *
  * @param[in] q			HID event queue object.
+ * @param[in] events		Ring buffer used to store the enqueued HID events.
  * @param[in] max_queued	Limit of enqueued HID events for the queue.
  */
-void hid_eventq_init(struct hid_eventq *q, uint16_t max_queued);
+void hid_eventq_init(struct hid_eventq *q, struct hid_eventq_event *events, uint16_t max_queued);
 
 /**
  * @brief Check if a HID event queue is full
@@ -80,7 +94,6 @@ bool hid_eventq_is_empty(const struct hid_eventq *q);
  *
  * @retval 0 when successful.
  * @retval -ENOBUFS if reached limit of enqueued HID events.
- * @retval -ENOMEM if internal memory allocation failed.
  */
 int hid_eventq_keypress_enqueue(struct hid_eventq *q, uint16_t id, bool pressed, bool drop_oldest);
 
@@ -5,8 +5,8 @@
  */
 
 #include <stdint.h>
-#include <zephyr/sys/slist.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "hid_reportq.h"
 #include "hid_report_desc.h"
@@ -18,22 +18,19 @@ LOG_MODULE_REGISTER(hid_reportq, CONFIG_DESKTOP_HID_REPORTQ_LOG_LEVEL);
 #define MAX_ENQUEUED_REPORTS	CONFIG_DESKTOP_HID_REPORTQ_MAX_ENQUEUED_REPORTS
 #define REPORT_IDX_UNSUPPORTED	UINT8_MAX
 
-struct enqueued_report {
-	sys_snode_t node;
-	struct hid_report_event *event;
-};
-
-struct counted_list {
-	sys_slist_t list;
-	size_t node_count;
+struct report_ring {
+	struct hid_report_event *events[MAX_ENQUEUED_REPORTS];
+	uint8_t head;
+	uint8_t cnt;
 };
 
 struct hid_reportq {
-	struct counted_list report_lists[ARRAY_SIZE(input_reports)];
+	struct report_ring report_rings[ARRAY_SIZE(input_reports)];
 	uint16_t enabled_report_idx_bm;
 	uint8_t last_sent_report_idx;
 	uint8_t report_max;
 	uint8_t report_cnt;
+	uint32_t coalesced_cnt;
 	const void *sub_id;
 };
 
@@ -42,78 +39,91 @@ static struct hid_reportq queues[CONFIG_DESKTOP_HID_REPORTQ_QUEUE_COUNT];
 /* Ensure that enabled_report_idx_bm can handle all of the report indexes. */
 BUILD_ASSERT(ARRAY_SIZE(input_reports) <= 16);
 
-static struct enqueued_report *get_enqueued_report(struct counted_list *cnt_list)
+static struct hid_report_event *get_enqueued_event(struct report_ring *ring)
 {
-	sys_snode_t *node = sys_slist_get(&cnt_list->list);
-
-	if (!node) {
+	if (ring->cnt == 0) {
 		return NULL;
 	}
 
-	__ASSERT_NO_MSG(cnt_list->node_count > 0);
-	cnt_list->node_count--;
+	struct hid_report_event *event = ring->events[ring->head];
+
+	ring->head = (ring->head + 1) % MAX_ENQUEUED_REPORTS;
+	ring->cnt--;
 
-	return CONTAINER_OF(node, struct enqueued_report, node);
+	return event;
 }
 
-static void enqueue_report(struct counted_list *cnt_list, struct enqueued_report *report)
+static void drop_enqueued_events(struct report_ring *ring)
 {
-	__ASSERT_NO_MSG(cnt_list->node_count < MAX_ENQUEUED_REPORTS);
-	cnt_list->node_count++;
+	struct hid_report_event *event = get_enqueued_event(ring);
+
+	while (event) {
+		app_event_manager_free(event);
+		event = get_enqueued_event(ring);
+	}
 
-	sys_slist_append(&cnt_list->list, &report->node);
+	__ASSERT_NO_MSG(ring->cnt == 0);
 }
 
-static struct hid_report_event *get_enqueued_event(struct counted_list *cnt_list)
+static void enqueue_event(struct report_ring *ring, struct hid_report_event *event)
 {
-	struct enqueued_report *report = get_enqueued_report(cnt_list);
+	if (ring->cnt == MAX_ENQUEUED_REPORTS) {
+		LOG_WRN("Enqueue dropped the oldest report");
 
-	if (!report) {
-		return NULL;
+		app_event_manager_free(get_enqueued_event(ring));
 	}
 
-	struct hid_report_event *event = report->event;
-
-	k_free(report);
+	__ASSERT_NO_MSG(ring->cnt < MAX_ENQUEUED_REPORTS);
 
-	return event;
+	ring->events[(ring->head + ring->cnt) % MAX_ENQUEUED_REPORTS] = event;
+	ring->cnt++;
 }
 
-static void drop_enqueued_events(struct counted_list *cnt_list)
+#if CONFIG_DESKTOP_HID_REPORTQ_MOUSE_COALESCE
+static int16_t mouse_xy_decode(uint16_t val)
 {
-	struct hid_report_event *event = get_enqueued_event(cnt_list);
-
-	while (event) {
-		app_event_manager_free(event);
-		event = get_enqueued_event(cnt_list);
-	}
-
-	__ASSERT_NO_MSG(cnt_list->node_count == 0);
+	/* Sign extend the 12-bit value. */
+	return (val & 0x800) ? ((int16_t)val - 0x1000) : (int16_t)val;
 }
 
-static void enqueue_event(struct counted_list *cnt_list, struct hid_report_event *event)
+static bool mouse_report_coalesce(struct report_ring *ring, const void *src_id,
+				  const uint8_t *data, size_t size)
 {
-	struct enqueued_report *report;
+	if ((ring->cnt == 0) || (size != REPORT_SIZE_MOUSE)) {
+		return false;
+	}
 
-	if (cnt_list->node_count < MAX_ENQUEUED_REPORTS) {
-		report = k_malloc(sizeof(*report));
-	} else {
-		LOG_WRN("Enqueue dropped the oldest report");
+	struct hid_report_event *last =
+		ring->events[(ring->head + ring->cnt - 1) % MAX_ENQUEUED_REPORTS];
+	/* Skip report ID. */
+	uint8_t *last_data = &last->dyndata.data[1];
 
-		report = get_enqueued_report(cnt_list);
-		__ASSERT_NO_MSG(report);
-		app_event_manager_free(report->event);
+	/* Button state changes must be reported separately. */
+	if ((last->source != src_id) || (last->dyndata.size != (size + 1)) ||
+	    (last_data[0] != data[0])) {
+		return false;
 	}
 
-	if (!report) {
-		LOG_ERR("Cannot allocate enqueued_report");
-		/* Should never happen. */
-		__ASSERT_NO_MSG(false);
-	} else {
-		report->event = event;
-		enqueue_report(cnt_list, report);
+	int16_t wheel = (int8_t)last_data[1] + (int8_t)data[1];
+	int16_t x = mouse_xy_decode(sys_get_le16(&last_data[2]) & 0x0FFF) +
+		    mouse_xy_decode(sys_get_le16(&data[2]) & 0x0FFF);
+	int16_t y = mouse_xy_decode(sys_get_le16(&last_data[3]) >> 4) +
+		    mouse_xy_decode(sys_get_le16(&data[3]) >> 4);
+
+	if ((wheel < MOUSE_REPORT_WHEEL_MIN) || (wheel > MOUSE_REPORT_WHEEL_MAX) ||
+	    (x < MOUSE_REPORT_XY_MIN) || (x > MOUSE_REPORT_XY_MAX) ||
+	    (y < MOUSE_REPORT_XY_MIN) || (y > MOUSE_REPORT_XY_MAX)) {
+		return false;
 	}
+
+	last_data[1] = wheel;
+	last_data[2] = x;
+	last_data[3] = ((y & 0x0F) << 4) | ((x >> 8) & 0x0F);
+	last_data[4] = y >> 4;
+
+	return true;
 }
+#endif /* CONFIG_DESKTOP_HID_REPORTQ_MOUSE_COALESCE */
 
 static struct hid_reportq *reportq_find_free(void)
 {
@@ -139,9 +149,9 @@ struct hid_reportq *hid_reportq_alloc(const void *sub_id, uint8_t report_max)
 		return NULL;
 	}
 
-	for (size_t i = 0; i < ARRAY_SIZE(q->report_lists); i++) {
-		__ASSERT_NO_MSG(q->report_lists[i].node_count == 0);
-		sys_slist_init(&q->report_lists[i].list);
+	for (size_t i = 0; i < ARRAY_SIZE(q->report_rings); i++) {
+		__ASSERT_NO_MSG(q->report_rings[i].cnt == 0);
+		q->report_rings[i].head = 0;
 	}
 
 	__ASSERT_NO_MSG(q->enabled_report_idx_bm == 0);
@@ -160,14 +170,15 @@ void hid_reportq_free(struct hid_reportq *q)
 	/* Make sure that queue was allocated. */
 	__ASSERT_NO_MSG(q->sub_id);
 
-	for (size_t i = 0; i < ARRAY_SIZE(q->report_lists); i++) {
-		drop_enqueued_events(&q->report_lists[i]);
+	for (size_t i = 0; i < ARRAY_SIZE(q->report_rings); i++) {
+		drop_enqueued_events(&q->report_rings[i]);
 	}
 
 	q->enabled_report_idx_bm = 0;
 	q->last_sent_report_idx = 0;
 	q->report_max = 0;
 	q->report_cnt = 0;
+	q->coalesced_cnt = 0;
 	q->sub_id = NULL;
 }
 
@@ -179,6 +190,14 @@ const void *hid_reportq_get_sub_id(struct hid_reportq *q)
 	return q->sub_id;
 }
 
+uint32_t hid_reportq_get_coalesced_cnt(struct hid_reportq *q)
+{
+	/* Make sure that queue was allocated. */
+	__ASSERT_NO_MSG(q->sub_id);
+
+	return q->coalesced_cnt;
+}
+
 static uint8_t get_input_report_idx(uint8_t rep_id)
 {
 	BUILD_ASSERT(ARRAY_SIZE(input_reports) <= REPORT_IDX_UNSUPPORTED);
@@ -210,6 +229,14 @@ int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t re
 		return -EACCES;
 	}
 
+#if CONFIG_DESKTOP_HID_REPORTQ_MOUSE_COALESCE
+	if ((rep_id == REPORT_ID_MOUSE) && (q->report_cnt >= q->report_max) &&
+	    mouse_report_coalesce(&q->report_rings[rep_idx], src_id, data, size)) {
+		q->coalesced_cnt++;
+		return 0;
+	}
+#endif /* CONFIG_DESKTOP_HID_REPORTQ_MOUSE_COALESCE */
+
 	struct hid_report_event *event = new_hid_report_event(sizeof(rep_id) + size);
 
 	event->source = src_id;
@@ -224,7 +251,7 @@ int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t re
 		q->last_sent_report_idx = rep_idx;
 		q->report_cnt++;
 	} else {
-		enqueue_event(&q->report_lists[rep_idx], event);
+		enqueue_event(&q->report_rings[rep_idx], event);
 	}
 
 	return 0;
@@ -236,16 +263,16 @@ static struct hid_report_event *get_next_enqueued_event(struct hid_reportq *q)
 	struct hid_report_event *event;
 
 	do {
-		rep_idx = (rep_idx + 1) % ARRAY_SIZE(q->report_lists);
+		rep_idx = (rep_idx + 1) % ARRAY_SIZE(q->report_rings);
 
-		event = get_enqueued_event(&q->report_lists[rep_idx]);
+		event = get_enqueued_event(&q->report_rings[rep_idx]);
 		if (event) {
 			q->last_sent_report_idx = rep_idx;
 			return event;
 		}
 	} while (rep_idx != q->last_sent_report_idx);
 
-	return get_enqueued_event(&q->report_lists[rep_idx]);
+	return get_enqueued_event(&q->report_rings[rep_idx]);
 }
 
 void hid_reportq_report_sent(struct hid_reportq *q, uint8_t rep_id, bool err)
@@ -292,7 +319,7 @@ int hid_reportq_subscribe(struct hid_reportq *q, uint8_t rep_id)
 	}
 
 	WRITE_BIT(q->enabled_report_idx_bm, rep_idx, 1);
-	__ASSERT_NO_MSG(q->report_lists[rep_idx].node_count == 0);
+	__ASSERT_NO_MSG(q->report_rings[rep_idx].cnt == 0);
 
 	return 0;
 }
@@ -309,7 +336,7 @@ int hid_reportq_unsubscribe(struct hid_reportq *q, uint8_t rep_id)
 	}
 
 	WRITE_BIT(q->enabled_report_idx_bm, rep_idx, 0);
-	drop_enqueued_events(&q->report_lists[rep_idx]);
+	drop_enqueued_events(&q->report_rings[rep_idx]);
 
 	return 0;
 }
@@ -75,6 +75,17 @@ const void *hid_reportq_get_sub_id(struct hid_reportq *q);
 int hid_reportq_report_add(struct hid_reportq *q, const void *src_id, uint8_t rep_id,
 			   const uint8_t *data, size_t size);
 
+/**
+ * @brief Get number of HID reports that were coalesced into enqueued HID reports.
+ *
+ * See @kconfig{CONFIG_DESKTOP_HID_REPORTQ_MOUSE_COALESCE} for details.
+ *
+ * @param[in] q		Pointer to the queue instance.
+ *
+ * @return Number of coalesced HID reports since the queue was allocated.
+ */
+uint32_t hid_reportq_get_coalesced_cnt(struct hid_reportq *q);
+
 /**
  * @brief Notify HID report queue that HID report was sent.
  *
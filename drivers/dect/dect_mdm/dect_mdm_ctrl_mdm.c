@@ -238,7 +238,7 @@ dect_mdm_ctrl_mdm_dlc_data_rx_ntf_cb(struct nrf_modem_dect_dlc_data_rx_ntf_cb_pa
 		DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR, (void *)&mdm_dlc_data_with_pkt_ptr_params,
 		sizeof(struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr));
 	if (ret) {
-		printk("%s: Failed to queue RX data for processing, err=%d\n", __func__, ret);
+		/* Drop is accounted in the RX statistics (dect_mdm_rx_stats_get()) */
 		net_pkt_unref(rcv_pkt); /* Clean up packet if queueing fails */
 		return;
 	}
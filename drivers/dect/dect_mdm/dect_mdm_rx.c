@@ -44,10 +44,53 @@ K_MSGQ_DEFINE(dect_mdm_rx_th_op_event_msgq, sizeof(struct dect_mdm_common_op_eve
 K_MEM_SLAB_DEFINE_STATIC(dect_rx_event_slab, DECT_RX_EVENT_POOL_BLOCK_SIZE,
 			 CONFIG_DECT_MDM_NRF_RX_EVENT_POOL_COUNT, 4);
 
+static struct {
+	atomic_t delivered;
+	atomic_t dropped_no_mem;
+	atomic_t dropped_queue_full;
+	atomic_t dropped_stack;
+	atomic_t queue_depth_max;
+	atomic_t batch_max;
+} rx_stats;
+
+/* Local link address, rebuilt only when the configured long RD ID changes.
+ * Accessed from the RX thread only.
+ */
+static struct net_linkaddr ll_dst_cache;
+static uint32_t ll_dst_cache_long_rd_id;
+/* Any long RD ID value, including the "not set" one, can be cached. */
+static bool ll_dst_cache_valid;
+
+static void dect_mdm_rx_stats_max_update(atomic_t *target, atomic_val_t value)
+{
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(target);
+		if (value <= old) {
+			return;
+		}
+	} while (!atomic_cas(target, old, value));
+}
+
+static const struct net_linkaddr *dect_mdm_rx_ll_dst_get(void)
+{
+	struct dect_mdm_settings *set_ptr = dect_mdm_settings_ref_get();
+	uint32_t long_rd_id = set_ptr->net_mgmt_common.identities.transmitter_long_rd_id;
+
+	if (!ll_dst_cache_valid || (long_rd_id != ll_dst_cache_long_rd_id)) {
+		dect_utils_lib_net_linkaddr_set_from_long_rd_id(&ll_dst_cache, long_rd_id);
+		ll_dst_cache_long_rd_id = long_rd_id;
+		ll_dst_cache_valid = true;
+	}
+
+	return &ll_dst_cache;
+}
+
 static bool dect_mdm_data_rx_with_pkt_ptr(struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr *params)
 {
 	struct net_linkaddr ll_src;
-	struct net_linkaddr ll_dst;
+	const struct net_linkaddr *ll_dst;
 	/* Pkt has been allocated and written, now set the addressing part */
 	struct net_pkt *rcv_pkt = params->pkt;
 
@@ -59,16 +102,14 @@ static bool dect_mdm_data_rx_with_pkt_ptr(struct dect_mdm_ctrl_dlc_rx_data_with_
 	/* Set ll source and destination addresses based on long RD IDs:
 	 * src as received and dst as configured in this device for long rd id
 	 */
-	struct dect_mdm_settings *set_ptr = dect_mdm_settings_ref_get();
-
 	dect_utils_lib_net_linkaddr_set_from_long_rd_id(&ll_src, params->mdm_params.long_rd_id);
-	dect_utils_lib_net_linkaddr_set_from_long_rd_id(
-		&ll_dst, set_ptr->net_mgmt_common.identities.transmitter_long_rd_id);
+	ll_dst = dect_mdm_rx_ll_dst_get();
 
-	ret = net_linkaddr_set(net_pkt_lladdr_dst(rcv_pkt), ll_dst.addr, ll_dst.len);
+	ret = net_linkaddr_set(net_pkt_lladdr_dst(rcv_pkt), ll_dst->addr, ll_dst->len);
 	if (ret < 0) {
 		LOG_ERR("%s: cannot set destination link address, ret %d", (__func__), ret);
 		net_pkt_unref(rcv_pkt);
+		atomic_inc(&rx_stats.dropped_stack);
 		return false;
 	}
 
@@ -76,17 +117,20 @@ static bool dect_mdm_data_rx_with_pkt_ptr(struct dect_mdm_ctrl_dlc_rx_data_with_
 	if (ret < 0) {
 		LOG_ERR("%s: cannot set source link address, ret %d", (__func__), ret);
 		net_pkt_unref(rcv_pkt);
+		atomic_inc(&rx_stats.dropped_stack);
 		return false;
 	}
 
 	ret = net_recv_data(params->iface, rcv_pkt);
 	if (ret < 0) {
-		LOG_ERR("%s: received packet dropped from %u (%d bytes), ret %d", (__func__),
+		LOG_DBG("%s: received packet dropped from %u (%d bytes), ret %d", (__func__),
 			params->mdm_params.long_rd_id, params->data_len, ret);
 		net_pkt_unref(rcv_pkt);
+		atomic_inc(&rx_stats.dropped_stack);
 	} else {
 		LOG_DBG("%s: received packet from %u (%d bytes)", (__func__),
 			params->mdm_params.long_rd_id, params->data_len);
+		atomic_inc(&rx_stats.delivered);
 		handled = true;
 	}
 	return handled;
@@ -103,7 +147,8 @@ static void *dect_mdm_rx_event_alloc(size_t size)
 		return NULL;
 	}
 	if (k_mem_slab_alloc(&dect_rx_event_slab, &ptr, K_NO_WAIT) != 0) {
-		printk("Failed to allocate memory from RX event pool\n");
+		/* Counted in the RX statistics, printing here would only slow down draining */
+		atomic_inc(&rx_stats.dropped_no_mem);
 		return NULL;
 	}
 	return ptr;
@@ -121,15 +166,35 @@ static void dect_mdm_rx_event_free(void *ptr)
 static void dect_mdm_rx_th_op_handler_thread_fn(void)
 {
 	struct dect_mdm_common_op_event_msgq_item event;
+	static struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr batch[CONFIG_DECT_MDM_NRF_RX_BATCH_SIZE];
+	k_timeout_t timeout;
+	int count;
 
 	while (true) {
-		k_msgq_get(&dect_mdm_rx_th_op_event_msgq, &event, K_FOREVER);
+		count = 0;
+		timeout = K_FOREVER;
+
+		/* Drain pending frames and release their pool blocks before the
+		 * potentially slow IP stack processing, so that the modem callback
+		 * can keep queueing frames in the meantime.
+		 */
+		while (count < CONFIG_DECT_MDM_NRF_RX_BATCH_SIZE &&
+		       k_msgq_get(&dect_mdm_rx_th_op_event_msgq, &event, timeout) == 0) {
+			timeout = K_NO_WAIT;
+
+			if (event.id == DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR) {
+				memcpy(&batch[count++], event.data, sizeof(batch[0]));
+			} else {
+				LOG_ERR("DECT RX: Unknown event %d received", event.id);
+			}
+			/* Free memory back to pool */
+			dect_mdm_rx_event_free(event.data);
+		}
+
+		dect_mdm_rx_stats_max_update(&rx_stats.batch_max, count);
 
-		switch (event.id) {
-		case DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR: {
-			struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr *params =
-				(struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr *)event.data;
-			bool data_handled = false;
+		for (int i = 0; i < count; i++) {
+			struct dect_mdm_ctrl_dlc_rx_data_with_pkt_ptr *params = &batch[i];
 
 			LOG_DBG("DLC data received to iface %p, transmitter: %u (0x%X), "
 				"flow ID: %hhu, data_len: %u",
@@ -137,20 +202,12 @@ static void dect_mdm_rx_th_op_handler_thread_fn(void)
 				params->mdm_params.long_rd_id, params->mdm_params.flow_id,
 				params->data_len);
 
-			data_handled = dect_mdm_data_rx_with_pkt_ptr(params);
-			if (!data_handled) {
-				LOG_ERR("DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR: Cannot pass DLC RX "
+			if (!dect_mdm_data_rx_with_pkt_ptr(params)) {
+				LOG_DBG("DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR: Cannot pass DLC RX "
 					"data upwards in stack (len %d)",
 					params->data_len);
 			}
-			break;
 		}
-		default:
-			LOG_ERR("DECT RX: Unknown event %d received", event.id);
-			break;
-		}
-		/* Free memory back to pool */
-		dect_mdm_rx_event_free(event.data);
 	}
 }
 
@@ -181,14 +238,32 @@ int dect_mdm_rx_msgq_data_op_add(uint16_t event_id, void *data, size_t data_size
 	/* Try to put in message queue */
 	ret = k_msgq_put(&dect_mdm_rx_th_op_event_msgq, &event, K_NO_WAIT);
 	if (ret) {
-		if (ret == -ENOMSG) {
-			printk("RX message queue full, dropping event %u\n", event_id);
-		} else {
-			printk("Failed to put event %d to RX message queue, err: %d\n",
-				event_id, ret);
-		}
+		atomic_inc(&rx_stats.dropped_queue_full);
 		dect_mdm_rx_event_free(event.data);
 		return -ENOBUFS;
 	}
+
+	dect_mdm_rx_stats_max_update(&rx_stats.queue_depth_max,
+				     k_msgq_num_used_get(&dect_mdm_rx_th_op_event_msgq));
 	return 0;
 }
+
+void dect_mdm_rx_stats_get(struct dect_mdm_rx_stats *stats)
+{
+	stats->delivered = atomic_get(&rx_stats.delivered);
+	stats->dropped_no_mem = atomic_get(&rx_stats.dropped_no_mem);
+	stats->dropped_queue_full = atomic_get(&rx_stats.dropped_queue_full);
+	stats->dropped_stack = atomic_get(&rx_stats.dropped_stack);
+	stats->queue_depth_max = atomic_get(&rx_stats.queue_depth_max);
+	stats->batch_max = atomic_get(&rx_stats.batch_max);
+}
+
+void dect_mdm_rx_stats_reset(void)
+{
+	atomic_clear(&rx_stats.delivered);
+	atomic_clear(&rx_stats.dropped_no_mem);
+	atomic_clear(&rx_stats.dropped_queue_full);
+	atomic_clear(&rx_stats.dropped_stack);
+	atomic_clear(&rx_stats.queue_depth_max);
+	atomic_clear(&rx_stats.batch_max);
+}
@@ -11,6 +11,22 @@
 
 #define DECT_MDM_RX_OP_RX_DATA_WITH_PKT_PTR 1
 
+/** RX path statistics. */
+struct dect_mdm_rx_stats {
+	/** Frames passed to the IP stack. */
+	uint32_t delivered;
+	/** Frames dropped because the RX event pool was exhausted. */
+	uint32_t dropped_no_mem;
+	/** Frames dropped because the RX message queue was full. */
+	uint32_t dropped_queue_full;
+	/** Frames dropped by the IP stack or when setting link addresses. */
+	uint32_t dropped_stack;
+	/** Highest observed number of frames pending in the RX message queue. */
+	uint32_t queue_depth_max;
+	/** Highest number of frames handled in one RX thread wakeup. */
+	uint32_t batch_max;
+};
+
 /**
  * @brief Add RX operation to message queue for processing.
  * @param event_id Event type identifier (DECT_MDM_RX_OP_*).
@@ -21,4 +37,15 @@
  */
 int dect_mdm_rx_msgq_data_op_add(uint16_t event_id, void *data, size_t data_size);
 
+/**
+ * @brief Get RX path statistics.
+ * @param stats Pointer to the structure where the statistics are copied.
+ */
+void dect_mdm_rx_stats_get(struct dect_mdm_rx_stats *stats);
+
+/**
+ * @brief Reset RX path statistics.
+ */
+void dect_mdm_rx_stats_reset(void);
+
 #endif /* DECT_MDM_RX_H */
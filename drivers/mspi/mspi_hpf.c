@@ -88,6 +88,16 @@ static volatile uint32_t *cpuflpr_error_ctx_ptr =
 static K_SEM_DEFINE(ipc_sem, 0, 1);
 static K_SEM_DEFINE(ipc_sem_cfg, 0, 1);
 static K_SEM_DEFINE(ipc_sem_xfer, 0, 1);
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+static K_SEM_DEFINE(xfer_lock_sem, 1, 1);
+static K_SEM_DEFINE(xfer_done_sem, 0, 1);
+static K_SEM_DEFINE(pipeline_resp_sem, 0, K_SEM_MAX_LIMIT);
+static K_MUTEX_DEFINE(pipeline_mutex);
+static void pipeline_timeout_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(pipeline_timeout_work, pipeline_timeout_handler);
+/* Number of pipelined packets sent to FLPR that were not responded to yet. */
+static atomic_t pipeline_inflight = ATOMIC_INIT(0);
+#endif
 #else
 static atomic_t ipc_atomic_sem = ATOMIC_INIT(0);
 #endif
@@ -104,8 +114,33 @@ static atomic_t ipc_atomic_sem = ATOMIC_INIT(0);
 		.sw_multi_periph = false,                                                          \
 	}
 
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+struct mspi_hpf_xfer_ctx {
+	const struct device *dev;
+	const struct mspi_dev_id *dev_id;
+	/* Packets are owned by the caller until the transfer is completed. */
+	struct mspi_xfer xfer;
+	uint32_t packets_sent;
+	uint32_t packets_done;
+	int status;
+	bool active;
+};
+#endif
+
 struct mspi_hpf_data {
 	hpf_mspi_xfer_config_msg_t xfer_config_msg;
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+	struct mspi_hpf_xfer_ctx xfer_ctx;
+	/* Messages are passed to FLPR by reference and must be valid until responded to. */
+	hpf_mspi_xfer_packet_msg_t msgs[CONFIG_MSPI_HPF_MAX_PENDING_PACKETS];
+	/* Number of pipelined messages sent and handled, used to index the message slots. */
+	uint32_t msgs_sent;
+	uint32_t msgs_done;
+	/* Number of responses left to packets of an aborted transfer. */
+	uint32_t msgs_stale;
+	mspi_callback_handler_t cbs[MSPI_BUS_EVENT_MAX];
+	struct mspi_callback_context *cb_ctxs[MSPI_BUS_EVENT_MAX];
+#endif
 };
 
 struct mspi_hpf_config {
@@ -212,6 +247,14 @@ static void ep_recv(const void *data, size_t len, void *priv)
 		break;
 	}
 	case HPF_MSPI_TX: {
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+		/* Responses arrive in order, so pipelined packets are responded to first. */
+		if (atomic_get(&pipeline_inflight) > 0) {
+			atomic_dec(&pipeline_inflight);
+			k_sem_give(&pipeline_resp_sem);
+			break;
+		}
+#endif
 #if defined(CONFIG_MULTITHREADING)
 		k_sem_give(&ipc_sem_xfer);
 #else
@@ -220,6 +263,14 @@ static void ep_recv(const void *data, size_t len, void *priv)
 		break;
 	}
 	case HPF_MSPI_TXRX: {
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+		/* Responses arrive in order, so pipelined packets are responded to first. */
+		if (atomic_get(&pipeline_inflight) > 0) {
+			atomic_dec(&pipeline_inflight);
+			k_sem_give(&pipeline_resp_sem);
+			break;
+		}
+#endif
 		if (len > 0) {
 			ipc_received = len - sizeof(hpf_mspi_opcode_t);
 			ipc_receive_buffer = (uint8_t *)&response->data;
@@ -379,18 +430,15 @@ static int hpf_mspi_register_endpoint_with_retry(const struct device *ipc_instan
 }
 
 /**
- * @brief Send data to the FLPR core using the IPC service, and wait for FLPR response.
+ * @brief Send data to the FLPR core using the IPC service.
  *
- * @param opcode The configuration packet opcode to send.
  * @param data The data to send.
  * @param len The length of the data to send.
  *
  * @return 0 on success, negative errno code on failure.
  */
-static int send_data(hpf_mspi_opcode_t opcode, const void *data, size_t len)
+static int send_msg(const void *data, size_t len)
 {
-	LOG_DBG("Sending msg with opcode: %d", (uint8_t)opcode);
-
 	int rc;
 #ifdef CONFIG_MSPI_HPF_IPC_NO_COPY
 	(void)len;
@@ -402,9 +450,6 @@ static int send_data(hpf_mspi_opcode_t opcode, const void *data, size_t len)
 #else
 	uint32_t repeat = EP_SEND_TIMEOUT_MS;
 #endif
-#if !defined(CONFIG_MULTITHREADING)
-	atomic_clear_bit(&ipc_atomic_sem, opcode);
-#endif
 
 	do {
 #ifdef CONFIG_MSPI_HPF_IPC_NO_COPY
@@ -427,6 +472,33 @@ static int send_data(hpf_mspi_opcode_t opcode, const void *data, size_t len)
 		return rc;
 	}
 
+	return 0;
+}
+
+/**
+ * @brief Send data to the FLPR core using the IPC service, and wait for FLPR response.
+ *
+ * @param opcode The configuration packet opcode to send.
+ * @param data The data to send.
+ * @param len The length of the data to send.
+ *
+ * @return 0 on success, negative errno code on failure.
+ */
+static int send_data(hpf_mspi_opcode_t opcode, const void *data, size_t len)
+{
+	LOG_DBG("Sending msg with opcode: %d", (uint8_t)opcode);
+
+	int rc;
+
+#if !defined(CONFIG_MULTITHREADING)
+	atomic_clear_bit(&ipc_atomic_sem, opcode);
+#endif
+
+	rc = send_msg(data, len);
+	if (rc < 0) {
+		return rc;
+	}
+
 	rc = hpf_mspi_wait_for_response(opcode, IPC_TIMEOUT_MS);
 	if (rc < 0) {
 		LOG_ERR("Data transfer: %d response timeout: %d!", opcode, rc);
@@ -932,12 +1004,330 @@ static int start_next_packet(struct mspi_xfer *xfer, uint32_t packets_done)
 	return send_packet(packet, xfer->timeout);
 }
 
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+static void notify_event(struct mspi_hpf_xfer_ctx *ctx, enum mspi_bus_event evt_type,
+			 uint32_t packet_idx, int status)
+{
+	mspi_callback_handler_t cb = dev_data.cbs[evt_type];
+	struct mspi_callback_context *cb_ctx = dev_data.cb_ctxs[evt_type];
+
+	if (!cb || !cb_ctx) {
+		return;
+	}
+
+	cb_ctx->mspi_evt.evt_type = evt_type;
+	cb_ctx->mspi_evt.evt_data.controller = ctx->dev;
+	cb_ctx->mspi_evt.evt_data.dev_id = ctx->dev_id;
+	cb_ctx->mspi_evt.evt_data.packet = &ctx->xfer.packets[packet_idx];
+	cb_ctx->mspi_evt.evt_data.packet_idx = packet_idx;
+	cb_ctx->mspi_evt.evt_data.status = status;
+
+	cb(cb_ctx);
+}
+
+/**
+ * @brief Queue packets to FLPR until the transfer is fully sent or the queue is full.
+ *
+ * Must be called with pipeline_mutex held.
+ *
+ * @param ctx Transfer context.
+ */
+static void pipeline_fill(struct mspi_hpf_xfer_ctx *ctx)
+{
+	while ((ctx->status == 0) && (ctx->packets_sent < ctx->xfer.num_packet) &&
+	       (dev_data.msgs_sent - dev_data.msgs_done < CONFIG_MSPI_HPF_MAX_PENDING_PACKETS)) {
+		const struct mspi_xfer_packet *packet = &ctx->xfer.packets[ctx->packets_sent];
+		hpf_mspi_xfer_packet_msg_t *msg =
+			&dev_data.msgs[dev_data.msgs_sent % CONFIG_MSPI_HPF_MAX_PENDING_PACKETS];
+		int rc;
+
+		msg->opcode = (packet->dir == MSPI_RX) ? HPF_MSPI_TXRX : HPF_MSPI_TX;
+		msg->command = packet->cmd;
+		msg->address = packet->address;
+		msg->num_bytes = packet->num_bytes;
+		msg->data = packet->data_buf;
+
+		/* The response may be received before the send function returns. */
+		atomic_inc(&pipeline_inflight);
+
+		rc = send_msg(msg, sizeof(hpf_mspi_xfer_packet_msg_t));
+		if (rc < 0) {
+			atomic_dec(&pipeline_inflight);
+			ctx->status = rc;
+			break;
+		}
+
+		dev_data.msgs_sent++;
+		ctx->packets_sent++;
+	}
+}
+
+/**
+ * @brief Complete the transfer and release the bus.
+ *
+ * @param ctx Transfer context.
+ */
+static void pipeline_finish(struct mspi_hpf_xfer_ctx *ctx)
+{
+	struct k_work_sync timeout_sync;
+
+	if (ctx->xfer.async) {
+		/* The timeout handler may already be running. It finds the transfer
+		 * completed, but must not run once the next transfer is started.
+		 */
+		(void)k_work_cancel_delayable_sync(&pipeline_timeout_work, &timeout_sync);
+
+		if (ctx->status < 0) {
+			notify_event(ctx, MSPI_BUS_ERROR, ctx->packets_done, ctx->status);
+		}
+	} else {
+		k_sem_give(&xfer_done_sem);
+	}
+
+	k_sem_give(&xfer_lock_sem);
+}
+
+/**
+ * @brief Handle FLPR response to the oldest queued packet.
+ *
+ * Responses arrive in the order in which packets were queued.
+ */
+static void pipeline_packet_done(void)
+{
+	struct mspi_hpf_xfer_ctx *ctx = &dev_data.xfer_ctx;
+	uint32_t packet_idx = 0;
+	bool completed = false;
+	bool done = false;
+
+	k_mutex_lock(&pipeline_mutex, K_FOREVER);
+
+	dev_data.msgs_done++;
+
+	if (dev_data.msgs_stale > 0) {
+		/* Response to a packet of an aborted transfer. */
+		dev_data.msgs_stale--;
+	} else if (ctx->active) {
+		packet_idx = ctx->packets_done++;
+		completed = true;
+	} else {
+		LOG_WRN("Unexpected packet response");
+	}
+
+	if (ctx->active) {
+		pipeline_fill(ctx);
+
+		done = (ctx->packets_done == ctx->packets_sent) &&
+		       ((ctx->packets_sent == ctx->xfer.num_packet) || (ctx->status < 0));
+		if (done) {
+			ctx->active = false;
+		}
+	}
+
+	k_mutex_unlock(&pipeline_mutex);
+
+	if (completed && ctx->xfer.async &&
+	    (ctx->xfer.packets[packet_idx].cb_mask & MSPI_BUS_XFER_COMPLETE_CB)) {
+		notify_event(ctx, MSPI_BUS_XFER_COMPLETE, packet_idx, 0);
+	}
+
+	if (done) {
+		pipeline_finish(ctx);
+	}
+}
+
+/**
+ * @brief Thread handling FLPR responses to pipelined packets.
+ *
+ * Responses are handled outside of the IPC receive callback, because queuing
+ * the next packets may block.
+ */
+static void pipeline_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		k_sem_take(&pipeline_resp_sem, K_FOREVER);
+		pipeline_packet_done();
+	}
+}
+
+K_THREAD_DEFINE(mspi_hpf_pipeline, CONFIG_MSPI_HPF_ASYNC_THREAD_STACK_SIZE, pipeline_thread,
+		NULL, NULL, NULL, K_PRIO_PREEMPT(CONFIG_MSPI_HPF_ASYNC_THREAD_PRIO), 0, 0);
+
+/**
+ * @brief Stop a pipelined transfer that did not complete in time.
+ *
+ * No more packets are queued and responses to the packets that are already
+ * queued are dropped, so the caller's transfer is not accessed afterwards.
+ *
+ * @param ctx Transfer context.
+ *
+ * @retval true If the transfer was stopped.
+ * @retval false If the transfer completed in the meantime.
+ */
+static bool pipeline_cancel(struct mspi_hpf_xfer_ctx *ctx)
+{
+	bool aborted = false;
+
+	k_mutex_lock(&pipeline_mutex, K_FOREVER);
+
+	if (ctx->active) {
+		dev_data.msgs_stale += ctx->packets_sent - ctx->packets_done;
+		ctx->active = false;
+		ctx->status = -ETIMEDOUT;
+		aborted = true;
+	}
+
+	k_mutex_unlock(&pipeline_mutex);
+
+	if (aborted) {
+		LOG_ERR("Transfer timeout, %u packets aborted",
+			ctx->xfer.num_packet - ctx->packets_done);
+	}
+
+	return aborted;
+}
+
+/**
+ * @brief Abort a synchronous pipelined transfer that did not complete in time.
+ *
+ * @param ctx Transfer context.
+ *
+ * @retval -ETIMEDOUT If the transfer was aborted.
+ * @retval status Transfer status, if the transfer completed in the meantime.
+ */
+static int pipeline_abort(struct mspi_hpf_xfer_ctx *ctx)
+{
+	if (!pipeline_cancel(ctx)) {
+		/* The last response is being handled, wait until the bus is released. */
+		(void)k_sem_take(&xfer_done_sem, K_FOREVER);
+		return ctx->status;
+	}
+
+	k_sem_give(&xfer_lock_sem);
+
+	return -ETIMEDOUT;
+}
+
+/**
+ * @brief Abort an asynchronous pipelined transfer that did not complete in time.
+ *
+ * The timeout is reported through the bus error callback.
+ *
+ * @param work Timeout work item.
+ */
+static void pipeline_timeout_handler(struct k_work *work)
+{
+	struct mspi_hpf_xfer_ctx *ctx = &dev_data.xfer_ctx;
+
+	ARG_UNUSED(work);
+
+	if (!pipeline_cancel(ctx)) {
+		return;
+	}
+
+	notify_event(ctx, MSPI_BUS_ERROR, ctx->packets_done, -ETIMEDOUT);
+	k_sem_give(&xfer_lock_sem);
+}
+
+/**
+ * @brief Start a pipelined transfer.
+ *
+ * The bus lock is released when the last packet is completed.
+ *
+ * @param dev Pointer to the device structure.
+ * @param dev_id Pointer to the device identification structure.
+ * @param req Pointer to the xfer structure.
+ *
+ * @retval 0 If the transfer was started.
+ * @retval -errno If no packet could be queued.
+ */
+static int pipeline_start(const struct device *dev, const struct mspi_dev_id *dev_id,
+			  const struct mspi_xfer *req)
+{
+	struct mspi_hpf_xfer_ctx *ctx = &dev_data.xfer_ctx;
+	int rc = 0;
+
+	k_mutex_lock(&pipeline_mutex, K_FOREVER);
+
+	ctx->dev = dev;
+	ctx->dev_id = dev_id;
+	ctx->xfer = *req;
+	ctx->packets_sent = 0;
+	ctx->packets_done = 0;
+	ctx->status = 0;
+	ctx->active = true;
+
+	pipeline_fill(ctx);
+
+	if (ctx->packets_sent == 0) {
+		/* Nothing is in flight, so no response will complete the transfer. All
+		 * message slots may still be used by packets of an aborted transfer.
+		 */
+		ctx->active = false;
+		rc = (ctx->status < 0) ? ctx->status : -EBUSY;
+	} else if (ctx->xfer.async) {
+		/* Armed before any response is handled, so it is cancelled on completion. */
+		(void)k_work_schedule(&pipeline_timeout_work, K_MSEC(req->timeout));
+	}
+
+	k_mutex_unlock(&pipeline_mutex);
+
+	return rc;
+}
+
+static bool packets_aligned(const struct mspi_xfer *req)
+{
+	for (uint32_t i = 0; i < req->num_packet; i++) {
+		if (!IS_ALIGNED(req->packets[i].data_buf, sizeof(uint32_t))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Register a callback for MSPI bus events.
+ *
+ * @param dev Pointer to the device structure.
+ * @param dev_id Pointer to the device identification structure.
+ * @param evt_type Bus event type.
+ * @param cb Callback handler.
+ * @param ctx Callback context passed to the handler.
+ *
+ * @retval 0 If successful.
+ * @retval -ENOTSUP If the event type is not supported.
+ */
+static int api_register_callback(const struct device *dev, const struct mspi_dev_id *dev_id,
+				 const enum mspi_bus_event evt_type, mspi_callback_handler_t cb,
+				 struct mspi_callback_context *ctx)
+{
+	struct mspi_hpf_data *drv_data = dev->data;
+
+	ARG_UNUSED(dev_id);
+
+	if ((evt_type != MSPI_BUS_XFER_COMPLETE) && (evt_type != MSPI_BUS_ERROR)) {
+		LOG_ERR("Callback type %d not supported.", evt_type);
+		return -ENOTSUP;
+	}
+
+	drv_data->cbs[evt_type] = cb;
+	drv_data->cb_ctxs[evt_type] = ctx;
+
+	return 0;
+}
+#endif /* CONFIG_MSPI_HPF_ASYNC */
+
 /**
  * @brief Send a multi-packet transfer request to the host.
  *
- * This function sends a multi-packet transfer request to the host and waits
- * for the host to complete the transfer. This function does not support
- * asynchronous transfers.
+ * This function sends a multi-packet transfer request to the host. Synchronous
+ * transfers wait for the host to complete the transfer. Asynchronous transfers
+ * (CONFIG_MSPI_HPF_ASYNC) return once the first packets are queued and report
+ * completion through the registered callbacks.
  *
  * @param dev Pointer to the device structure.
  * @param dev_id Pointer to the device identification structure.
@@ -945,6 +1335,7 @@ static int start_next_packet(struct mspi_xfer *xfer, uint32_t packets_done)
  *
  * @retval 0 If successful.
  * @retval -ENOTSUP If the requested transfer configuration is not supported.
+ * @retval -EBUSY If the previous asynchronous transfer is still in progress.
  * @retval -EIO General input / output error, failed to send over the bus.
  */
 static int api_transceive(const struct device *dev, const struct mspi_dev_id *dev_id,
@@ -954,8 +1345,7 @@ static int api_transceive(const struct device *dev, const struct mspi_dev_id *de
 	uint32_t packets_done = 0;
 	int rc;
 
-	/* TODO: add support for asynchronous transfers */
-	if ((req->async) || (req->xfer_mode != MSPI_PIO) ||
+	if ((!IS_ENABLED(CONFIG_MSPI_HPF_ASYNC) && req->async) || (req->xfer_mode != MSPI_PIO) ||
 	    (req->tx_dummy > MAX_MSPI_DUMMY_CLOCKS) || (req->rx_dummy > MAX_MSPI_DUMMY_CLOCKS)) {
 		return -ENOTSUP;
 	}
@@ -965,6 +1355,32 @@ static int api_transceive(const struct device *dev, const struct mspi_dev_id *de
 		return -EFAULT;
 	}
 
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+	bool pipelined = packets_aligned(req);
+
+	if (req->async && !pipelined) {
+		LOG_ERR("Asynchronous transfers require word-aligned buffers.");
+		return -EINVAL;
+	}
+
+	if (pipelined) {
+		for (uint32_t i = 0; i < req->num_packet; i++) {
+			if (req->packets[i].num_bytes >= MAX_TX_MSG_SIZE) {
+				LOG_ERR("Packet size to large: %u. Increase SRAM data region.",
+					req->packets[i].num_bytes);
+				return -EINVAL;
+			}
+		}
+	}
+
+	/* Transfer configuration is passed by reference, so it must not be changed
+	 * while packets of the previous transfer are still queued.
+	 */
+	if (k_sem_take(&xfer_lock_sem, K_MSEC(CONFIG_MSPI_COMPLETION_TIMEOUT_TOLERANCE)) < 0) {
+		return -EBUSY;
+	}
+#endif
+
 	drv_data->xfer_config_msg.opcode = HPF_MSPI_CONFIG_XFER;
 	drv_data->xfer_config_msg.xfer_config.device_index = dev_id->dev_idx;
 	drv_data->xfer_config_msg.xfer_config.command_length = req->cmd_length;
@@ -978,19 +1394,53 @@ static int api_transceive(const struct device *dev, const struct mspi_dev_id *de
 
 	if (rc < 0) {
 		LOG_ERR("Send xfer config error: %d", rc);
-		return rc;
+		goto out;
 	}
 
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+	if (pipelined) {
+		k_sem_reset(&xfer_done_sem);
+
+		rc = pipeline_start(dev, dev_id, req);
+		if (rc < 0) {
+			LOG_ERR("Start next packet error: %d", rc);
+			goto out;
+		}
+
+		if (req->async) {
+			/* Bus lock is released on completion of the last packet or on timeout. */
+			return 0;
+		}
+
+		if (k_sem_take(&xfer_done_sem, K_MSEC(req->timeout)) < 0) {
+			return pipeline_abort(&drv_data->xfer_ctx);
+		}
+
+		return drv_data->xfer_ctx.status;
+	}
+
+	if (atomic_get(&pipeline_inflight) > 0) {
+		/* Response to the packet would be taken for a response to an aborted one. */
+		LOG_ERR("Packets of an aborted transfer are still queued");
+		rc = -EBUSY;
+		goto out;
+	}
+#endif
+
 	while (packets_done < req->num_packet) {
 		rc = start_next_packet((struct mspi_xfer *)req, packets_done);
 		if (rc < 0) {
 			LOG_ERR("Start next packet error: %d", rc);
-			return rc;
+			goto out;
 		}
 		++packets_done;
 	}
 
-	return 0;
+out:
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+	k_sem_give(&xfer_lock_sem);
+#endif
+	return rc;
 }
 
 #if CONFIG_PM_DEVICE
@@ -1143,6 +1593,9 @@ static DEVICE_API(mspi, drv_api) = {
 	.dev_config = api_dev_config,
 	.get_channel_status = api_get_channel_status,
 	.transceive = api_transceive,
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+	.register_callback = api_register_callback,
+#endif
 };
 
 PM_DEVICE_DT_INST_DEFINE(0, dev_pm_action_cb);
@@ -27,6 +27,18 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 			       unsigned char if_idx,
 			       int peer_id);
 
+/**
+ * @brief Get the TX statistics of a peer.
+ * @param fmac_ctx Pointer to the UMAC IF context for a RPU WLAN device.
+ * @param mac_addr MAC address of the peer.
+ * @param stats Pointer to the structure where the statistics are copied.
+ *
+ * @return Command execution status
+ */
+enum nrf_wifi_status nrf_wifi_fmac_peer_tx_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
+						     const unsigned char *mac_addr,
+						     struct nrf_wifi_fmac_peer_tx_stats *stats);
+
 void nrf_wifi_fmac_peers_flush(struct nrf_wifi_fmac_dev_ctx *fmac_ctx,
 			       unsigned char if_idx);
 
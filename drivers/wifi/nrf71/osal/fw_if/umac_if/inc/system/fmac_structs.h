@@ -23,6 +23,8 @@
 
 #define MAX_PEERS 5
 #define MAX_SW_PEERS (MAX_PEERS + 1)
+/** Number of buckets in the peer MAC address index, must be a power of two. */
+#define NRF_WIFI_PEER_HASH_SIZE 8
 #define NRF_WIFI_AC_TWT_PRIORITY_EMERGENCY 0xFF
 #define NRF_WIFI_MAGIC_NUM_RAWTX 0x12345678
 
@@ -303,6 +305,18 @@ enum nrf_wifi_fmac_twt_state {
 #endif /* NRF71_STA_MODE */
 
 #if defined(NRF71_STA_MODE) || defined(NRF71_RAW_DATA_RX) || defined(__DOXYGEN__)
+/**
+ * @brief Structure to hold per-peer TX statistics.
+ */
+struct nrf_wifi_fmac_peer_tx_stats {
+	/** Number of frames accepted for transmission to the peer. */
+	unsigned int tx_pkts;
+	/** Number of bytes accepted for transmission to the peer. */
+	unsigned int tx_bytes;
+	/** Number of frames dropped before being queued for the peer. */
+	unsigned int tx_dropped;
+};
+
 /**
  * @brief Structure to hold peer context information.
  *
@@ -330,6 +344,8 @@ struct peers_info {
 	int ps_token_count;
 	/** Port authorized */
 	bool authorized;
+	/** TX statistics. */
+	struct nrf_wifi_fmac_peer_tx_stats tx_stats;
 };
 
 /**
@@ -341,6 +357,10 @@ struct tx_config {
 	void *tx_lock;
 	/** Context information about peers that the RPU firmware is connected to. */
 	struct peers_info peers[MAX_SW_PEERS];
+	/** Hashed MAC address to peer index map, -1 marks an empty bucket. */
+	signed char peer_hash[NRF_WIFI_PEER_HASH_SIZE];
+	/** Peer resolved by the most recent lookup, -1 if none. */
+	int last_peer_id;
 	/** Coalesce count of TX frames. */
 	unsigned int *send_pkt_coalesce_count_p;
 	/** per-peer/per-AC Queue for frames waiting to be passed to the RPU firmware for TX. */
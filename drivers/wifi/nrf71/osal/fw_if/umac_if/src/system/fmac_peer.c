@@ -14,30 +14,102 @@
 #include <nrf71_wifi_ctrl.h>
 #include "common/fmac_util.h"
 
+static unsigned int peer_hash(const unsigned char *mac_addr)
+{
+	/* The NIC specific part of the address carries most of the entropy. */
+	return (mac_addr[3] ^ (mac_addr[4] << 1) ^ (mac_addr[5] << 2) ^ mac_addr[5] >> 3) &
+	       (NRF_WIFI_PEER_HASH_SIZE - 1);
+}
+
+
+static void peer_hash_insert(struct tx_config *tx_config,
+			     int peer_id)
+{
+	unsigned int idx;
+	unsigned int i;
+
+	idx = peer_hash(tx_config->peers[peer_id].ra_addr);
+
+	for (i = 0; i < NRF_WIFI_PEER_HASH_SIZE; i++) {
+		if (tx_config->peer_hash[idx] == -1) {
+			tx_config->peer_hash[idx] = peer_id;
+			return;
+		}
+
+		idx = (idx + 1) & (NRF_WIFI_PEER_HASH_SIZE - 1);
+	}
+}
+
+
+static void peer_hash_rebuild(struct tx_config *tx_config)
+{
+	int i;
+
+	nrf_wifi_osal_mem_set(tx_config->peer_hash,
+			      0xFF,
+			      sizeof(tx_config->peer_hash));
+
+	for (i = 0; i < MAX_PEERS; i++) {
+		if (tx_config->peers[i].peer_id != -1) {
+			peer_hash_insert(tx_config, i);
+		}
+	}
+
+	tx_config->last_peer_id = -1;
+}
+
+
 int nrf_wifi_fmac_peer_get_id(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			      const unsigned char *mac_addr)
 {
-	int i;
+	unsigned int idx;
+	unsigned int i;
+	int peer_id;
 	struct peers_info *peer;
+	struct tx_config *tx_config;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+	tx_config = &sys_dev_ctx->tx_config;
 
 	if (nrf_wifi_util_is_multicast_addr(mac_addr)) {
 		return MAX_PEERS;
 	}
 
-	for (i = 0; i < MAX_PEERS; i++) {
-		peer = &sys_dev_ctx->tx_config.peers[i];
-		if (peer->peer_id == -1) {
-			continue;
+	/* Consecutive frames are usually destined to the same station. */
+	peer_id = tx_config->last_peer_id;
+
+	if (peer_id != -1) {
+		peer = &tx_config->peers[peer_id];
+
+		if ((peer->peer_id != -1) &&
+		    nrf_wifi_util_ether_addr_equal(mac_addr,
+						   (void *)peer->ra_addr)) {
+			return peer_id;
+		}
+	}
+
+	idx = peer_hash(mac_addr);
+
+	for (i = 0; i < NRF_WIFI_PEER_HASH_SIZE; i++) {
+		peer_id = tx_config->peer_hash[idx];
+
+		if (peer_id == -1) {
+			break;
 		}
 
-		if ((nrf_wifi_util_ether_addr_equal(mac_addr,
-						    (void *)peer->ra_addr))) {
-			return peer->peer_id;
+		peer = &tx_config->peers[peer_id];
+
+		if ((peer->peer_id != -1) &&
+		    nrf_wifi_util_ether_addr_equal(mac_addr,
+						   (void *)peer->ra_addr)) {
+			tx_config->last_peer_id = peer_id;
+			return peer_id;
 		}
+
+		idx = (idx + 1) & (NRF_WIFI_PEER_HASH_SIZE - 1);
 	}
+
 	return -1;
 }
 
@@ -78,6 +150,7 @@ int nrf_wifi_fmac_peer_add(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			peer->peer_id = i;
 			peer->is_legacy = is_legacy;
 			peer->qos_supported = qos_supported;
+			peer_hash_insert(&sys_dev_ctx->tx_config, i);
 			return i;
 		}
 	}
@@ -114,6 +187,40 @@ void nrf_wifi_fmac_peer_remove(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
 			      0x0,
 			      sizeof(struct peers_info));
 	peer->peer_id = -1;
+
+	/* Removal is rare, rebuilding keeps the probe sequences free of holes. */
+	peer_hash_rebuild(&sys_dev_ctx->tx_config);
+}
+
+
+enum nrf_wifi_status nrf_wifi_fmac_peer_tx_stats_get(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx,
+						     const unsigned char *mac_addr,
+						     struct nrf_wifi_fmac_peer_tx_stats *stats)
+{
+	int peer_id;
+	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
+
+	if (!fmac_dev_ctx || !mac_addr || !stats) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
+
+	peer_id = nrf_wifi_fmac_peer_get_id(fmac_dev_ctx, mac_addr);
+
+	if (peer_id == -1) {
+		return NRF_WIFI_STATUS_FAIL;
+	}
+
+	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
+
+	nrf_wifi_osal_mem_cpy(stats,
+			      &sys_dev_ctx->tx_config.peers[peer_id].tx_stats,
+			      sizeof(*stats));
+
+	nrf_wifi_osal_spinlock_rel(sys_dev_ctx->tx_config.tx_lock);
+
+	return NRF_WIFI_STATUS_SUCCESS;
 }
 
 
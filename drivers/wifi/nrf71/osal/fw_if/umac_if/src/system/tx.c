@@ -1452,18 +1452,23 @@ static enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ct
 {
 	enum nrf_wifi_fmac_tx_status status = NRF_WIFI_FMAC_TX_STATUS_FAIL;
 	unsigned int desc = 0;
+	unsigned int len = 0;
 	struct nrf_wifi_fmac_priv *fpriv = NULL;
 	struct nrf_wifi_sys_fmac_dev_ctx *sys_dev_ctx = NULL;
 	struct nrf_wifi_sys_fmac_priv *sys_fpriv = NULL;
+	struct nrf_wifi_fmac_peer_tx_stats *tx_stats = NULL;
 
 	fpriv = fmac_dev_ctx->fpriv;
 	sys_dev_ctx = wifi_dev_priv(fmac_dev_ctx);
 	sys_fpriv = wifi_fmac_priv(fpriv);
+	tx_stats = &sys_dev_ctx->tx_config.peers[peer_id].tx_stats;
+	len = nrf_wifi_osal_nbuf_data_size(nbuf);
 
 	nrf_wifi_osal_spinlock_take(sys_dev_ctx->tx_config.tx_lock);
 
 
 	if (sys_fpriv->num_tx_tokens == 0) {
+		tx_stats->tx_dropped++;
 		goto out;
 	}
 
@@ -1474,9 +1479,13 @@ static enum nrf_wifi_fmac_tx_status nrf_wifi_fmac_tx(struct nrf_wifi_fmac_dev_ct
 			    peer_id);
 
 	if (status != NRF_WIFI_FMAC_TX_STATUS_SUCCESS) {
+		tx_stats->tx_dropped++;
 		goto out;
 	}
 
+	tx_stats->tx_pkts++;
+	tx_stats->tx_bytes += len;
+
 	status = NRF_WIFI_FMAC_TX_STATUS_QUEUED;
 
 	if (!can_xmit(fmac_dev_ctx, nbuf)) {
@@ -1585,6 +1594,12 @@ enum nrf_wifi_status tx_init(struct nrf_wifi_fmac_dev_ctx *fmac_dev_ctx)
 		sys_dev_ctx->tx_config.peers[i].peer_id = -1;
 	}
 
+	nrf_wifi_osal_mem_set(sys_dev_ctx->tx_config.peer_hash,
+			      0xFF,
+			      sizeof(sys_dev_ctx->tx_config.peer_hash));
+
+	sys_dev_ctx->tx_config.last_peer_id = -1;
+
 	sys_dev_ctx->tx_config.tx_lock = nrf_wifi_osal_spinlock_alloc();
 
 	if (!sys_dev_ctx->tx_config.tx_lock) {
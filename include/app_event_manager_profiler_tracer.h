@@ -19,6 +19,7 @@
  * @{
  */
 
+#include <errno.h>
 #include <app_event_manager_profiler_tracer_priv.h>
 #include <nrf_profiler.h>
 
@@ -71,6 +72,33 @@ struct nrf_profiler_info {
 	_APP_EVENT_INFO_DEFINE(ename, ENCODE(types), ENCODE(labels), profile_func)
 
 
+/** @brief Configure sampling of a profiled event type.
+ *
+ * Only every @p sample_every event of the given type is profiled and no more than
+ * @p max_rate events of the type are profiled per second. Processing start and end
+ * are profiled only for the events whose submission was profiled. The configuration
+ * applies to events submitted after the function returns.
+ *
+ * @param event_name Name of the event type.
+ * @param sample_every Profile every N-th event. Values 0 and 1 profile every event.
+ * @param max_rate Maximum number of profiled events per second. Value 0 disables the limit.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -ENOENT If the event type is not profiled.
+ */
+#ifdef CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING
+int app_event_manager_profiler_tracer_sampling_set(const char *event_name,
+						   uint16_t sample_every, uint16_t max_rate);
+#else
+static inline int app_event_manager_profiler_tracer_sampling_set(const char *event_name,
+								 uint16_t sample_every,
+								 uint16_t max_rate)
+{
+	return -ENOTSUP;
+}
+#endif
+
+
 
 #ifdef __cplusplus
 }
@@ -101,6 +101,46 @@ int bl_root_of_trust_verify_external(const uint8_t *public_key,
 				     const uint8_t *firmware,
 				     const uint32_t firmware_len);
 
+/**
+ * @brief Verify a signature using a precomputed firmware hash.
+ *
+ * Same as @ref bl_root_of_trust_verify, but takes the SHA-256 hash of the
+ * firmware instead of the firmware itself. This allows the caller to reuse
+ * the hash for other purposes without hashing the firmware again.
+ *
+ * @param[in]  public_key       Public key.
+ * @param[in]  public_key_hash  Expected hash of the public key. This is the
+ *                              root of trust.
+ * @param[in]  signature        Firmware signature.
+ * @param[in]  firmware_hash    SHA-256 hash of the firmware.
+ *
+ * @retval 0          On success.
+ * @retval -EHASHINV  If public_key_hash didn't match public_key.
+ * @retval -ESIGINV   If signature validation failed.
+ * @return Any error code from @ref bl_sha256_init, @ref bl_sha256_update,
+ *         @ref bl_sha256_finalize, or @ref bl_secp256r1_validate if something
+ *         else went wrong.
+ *
+ * @remark No parameter can be NULL. Only available with ECDSA secp256r1.
+ */
+int bl_root_of_trust_verify_hash(const uint8_t *public_key,
+				 const uint8_t *public_key_hash,
+				 const uint8_t *signature,
+				 const uint8_t *firmware_hash);
+
+/**
+ * @brief Calculate the SHA-256 hash of data.
+ *
+ * Not safe to be called from EXT_API.
+ *
+ * @param[in]  data      Data to hash.
+ * @param[in]  data_len  Length of data.
+ * @param[out] hash      Buffer of CONFIG_SB_HASH_LEN bytes to store the hash in.
+ *
+ * @return 0 if success, error code otherwise.
+ */
+int bl_sha256_hash(const uint8_t *data, uint32_t data_len, uint8_t *hash);
+
 /**
  * @brief Perform root of trust housekeeping operations.
  *
@@ -93,6 +93,16 @@ typedef struct {
 	uint8_t rtt_count;
 } cs_de_report_t;
 
+/**
+ * @brief Scratch memory used to calculate distance estimates
+ *
+ * Each caller running distance estimation concurrently must use its own workspace.
+ */
+typedef struct {
+	/** Zero-padded combined IQ values, overwritten by the IFFT. */
+	float iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+} cs_de_workspace_t;
+
 /**
  * @brief Combine the local and remote IQ values in a cs_de_iq_tones_t to one array.
  * This is done through an element wise complex multiplication of the local and remote IQ values.
@@ -111,9 +121,22 @@ void cs_de_combined_iq_calculate(cs_de_iq_tones_t *cs_de_iq_tones,
  * @param[inout] p_report The partially populated report to calculate distance with
  * @return Quality of the distance estimates, if at least one estimate is valid this will be
  * CS_DE_QUALITY_OK. Otherwise it is CS_DE_QUALITY_DO_NOT_USE and estimates should be ignored.
+ * @note This function uses a workspace shared by all callers and is not reentrant.
+ * Use @ref cs_de_calc_with_workspace to run estimations concurrently.
  */
 cs_de_quality_t cs_de_calc(cs_de_report_t *p_report);
 
+/**
+ * @brief Calculate distance estimates and quality for a given report using the given workspace
+ * This function behaves like @ref cs_de_calc, but it is reentrant as long as every concurrent
+ * caller provides its own workspace.
+ * @param[inout] p_report The partially populated report to calculate distance with
+ * @param[in] p_workspace Scratch memory for the calculation
+ * @return Quality of the distance estimates, see @ref cs_de_calc.
+ */
+cs_de_quality_t cs_de_calc_with_workspace(cs_de_report_t *p_report,
+					  cs_de_workspace_t *p_workspace);
+
 /**
  * @brief Calculates a distance estimate based on the IFFT magnitude of the input IQ values.
  * Note! After calling this function, the input IQ values in iq_tones_comb are overwritten with the
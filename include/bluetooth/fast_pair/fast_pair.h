@@ -115,6 +115,16 @@ struct bt_fast_pair_not_disc_adv_info {
 	 *  zero.
 	 */
 	enum bt_fast_pair_adv_battery_mode battery_mode;
+
+	/** Reuse the Salt generated during the previous advertising data update instead of
+	 *  generating a new one. A new Salt is generated if no Salt was generated before.
+	 *
+	 *  Reusing the Salt allows to skip the Account Key Filter computation if the Account Key
+	 *  list and the battery data did not change. Set this field only if the Resolvable Private
+	 *  Address (RPA) did not rotate since the previous advertising data update. Otherwise, the
+	 *  advertising payloads could be linked across RPA rotations.
+	 */
+	bool keep_salt;
 };
 
 /** @brief Fast Pair advertising config. Used to generate advertising packet. */
@@ -259,15 +259,29 @@ const struct bt_gatt_dm_attr *bt_gatt_dm_desc_next(
 	const struct bt_gatt_dm *dm,
 	const struct bt_gatt_dm_attr *prev);
 
+/** @brief Discovery cache statistics. */
+struct bt_gatt_dm_cache_stats {
+	/** Number of discoveries served from the cache. */
+	uint32_t hits;
+	/** Number of discoveries of bonded peers that missed the cache. */
+	uint32_t misses;
+};
+
 /** @brief Start service discovery.
  *
  * This function is asynchronous. Discovery results are passed through
  * the supplied callback.
  *
- * @note Only one discovery procedure can be started simultaneously. To start
- * another one, wait for the result of the previous procedure to finish
+ * @note Up to @kconfig{CONFIG_BT_GATT_DM_MAX_INSTANCES} discovery procedures
+ * can run simultaneously, one per connection. To start another one on the
+ * same connection, wait for the result of the previous procedure to finish
  * and call @ref bt_gatt_dm_data_release if it was successful.
  *
+ * @note If @kconfig{CONFIG_BT_GATT_DM_CACHE} is enabled and the peer is
+ * bonded, the peer GATT Database Hash is read first. If it matches the hash
+ * stored with the cached result, the completed callback is called with the
+ * cached attributes and no discovery procedure is run.
+ *
  * @param[in]     conn Connection object.
  * @param[in]     svc_uuid UUID of target service
  *                or NULL if any service should be discovered.
@@ -317,6 +331,12 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context);
  */
 int bt_gatt_dm_data_release(struct bt_gatt_dm *dm);
 
+/** @brief Get discovery cache statistics.
+ *
+ * @param[out] stats Cache statistics.
+ */
+void bt_gatt_dm_cache_stats_get(struct bt_gatt_dm_cache_stats *stats);
+
 /** @brief Print service discovery data.
  *
  * This function prints GATT attributes that belong to the discovered service.
@@ -235,6 +235,18 @@ struct ras_rd_buffer {
 	} procedure;
 };
 
+/** @brief RAS Ranging Data buffer statistics. */
+struct bt_ras_rd_buffer_stats {
+	/** Procedures overwritten before the peer acknowledged them. */
+	uint32_t overwritten;
+	/** Procedures dropped because no buffer was available. */
+	uint32_t alloc_failed;
+	/** Procedures dropped because they did not fit in a buffer. */
+	uint32_t out_of_space;
+	/** Procedures dropped because the local controller aborted them. */
+	uint32_t aborted;
+};
+
 /** @brief Allocate Ranging Responder instance for connection.
  *
  *  This will allocate an instance of the Ranging Responder service for the given connection.
@@ -322,6 +334,14 @@ int bt_ras_rd_buffer_release(struct ras_rd_buffer *buf);
 int bt_ras_rd_buffer_bytes_pull(struct ras_rd_buffer *buf, uint8_t *out_buf, uint16_t max_data_len,
 				uint16_t *read_cursor, bool *empty);
 
+/** @brief Get ranging data buffer statistics.
+ *
+ *  The statistics are accumulated over all connections.
+ *
+ *  @param[out] stats Ranging data buffer statistics.
+ */
+void bt_ras_rd_buffer_stats_get(struct bt_ras_rd_buffer_stats *stats);
+
 /** @brief Ranging data ready callback. Called when peer has ranging data available.
  *
  * @param[in] conn            Connection Object.
@@ -23,11 +23,16 @@ extern "C" {
 #endif
 
 /** @brief Sensor data aggregator event.
+ *
+ *  The event delivers a batch of samples. The timestamps are given as system uptime in
+ *  milliseconds and are valid only if the batch contains at least one sample.
  */
 struct sensor_data_aggregator_event {
 	struct app_event_header header;
 	const char *sensor_descr;
 	struct sensor_value *samples;
+	int64_t first_sample_time;
+	int64_t last_sample_time;
 	enum sensor_state sensor_state;
 	uint8_t sample_cnt;
 	uint8_t values_in_sample;
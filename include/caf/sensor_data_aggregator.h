@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SENSOR_DATA_AGGREGATOR_H_
+#define _SENSOR_DATA_AGGREGATOR_H_
+
+/**
+ * @file
+ * @defgroup caf_sensor_data_aggregator CAF Sensor Data Aggregator
+ * @{
+ * @brief CAF Sensor Data Aggregator.
+ *
+ * Producers located on the same core as the aggregator can write samples directly
+ * to the aggregator buffers instead of submitting @ref sensor_event. Only one producer
+ * can write samples of the given sensor.
+ */
+
+#include <stddef.h>
+#include <zephyr/drivers/sensor.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Claim a slot for the sample in the active aggregator buffer.
+ *
+ * The producer writes the sample directly to the returned slot and then calls
+ * @ref sensor_data_aggregator_sample_commit or @ref sensor_data_aggregator_sample_abort.
+ *
+ * @param sensor_descr Sensor description, must match the aggregator configuration.
+ * @param value_cnt Number of sensor values in the sample.
+ *
+ * @return Pointer to the slot or NULL if there is no matching aggregator, the number
+ *         of values does not match the aggregator configuration or no buffer is free.
+ */
+struct sensor_value *sensor_data_aggregator_sample_claim(const char *sensor_descr,
+							 size_t value_cnt);
+
+/** @brief Store the sample written to the claimed slot.
+ *
+ * The batch is delivered using @ref sensor_data_aggregator_event when the buffer is full.
+ * The sample is dropped if the buffer was delivered in the meantime because of the sensor
+ * state change.
+ *
+ * @param sensor_descr Sensor description.
+ * @param timestamp System uptime of the sample in milliseconds.
+ */
+void sensor_data_aggregator_sample_commit(const char *sensor_descr, int64_t timestamp);
+
+/** @brief Release the claimed slot without storing the sample.
+ *
+ * @param sensor_descr Sensor description.
+ */
+void sensor_data_aggregator_sample_abort(const char *sensor_descr);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _SENSOR_DATA_AGGREGATOR_H_ */
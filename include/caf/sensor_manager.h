@@ -85,6 +85,13 @@ struct sm_sensor_config {
 	 * @brief Flag to indicate whether sensor should be suspended or not.
 	 */
 	bool suspend;
+	/**
+	 * @brief Bus device the sensor is connected to
+	 *
+	 * Optional. Sensors connected to the same bus are sampled by the same
+	 * worker thread (see :kconfig:option:`CONFIG_CAF_SENSOR_MANAGER_WORKER_CNT`).
+	 */
+	const struct device *bus;
 };
 
 #ifdef __cplusplus
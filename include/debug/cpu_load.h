@@ -7,6 +7,7 @@
 #ifndef __CPU_LOAD_H
 #define __CPU_LOAD_H
 
+#include <stddef.h>
 #include <zephyr/types.h>
 #include <zephyr/toolchain.h>
 
@@ -14,6 +15,8 @@
 extern "C" {
 #endif
 
+struct k_thread;
+
 /**
  * @defgroup cpu_load CPU load
  * @brief Module for measuring CPU load.
@@ -50,6 +53,42 @@ void cpu_load_reset(void);
  */
 int cpu_load_get(void);
 
+/** @brief Type of the context in which the CPU was running. */
+enum cpu_load_context_type {
+	/** Thread. */
+	CPU_LOAD_CONTEXT_THREAD,
+	/** Interrupt service routine. */
+	CPU_LOAD_CONTEXT_ISR,
+};
+
+/** @brief CPU load of a single context. */
+struct cpu_load_context {
+	/** Type of the context. */
+	enum cpu_load_context_type type;
+	/** Thread. NULL for threads that did not fit in the table of tracked threads. */
+	const struct k_thread *thread;
+	/** Interrupt line. Negative for interrupts that could not be identified. */
+	int irq;
+	/** CPU cycles spent in the context during the sliding window. */
+	uint32_t cycles;
+};
+
+/** @brief Get the CPU load of threads and interrupt lines.
+ *
+ * The load is measured over the sliding window that consists of the
+ * CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_COUNT most recent complete windows.
+ * Only the contexts in which the CPU was running during the sliding window
+ * are reported. The idle thread is reported as any other thread.
+ *
+ * @param[out] ctx Array to store the contexts.
+ * @param[in] ctx_cnt Size of the array.
+ * @param[out] window_cycles Number of CPU cycles in the sliding window.
+ *
+ * @retval non-negative Number of contexts stored in the array.
+ * @retval -ENODEV if the module is not initialized.
+ */
+int cpu_load_context_get(struct cpu_load_context *ctx, size_t ctx_cnt, uint32_t *window_cycles);
+
 /** @} */
 
 #ifdef __cplusplus
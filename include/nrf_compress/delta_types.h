@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @file
+ * @brief Delta patch API types for compression/decompression subsystem
+ */
+
+#ifndef NRF_COMPRESS_DELTA_TYPES_H_
+#define NRF_COMPRESS_DELTA_TYPES_H_
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Delta patch header magic, "NRFD" in ASCII. */
+#define NRF_COMPRESS_DELTA_MAGIC 0x4446524e
+
+/** Supported delta patch format version. */
+#define NRF_COMPRESS_DELTA_VERSION 1
+
+/** Size of the delta patch header. */
+#define NRF_COMPRESS_DELTA_HEADER_SIZE 16
+
+/** Size of the delta patch record header. */
+#define NRF_COMPRESS_DELTA_RECORD_SIZE 12
+
+/**
+ * @typedef		delta_source_read_func_t
+ * @brief		Read source image interface. The source image is the image the
+ *			patch was created against, for example the content of the primary slot.
+ *
+ * @param[in]		offset Offset within the source image to start reading from.
+ * @param[out]		data Data buffer to read into.
+ * @param[in]		len Number of bytes to read.
+ *
+ * @retval		0 Success.
+ * @retval		-errno Negative errno code on failure.
+ */
+typedef int (*delta_source_read_func_t)(size_t offset, uint8_t *data, size_t len);
+
+/**
+ * @brief This is an initialization context struct type. Instantionize and pass it to
+ * interface functions like for e.g. nrf_compress_init_func_t, nrf_compress_decompress_func_t.
+ */
+typedef struct delta_codec_t {
+	/** Source image read function. */
+	const delta_source_read_func_t source_read;
+	/** Size of the source image in bytes. */
+	const size_t source_size;
+} delta_codec;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_COMPRESS_DELTA_TYPES_H_ */
@@ -13,6 +13,7 @@
 #define NRF_COMPRESS_IMPLEMENTATION_H_
 
 #include "lzma_types.h"
+#include "delta_types.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <zephyr/kernel.h>
@@ -141,6 +142,9 @@ enum nrf_compress_types {
 	/** ARM thumb filter */
 	NRF_COMPRESS_TYPE_ARM_THUMB,
 
+	/** Delta patch against a source image */
+	NRF_COMPRESS_TYPE_DELTA,
+
 	/** Marks end/count of nRF supported filters */
 	NRF_COMPRESS_TYPE_COUNT,
 
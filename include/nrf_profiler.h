@@ -310,6 +310,25 @@ static inline void nrf_profiler_log_send(struct log_event_buf *buf,
 				     uint16_t event_type_id) {}
 #endif
 
+/** @brief Send an event with a fixed-layout payload to the host.
+ *
+ * The function is a faster alternative to encoding the event data field by field.
+ * The event type ID and timestamp are added by the Profiler. The payload must be
+ * encoded in little-endian byte order and match the data types that were used
+ * when the event type was registered.
+ *
+ * @param event_type_id Event type ID as assigned to the event type
+ *                      when it is registered.
+ * @param payload Pointer to the encoded event data.
+ * @param len Length of the encoded event data.
+ */
+#ifdef CONFIG_NRF_PROFILER
+void nrf_profiler_log_send_raw(uint16_t event_type_id, const uint8_t *payload, size_t len);
+#else
+static inline void nrf_profiler_log_send_raw(uint16_t event_type_id, const uint8_t *payload,
+					     size_t len) {}
+#endif
+
 
 /**
  * @}
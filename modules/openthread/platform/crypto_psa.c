@@ -126,6 +126,54 @@ static otError getKeyRef(otCryptoKeyRef *aInputKeyRef, psa_key_attributes_t *aAt
 		}                                                                                  \
 	} while (0)
 
+#if defined(CONFIG_OPENTHREAD_CRYPTO_PSA_AES_ECB_OPERATION_CACHE)
+/* Single cipher operation reused for consecutive blocks encrypted with the same key. */
+static struct {
+	psa_cipher_operation_t operation;
+	psa_key_id_t key_ref;
+	bool active;
+} aes_ecb_cache;
+
+static void aesEcbCacheInvalidate(void)
+{
+	if (aes_ecb_cache.active) {
+		psa_cipher_abort(&aes_ecb_cache.operation);
+		aes_ecb_cache.active = false;
+	}
+}
+
+static psa_status_t aesEcbCacheEncrypt(psa_key_id_t aKeyRef, const uint8_t *aInput,
+				       uint8_t *aOutput, size_t aBlockSize)
+{
+	psa_status_t status;
+	size_t cipher_length = 0;
+
+	if (!aes_ecb_cache.active || aes_ecb_cache.key_ref != aKeyRef) {
+		aesEcbCacheInvalidate();
+
+		aes_ecb_cache.operation = psa_cipher_operation_init();
+		status = psa_cipher_encrypt_setup(&aes_ecb_cache.operation, aKeyRef,
+						  PSA_ALG_ECB_NO_PADDING);
+		if (status != PSA_SUCCESS) {
+			return status;
+		}
+
+		aes_ecb_cache.key_ref = aKeyRef;
+		aes_ecb_cache.active = true;
+	}
+
+	status = psa_cipher_update(&aes_ecb_cache.operation, aInput, aBlockSize, aOutput,
+				   aBlockSize, &cipher_length);
+	if (status != PSA_SUCCESS || cipher_length != aBlockSize) {
+		/* The driver buffers input or failed, fall back to one-shot encryption. */
+		aesEcbCacheInvalidate();
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	return PSA_SUCCESS;
+}
+#endif /* CONFIG_OPENTHREAD_CRYPTO_PSA_AES_ECB_OPERATION_CACHE */
+
 static otError psaToOtError(psa_status_t aStatus)
 {
 	switch (aStatus) {
@@ -301,6 +349,11 @@ otError otPlatCryptoImportKey(otCryptoKeyRef *aKeyRef, otCryptoKeyType aKeyType,
 	}
 #endif
 
+#if defined(CONFIG_OPENTHREAD_CRYPTO_PSA_AES_ECB_OPERATION_CACHE)
+	/* Key reference may be reused for different key material. */
+	aesEcbCacheInvalidate();
+#endif
+
 	psa_set_key_type(&attributes, toPsaKeyType(aKeyType));
 	psa_set_key_algorithm(&attributes, toPsaAlgorithm(aKeyAlgorithm));
 	psa_set_key_usage_flags(&attributes, toPsaKeyUsage(aKeyUsage));
@@ -350,6 +403,12 @@ otError otPlatCryptoDestroyKey(otCryptoKeyRef aKeyRef)
 {
 	GET_KEY_REF(&aKeyRef, NULL);
 
+#if defined(CONFIG_OPENTHREAD_CRYPTO_PSA_AES_ECB_OPERATION_CACHE)
+	if (aes_ecb_cache.key_ref == aKeyRef) {
+		aesEcbCacheInvalidate();
+	}
+#endif
+
 	return psaToOtError(psa_destroy_key(aKeyRef));
 }
 
@@ -465,6 +524,9 @@ otError otPlatCryptoAesSetKey(otCryptoContext *aContext, const otCryptoKey *aKey
 	key_ref = aContext->mContext;
 	*key_ref = aKey->mKeyRef;
 
+	/* Resolve the key reference once here instead of for every encrypted block. */
+	GET_KEY_REF(key_ref, NULL);
+
 	return OT_ERROR_NONE;
 }
 
@@ -481,7 +543,12 @@ otError otPlatCryptoAesEncrypt(otCryptoContext *aContext, const uint8_t *aInput,
 
 	memcpy(&key_ref, aContext->mContext, sizeof(psa_key_id_t));
 
-	GET_KEY_REF(&key_ref, NULL);
+#if defined(CONFIG_OPENTHREAD_CRYPTO_PSA_AES_ECB_OPERATION_CACHE)
+	status = aesEcbCacheEncrypt(key_ref, aInput, aOutput, block_size);
+	if (status != PSA_ERROR_NOT_SUPPORTED) {
+		return psaToOtError(status);
+	}
+#endif
 
 	status = psa_cipher_encrypt(key_ref, PSA_ALG_ECB_NO_PADDING, aInput, block_size, aOutput,
 				    block_size, &cipher_length);
@@ -164,13 +164,12 @@ struct nrf5_header_ie {
 } __packed;
 
 struct nrf5_rx_frame {
-	void *fifo_reserved; /* 1st word reserved for use by fifo. */
-	uint8_t *psdu;	     /* Pointer to a received frame. The first byte is PHR (length)*/
-	uint64_t time;	     /* RX timestamp. */
-	uint8_t lqi;	     /* Last received frame LQI value. */
-	int8_t rssi;	     /* Last received frame RSSI value. */
-	bool ack_fpb;	     /* FPB value in ACK sent for the received frame. */
-	bool ack_seb;	     /* SEB value in ACK sent for the received frame. */
+	uint8_t *psdu;	/* Pointer to a received frame. The first byte is PHR (length)*/
+	uint64_t time;	/* RX timestamp. */
+	uint8_t lqi;	/* Last received frame LQI value. */
+	int8_t rssi;	/* Last received frame RSSI value. */
+	bool ack_fpb;	/* FPB value in ACK sent for the received frame. */
+	bool ack_seb;	/* SEB value in ACK sent for the received frame. */
 };
 
 /** Energy detection callback */
@@ -204,13 +203,30 @@ struct nrf5_data {
 	otRadioCaps capabilities;
 
 	struct {
-		/* Buffers for passing received frame pointers and data to the
-		 * RX thread via rx fifo object.
+		/* Single-producer, single-consumer ring passing received frame
+		 * pointers and data from the radio driver callback to the
+		 * OpenThread task. There is one slot per driver RX buffer, so the
+		 * ring can only fill up when the driver has run out of buffers.
 		 */
 		struct nrf5_rx_frame frames[CONFIG_NRF_802154_RX_BUFFERS];
 
-		/* RX fifo queue. */
-		struct k_fifo fifo;
+		/* Next slot written by the driver callback. */
+		uint32_t head;
+
+		/* Next slot read by the OpenThread task. */
+		uint32_t tail;
+
+		/* Number of frames queued in the ring. */
+		atomic_t count;
+
+		/* Highest number of frames queued in the ring at once. */
+		atomic_t high_water_mark;
+
+		/* Number of times all driver RX buffers were held by the ring. */
+		atomic_t starvation_count;
+
+		/* Number of frames dropped because the ring was full. */
+		atomic_t drop_count;
 
 		/* Frame pending bit value in ACK sent for the last received frame. */
 		bool last_frame_ack_fpb;
@@ -614,8 +630,6 @@ static void openthread_nrf_802154_radio_client_init(void)
 
 	nrf5_get_eui64(nrf5_data.mac);
 
-	k_fifo_init(&nrf5_data.rx.fifo);
-
 	nrf5_data.tx.frame.mPsdu = PSDU_DATA(nrf5_data.tx.psdu);
 #if defined(CONFIG_OPENTHREAD_TIME_SYNC)
 	nrf5_data.tx.frame.mInfo.mTxInfo.mIeInfo = &nrf5_data.tx.ie_info;
@@ -645,15 +659,16 @@ void platformRadioInit(void)
 
 static void openthread_handle_received_frame(otInstance *instance, struct nrf5_rx_frame *rx_frame)
 {
-	otRadioFrame recv_frame;
+	/* Reused for every frame; only the fields below differ between frames
+	 * and OpenThread does not keep a reference past otPlatRadioReceiveDone.
+	 */
+	static otRadioFrame recv_frame;
 	uint8_t *psdu;
 
 	ARG_UNUSED(instance);
 
 	__ASSERT_NO_MSG(rx_frame->psdu != NULL);
 
-	memset(&recv_frame, 0, sizeof(otRadioFrame));
-
 	recv_frame.mPsdu = PSDU_DATA(rx_frame->psdu);
 	/* Length inc. CRC. */
 	recv_frame.mLength = PSDU_LENGTH(rx_frame->psdu);
@@ -775,11 +790,23 @@ static bool nrf5_tx_at(otRadioFrame *frame, uint8_t *payload)
 
 static void handle_frame_received(otInstance *aInstance)
 {
-	struct nrf5_rx_frame *rx_frame;
+	struct nrf5_rx_frame rx_frame;
 
-	while ((rx_frame = (struct nrf5_rx_frame *)k_fifo_get(&nrf5_data.rx.fifo, K_NO_WAIT)) !=
-	       NULL) {
-		openthread_handle_received_frame(aInstance, rx_frame);
+	/* Drain the whole batch. The driver callback signals the pending event
+	 * only when the ring goes from empty to non-empty, so frames received
+	 * while the batch is processed are picked up by this loop.
+	 */
+	while (atomic_get(&nrf5_data.rx.count) > 0) {
+		/* Release the slot before the PSDU is returned to the driver, as
+		 * the driver may receive into it and queue a new frame right away.
+		 */
+		rx_frame = nrf5_data.rx.frames[nrf5_data.rx.tail];
+		nrf5_data.rx.frames[nrf5_data.rx.tail].psdu = NULL;
+
+		nrf5_data.rx.tail = (nrf5_data.rx.tail + 1) % ARRAY_SIZE(nrf5_data.rx.frames);
+		atomic_dec(&nrf5_data.rx.count);
+
+		openthread_handle_received_frame(aInstance, &rx_frame);
 	}
 }
 
@@ -1822,30 +1849,49 @@ otError platformRadioTransmitModulatedCarrier(otInstance *aInstance, bool aEnabl
 static void openthread_nrf_802154_received_timestamp_raw(uint8_t *data, int8_t power, uint8_t lqi,
 							 uint64_t time)
 {
-	for (uint32_t i = 0; i < ARRAY_SIZE(nrf5_data.rx.frames); i++) {
-		if (nrf5_data.rx.frames[i].psdu != NULL) {
-			continue;
-		}
-
-		nrf5_data.rx.frames[i].psdu = data;
-		nrf5_data.rx.frames[i].rssi = power;
-		nrf5_data.rx.frames[i].lqi = lqi;
-
-		nrf5_data.rx.frames[i].time =
-			nrf_802154_timestamp_end_to_phr_convert(time, data[0]);
+	struct nrf5_rx_frame *rx_frame;
+	atomic_val_t queued;
 
-		nrf5_data.rx.frames[i].ack_fpb = nrf5_data.rx.last_frame_ack_fpb;
-		nrf5_data.rx.frames[i].ack_seb = nrf5_data.rx.last_frame_ack_seb;
+	if (atomic_get(&nrf5_data.rx.count) >= ARRAY_SIZE(nrf5_data.rx.frames)) {
+		/* Cannot happen unless the driver hands out more buffers than
+		 * CONFIG_NRF_802154_RX_BUFFERS. Give the buffer back rather than
+		 * leaking it.
+		 */
+		atomic_inc(&nrf5_data.rx.drop_count);
 		nrf5_data.rx.last_frame_ack_fpb = false;
 		nrf5_data.rx.last_frame_ack_seb = false;
+		nrf_802154_buffer_free_raw(data);
+		return;
+	}
 
-		k_fifo_put(&nrf5_data.rx.fifo, &nrf5_data.rx.frames[i]);
-		set_pending_event(PENDING_EVENT_FRAME_RECEIVED);
+	rx_frame = &nrf5_data.rx.frames[nrf5_data.rx.head];
 
-		return;
+	rx_frame->psdu = data;
+	rx_frame->rssi = power;
+	rx_frame->lqi = lqi;
+	rx_frame->time = nrf_802154_timestamp_end_to_phr_convert(time, data[0]);
+	rx_frame->ack_fpb = nrf5_data.rx.last_frame_ack_fpb;
+	rx_frame->ack_seb = nrf5_data.rx.last_frame_ack_seb;
+	nrf5_data.rx.last_frame_ack_fpb = false;
+	nrf5_data.rx.last_frame_ack_seb = false;
+
+	nrf5_data.rx.head = (nrf5_data.rx.head + 1) % ARRAY_SIZE(nrf5_data.rx.frames);
+
+	/* Publish the slot only after it has been filled in. */
+	queued = atomic_inc(&nrf5_data.rx.count) + 1;
+
+	if (queued > atomic_get(&nrf5_data.rx.high_water_mark)) {
+		atomic_set(&nrf5_data.rx.high_water_mark, queued);
+	}
+
+	if (queued == ARRAY_SIZE(nrf5_data.rx.frames)) {
+		atomic_inc(&nrf5_data.rx.starvation_count);
 	}
 
-	__ASSERT(false, "Not enough rx frames allocated for nrf5 radio");
+	/* One wakeup per batch: the OpenThread task drains everything queued. */
+	if (queued == 1) {
+		set_pending_event(PENDING_EVENT_FRAME_RECEIVED);
+	}
 }
 
 static void openthread_nrf_802154_receive_failed(nrf_802154_rx_error_t error, uint32_t id)
@@ -2010,6 +2056,13 @@ void openthread_platform_radio_set_eui64(uint8_t eui64[EXTENDED_ADDRESS_SIZE])
 #endif
 }
 
+void openthread_platform_radio_rx_stats_get(struct openthread_platform_radio_rx_stats *stats)
+{
+	stats->high_water_mark = (uint32_t)atomic_get(&nrf5_data.rx.high_water_mark);
+	stats->starvation_count = (uint32_t)atomic_get(&nrf5_data.rx.starvation_count);
+	stats->drop_count = (uint32_t)atomic_get(&nrf5_data.rx.drop_count);
+}
+
 #ifdef CONFIG_NRF_802154_CALLBACKS_DISPATCHER
 
 static struct nrf_802154_radio_client_config *openthread_nrf_802154_radio_client_get_config(void)
@@ -2026,6 +2079,10 @@ static void openthread_nrf_802154_release_rx_frames(void)
 		}
 	}
 
+	nrf5_data.rx.head = 0;
+	nrf5_data.rx.tail = 0;
+	atomic_set(&nrf5_data.rx.count, 0);
+
 	if (nrf5_data.ack.desc.psdu != NULL) {
 		nrf_802154_buffer_free_raw(nrf5_data.ack.desc.psdu);
 		nrf5_data.ack.desc.psdu = NULL;
@@ -13,4 +13,18 @@
 
 void openthread_platform_radio_set_eui64(uint8_t eui64[EXTENDED_ADDRESS_SIZE]);
 
+/** Statistics of the ring passing received frames to the OpenThread task. */
+struct openthread_platform_radio_rx_stats {
+	/** Highest number of received frames waiting for the OpenThread task at once. */
+	uint32_t high_water_mark;
+
+	/** Number of times every radio driver RX buffer was waiting for the OpenThread task. */
+	uint32_t starvation_count;
+
+	/** Number of received frames dropped because no ring slot was free. */
+	uint32_t drop_count;
+};
+
+void openthread_platform_radio_rx_stats_get(struct openthread_platform_radio_rx_stats *stats);
+
 #endif /* OT_PLATFORM_RADIO_NRF5_Hz */
@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Create, apply and benchmark delta patches for the nrf_compress delta implementation.
+
+A patch describes the target image as a sequence of records. Each record adds diff bytes to
+the source image at the current source position, appends extra bytes and moves the source
+position. Small changes to an application move code and shift addresses, so most of the diff
+bytes are zero and the patch compresses well with LZMA.
+"""
+
+import argparse
+import lzma
+import struct
+import sys
+import time
+
+DELTA_MAGIC = 0x4446524e
+DELTA_VERSION = 1
+HEADER_FORMAT = '<IB3xII'
+RECORD_FORMAT = '<IIi'
+
+# Length of the blocks used to find matches between source and target.
+BLOCK_LEN = 8
+# Shortest exact match that starts a new diff region.
+MIN_MATCH_LEN = 16
+# Diff regions are extended while at least half of the bytes in a window match.
+EXTEND_WINDOW_LEN = 16
+# Maximum number of source candidates checked for every block.
+MAX_CANDIDATES = 8
+
+
+def build_index(source):
+    index = {}
+
+    for pos in range(len(source) - BLOCK_LEN + 1):
+        candidates = index.setdefault(source[pos:pos + BLOCK_LEN], [])
+        if len(candidates) < MAX_CANDIDATES:
+            candidates.append(pos)
+
+    return index
+
+
+def find_match(source, target, index, t_pos, hint):
+    candidates = list(index.get(target[t_pos:t_pos + BLOCK_LEN], ()))
+    if hint is not None and 0 <= hint < len(source):
+        candidates.insert(0, hint)
+
+    best_pos = None
+    best_len = 0
+
+    for s_pos in candidates:
+        length = 0
+        while (s_pos + length < len(source) and t_pos + length < len(target) and
+               source[s_pos + length] == target[t_pos + length]):
+            length += 1
+
+        if length > best_len:
+            best_pos = s_pos
+            best_len = length
+
+    return best_pos, best_len
+
+
+def extend_match(source, target, s_pos, t_pos, length):
+    """Extend an exact match while the following bytes mostly match."""
+    while True:
+        window = min(EXTEND_WINDOW_LEN, len(source) - s_pos - length,
+                     len(target) - t_pos - length)
+        if window <= 0:
+            break
+
+        equal = sum(1 for i in range(window)
+                    if source[s_pos + length + i] == target[t_pos + length + i])
+        if equal * 2 < window:
+            break
+
+        length += window
+
+    return length
+
+
+def find_regions(source, target):
+    """Return list of (target position, source position, length) diff regions."""
+    index = build_index(source)
+    regions = []
+    t_pos = 0
+    hint = None
+
+    while t_pos + BLOCK_LEN <= len(target):
+        s_pos, length = find_match(source, target, index, t_pos, hint)
+
+        if length < MIN_MATCH_LEN:
+            t_pos += 1
+            if hint is not None:
+                hint += 1
+            continue
+
+        length = extend_match(source, target, s_pos, t_pos, length)
+        regions.append((t_pos, s_pos, length))
+        t_pos += length
+        hint = s_pos + length
+
+    return regions
+
+
+def create_patch(source, target):
+    regions = find_regions(source, target)
+    patch = bytearray(struct.pack(HEADER_FORMAT, DELTA_MAGIC, DELTA_VERSION, len(source),
+                                  len(target)))
+    s_cur = 0
+    t_cur = 0
+
+    # Leading extra bytes before the first region.
+    first_t, first_s = (regions[0][0], regions[0][1]) if regions else (len(target), 0)
+    if first_t > 0 or first_s > 0:
+        patch += struct.pack(RECORD_FORMAT, 0, first_t, first_s)
+        patch += target[:first_t]
+        s_cur = first_s
+        t_cur = first_t
+
+    for i, (t_pos, s_pos, length) in enumerate(regions):
+        assert t_pos == t_cur and s_pos == s_cur
+
+        if i + 1 < len(regions):
+            next_t, next_s = regions[i + 1][0], regions[i + 1][1]
+        else:
+            next_t, next_s = len(target), s_pos + length
+
+        extra = target[t_pos + length:next_t]
+        patch += struct.pack(RECORD_FORMAT, length, len(extra), next_s - (s_pos + length))
+        patch += bytes((target[t_pos + j] - source[s_pos + j]) & 0xff for j in range(length))
+        patch += extra
+
+        s_cur = next_s
+        t_cur = next_t
+
+    return bytes(patch)
+
+
+def apply_patch(source, patch):
+    magic, version, source_size, target_size = struct.unpack_from(HEADER_FORMAT, patch)
+    if magic != DELTA_MAGIC or version != DELTA_VERSION:
+        raise ValueError('Invalid patch header')
+    if source_size != len(source):
+        raise ValueError(f'Patch created for a source of {source_size} bytes')
+
+    pos = struct.calcsize(HEADER_FORMAT)
+    s_pos = 0
+    target = bytearray()
+
+    while pos < len(patch):
+        diff_len, extra_len, seek = struct.unpack_from(RECORD_FORMAT, patch, pos)
+        pos += struct.calcsize(RECORD_FORMAT)
+
+        target += bytes((source[s_pos + i] + patch[pos + i]) & 0xff for i in range(diff_len))
+        pos += diff_len
+        s_pos += diff_len
+
+        target += patch[pos:pos + extra_len]
+        pos += extra_len
+        s_pos += seek
+
+        if not 0 <= s_pos <= len(source):
+            raise ValueError('Invalid source position adjustment')
+
+    if len(target) != target_size:
+        raise ValueError('Patched image size mismatch')
+
+    return bytes(target)
+
+
+def lzma2_compress(data, dict_size):
+    """Compress data to the LZMA2 format used by the nrf_compress LZMA implementation."""
+    lc, lp, pb = 3, 1, 2
+    filters = [{'id': lzma.FILTER_LZMA2, 'preset': 9, 'dict_size': dict_size,
+                'lc': lc, 'lp': lp, 'pb': pb}]
+    compressed = lzma.compress(data, format=lzma.FORMAT_RAW, filters=filters)
+
+    # Header: LZMA2 dictionary size property and the lc/lp/pb properties.
+    dict_prop = next(i for i in range(40)
+                     if dict_size <= (2 | (i & 1)) << (i // 2 + 11))
+    return bytes([dict_prop, (pb * 5 + lp) * 9 + lc]) + compressed
+
+
+def read_file(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+def write_file(path, data):
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+def cmd_create(args):
+    patch = create_patch(read_file(args.source), read_file(args.target))
+    if args.lzma:
+        patch = lzma2_compress(patch, args.dict_size)
+    write_file(args.patch, patch)
+
+
+def cmd_apply(args):
+    write_file(args.target, apply_patch(read_file(args.source), read_file(args.patch)))
+
+
+def cmd_bench(args):
+    source = read_file(args.source)
+    target = read_file(args.target)
+
+    start = time.perf_counter()
+    patch = create_patch(source, target)
+    create_time = time.perf_counter() - start
+
+    start = time.perf_counter()
+    if apply_patch(source, patch) != target:
+        sys.exit('Patch verification failed')
+    apply_time = time.perf_counter() - start
+
+    target_lzma = lzma2_compress(target, args.dict_size)
+    patch_lzma = lzma2_compress(patch, args.dict_size)
+
+    def report(name, size):
+        print(f'{name:<16}{size:>10} bytes {100 * size / len(target):>7.2f} %')
+
+    report('Target', len(target))
+    report('Target LZMA2', len(target_lzma))
+    report('Patch', len(patch))
+    report('Patch LZMA2', len(patch_lzma))
+    print(f'Patch creation  {create_time:>10.3f} s')
+    print(f'Patch apply     {len(target) / apply_time / 1024:>10.1f} KiB/s (host, Python)')
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description='Create, apply and benchmark nrf_compress delta patches.',
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        allow_abbrev=False)
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    create = subparsers.add_parser('create', help='Create a patch.', allow_abbrev=False)
+    create.add_argument('--source', required=True, help='Source (currently installed) image.')
+    create.add_argument('--target', required=True, help='Target (new) image.')
+    create.add_argument('--patch', required=True, help='Output patch file.')
+    create.add_argument('--lzma', action='store_true',
+                        help='Compress the patch with LZMA2 for the nrf_compress LZMA '
+                             'implementation.')
+    create.set_defaults(func=cmd_create)
+
+    apply = subparsers.add_parser('apply', help='Apply an uncompressed patch.',
+                                  allow_abbrev=False)
+    apply.add_argument('--source', required=True, help='Source image.')
+    apply.add_argument('--patch', required=True, help='Patch file.')
+    apply.add_argument('--target', required=True, help='Output image.')
+    apply.set_defaults(func=cmd_apply)
+
+    bench = subparsers.add_parser('bench', help='Report patch sizes and throughput.',
+                                  allow_abbrev=False)
+    bench.add_argument('--source', required=True, help='Source image.')
+    bench.add_argument('--target', required=True, help='Target image.')
+    bench.set_defaults(func=cmd_bench)
+
+    for sub in (create, bench):
+        sub.add_argument('--dict-size', type=lambda x: int(x, 0), default=131072,
+                         help='LZMA2 dictionary size, must not exceed '
+                              'CONFIG_NRF_COMPRESS_LZMA_MAX_DICT_SIZE.')
+
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    args.func(args)
+
+
+if __name__ == '__main__':
+    main()
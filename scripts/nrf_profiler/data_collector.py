@@ -9,8 +9,8 @@ import signal
 import time
 from multiprocessing import Event, Process, active_children
 
+from file2stream import File2Stream
 from model_creator import ModelCreator
-from rtt2stream import Rtt2Stream
 from stream import Stream
 
 is_waiting = True
@@ -21,12 +21,24 @@ def signal_handler(sig, frame):
 def rtt2stream(stream, event, event_close, log_lvl_number):
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     try:
+        # Imported here, so that files can be processed without the RTT dependencies.
+        from rtt2stream import Rtt2Stream
+
         rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
         event.wait()
         rtt2s.read_and_transmit_data()
     except Exception as e:
         print(f"[ERROR] Unhandled exception in Profiler Rtt to stream module: {e}")
 
+def file2stream(stream, event, event_close, file_path, log_lvl_number):
+    signal.signal(signal.SIGINT, signal.SIG_IGN)
+    try:
+        file2s = File2Stream(stream, event_close, file_path, log_lvl=log_lvl_number)
+        event.wait()
+        file2s.read_and_transmit_data()
+    except Exception as e:
+        print(f"[ERROR] Unhandled exception in Profiler file to stream module: {e}")
+
 def model_creator(stream, event, event_close, dataset_name, log_lvl_number):
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     try:
@@ -51,6 +63,9 @@ def main():
     parser.add_argument('time', type=int, help='Time of collecting data [s]')
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    parser.add_argument('--file',
+                        help='Read data written by the file transport (native simulator) from '
+                             'FILE.info and FILE.bin instead of using RTT')
     args = parser.parse_args()
 
     if args.log is not None:
@@ -67,10 +82,18 @@ def main():
     streams = Stream.create_stream(2)
 
     processes = []
-    processes.append((Process(target=rtt2stream,
-                                args=(streams[0], event, event_close_rtt2stream, log_lvl_number),
-                                daemon=True),
-                        event_close_rtt2stream))
+    if args.file is not None:
+        processes.append((Process(target=file2stream,
+                                    args=(streams[0], event, event_close_rtt2stream, args.file,
+                                          log_lvl_number),
+                                    daemon=True),
+                            event_close_rtt2stream))
+    else:
+        processes.append((Process(target=rtt2stream,
+                                    args=(streams[0], event, event_close_rtt2stream,
+                                          log_lvl_number),
+                                    daemon=True),
+                            event_close_rtt2stream))
     processes.append((Process(target=model_creator,
                                 args=(streams[1], event, event_close_model_creator,
                                     args.dataset_name, log_lvl_number),
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+"""
+Reconstruct latency histograms of Application Event Manager events from an nRF Profiler dataset.
+
+For every event type, the script reports the histogram of the time between the event submission
+and the processing start (queue latency) and the histogram of the time between the processing
+start and end (time spent in the listeners).
+
+Both the compact trace records (CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT) and the events
+tracked by the default Application Event Manager profiler tracer records are supported.
+Compact records are matched using the memory address of the event.
+"""
+
+import argparse
+import logging
+import math
+from collections import defaultdict
+
+from processed_events import ProcessedEvents
+
+COMPACT_SUBMIT = "event_submit_compact"
+COMPACT_PROCESSING_START = "event_processing_start_compact"
+COMPACT_PROCESSING_END = "event_processing_end_compact"
+
+QUEUE_LATENCY = "queue latency"
+PROCESSING_TIME = "processing time"
+
+
+class LatencyHistograms:
+    def __init__(self, processed_data, logger):
+        self.processed_data = processed_data
+        self.logger = logger
+        # Samples in microseconds indexed by event name and measurement name.
+        self.samples = defaultdict(lambda: defaultdict(list))
+        self.unmatched = 0
+
+    def _event_name(self, type_id):
+        event_type = self.processed_data.registered_events_types.get(type_id)
+        return event_type.name if event_type is not None else f"<unknown id {type_id}>"
+
+    def _add(self, event_name, measurement, start, end, start_meas, end_meas):
+        if start_meas <= start <= end_meas:
+            self.samples[event_name][measurement].append((end - start) * 1e6)
+
+    def collect_tracked(self, start_meas, end_meas):
+        for tracked in self.processed_data.tracked_events:
+            if tracked.proc_start_time is None or tracked.proc_end_time is None:
+                continue
+
+            name = self._event_name(tracked.submit.type_id)
+            self._add(name, QUEUE_LATENCY, tracked.submit.timestamp, tracked.proc_start_time,
+                      start_meas, end_meas)
+            self._add(name, PROCESSING_TIME, tracked.proc_start_time, tracked.proc_end_time,
+                      start_meas, end_meas)
+
+    def collect_compact(self, start_meas, end_meas):
+        get_id = self.processed_data.get_event_type_id
+        submit_id = get_id(COMPACT_SUBMIT)
+        start_id = get_id(COMPACT_PROCESSING_START)
+        end_id = get_id(COMPACT_PROCESSING_END)
+
+        if submit_id is None:
+            return False
+
+        records = sorted((tracked.submit for tracked in self.processed_data.tracked_events
+                          if tracked.submit.type_id in (submit_id, start_id, end_id)),
+                         key=lambda ev: ev.timestamp)
+
+        # Memory address of an event is not reused before the event is processed and freed,
+        # so at most one submitted and one processed event can use a given address.
+        submitted = {}
+        processed = {}
+
+        for record in records:
+            event_id, mem_address = record.data[0], record.data[1]
+
+            if record.type_id == submit_id:
+                if mem_address in submitted:
+                    self.unmatched += 1
+                submitted[mem_address] = (event_id, record.timestamp)
+
+            elif record.type_id == start_id:
+                submit = submitted.pop(mem_address, None)
+                if submit is None or submit[0] != event_id:
+                    # Submission was sampled out or logged before the measurement started.
+                    self.unmatched += 1
+                    continue
+
+                self._add(self._event_name(event_id), QUEUE_LATENCY, submit[1],
+                          record.timestamp, start_meas, end_meas)
+                processed[mem_address] = (event_id, record.timestamp)
+
+            elif record.type_id == end_id:
+                start = processed.pop(mem_address, None)
+                if start is None or start[0] != event_id:
+                    self.unmatched += 1
+                    continue
+
+                self._add(self._event_name(event_id), PROCESSING_TIME, start[1],
+                          record.timestamp, start_meas, end_meas)
+
+        self.unmatched += len(submitted) + len(processed)
+
+        return True
+
+    @staticmethod
+    def _percentile(sorted_samples, percent):
+        idx = min(len(sorted_samples) - 1, int(len(sorted_samples) * percent / 100))
+        return sorted_samples[idx]
+
+    @staticmethod
+    def _print_histogram(samples, bar_len):
+        # Buckets with power of two upper bounds in microseconds.
+        buckets = defaultdict(int)
+        for sample in samples:
+            buckets[max(0, math.ceil(math.log2(max(sample, 1))))] += 1
+
+        max_cnt = max(buckets.values())
+        for exp in range(min(buckets), max(buckets) + 1):
+            cnt = buckets.get(exp, 0)
+            bar = "#" * math.ceil(cnt * bar_len / max_cnt) if cnt else ""
+            print(f"    <= {2 ** exp:>9} us {cnt:>8} {bar}")
+
+    def print(self, bar_len):
+        if not self.samples:
+            print("No matching event records found")
+            return
+
+        for event_name in sorted(self.samples):
+            print(event_name)
+            for measurement in (QUEUE_LATENCY, PROCESSING_TIME):
+                samples = sorted(self.samples[event_name][measurement])
+                if not samples:
+                    continue
+
+                print(f"  {measurement}: count {len(samples)}, "
+                      f"min {samples[0]:.1f} us, "
+                      f"mean {sum(samples) / len(samples):.1f} us, "
+                      f"median {self._percentile(samples, 50):.1f} us, "
+                      f"99th percentile {self._percentile(samples, 99):.1f} us, "
+                      f"max {samples[-1]:.1f} us")
+                self._print_histogram(samples, bar_len)
+
+        if self.unmatched:
+            self.logger.warning(f"{self.unmatched} compact records could not be matched")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Application Event Manager event latency "
+                                                 "histograms",
+                                     allow_abbrev=False)
+    parser.add_argument("dataset_name", help="Name of nRF Profiler dataset")
+    parser.add_argument("--start_time", type=float, default=0.0,
+                        help="Measurement start time [s]")
+    parser.add_argument("--end_time", type=float, default=float('inf'),
+                        help="Measurement end time [s]")
+    parser.add_argument("--bar_len", type=int, default=40,
+                        help="Length of the longest histogram bar")
+    parser.add_argument("--log", help="Log level")
+    args = parser.parse_args()
+
+    logger = logging.getLogger("event_latency")
+    logger.addHandler(logging.StreamHandler())
+    if args.log is not None:
+        logger.setLevel(int(getattr(logging, args.log.upper(), None)))
+    else:
+        logger.setLevel(logging.INFO)
+
+    processed_data = ProcessedEvents()
+    processed_data.read_data_from_files(f"{args.dataset_name}.csv",
+                                        f"{args.dataset_name}.json")
+
+    histograms = LatencyHistograms(processed_data, logger)
+    if not histograms.collect_compact(args.start_time, args.end_time):
+        histograms.collect_tracked(args.start_time, args.end_time)
+    histograms.print(args.bar_len)
+
+
+if __name__ == "__main__":
+    main()
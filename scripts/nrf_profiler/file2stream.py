@@ -0,0 +1,102 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import logging
+import sys
+import time
+
+from stream import Stream, StreamError
+
+
+class File2Stream:
+    """Read nrf_profiler data written by the file transport (native simulator).
+
+    The device writes event data to the <path>.bin file and event descriptions together with
+    system configuration to the <path>.info file.
+    """
+    INFO_FILE_SUFFIX = '.info'
+    DATA_FILE_SUFFIX = '.bin'
+    READ_CHUNK_SIZE = Stream.RECV_BUF_SIZE
+    READ_SLEEP_TIME = 0.01 # In seconds.
+
+    def __init__(self, out_stream, event_close, file_path, log_lvl=logging.INFO):
+        self.out_stream = out_stream
+        self.event_close = event_close
+        self.info_path = file_path + File2Stream.INFO_FILE_SUFFIX
+        self.data_path = file_path + File2Stream.DATA_FILE_SUFFIX
+        self.data_file = None
+
+        self.logger = logging.getLogger('file2stream')
+        self.logger_console = logging.StreamHandler()
+        self.logger.setLevel(log_lvl)
+        self.log_format = logging.Formatter('[%(levelname)s] %(name)s: %(message)s')
+        self.logger_console.setFormatter(self.log_format)
+        self.logger.addHandler(self.logger_console)
+
+    def _read_all_events_descriptions(self):
+        # Empty field is written after system configuration. The device rewrites the file
+        # whenever a new event type is registered.
+        while True:
+            if self.event_close.is_set():
+                self.logger.info("Module closed before receiving event descriptions.")
+                sys.exit()
+
+            try:
+                with open(self.info_path, 'rb') as f:
+                    desc_buf = f.read()
+            except OSError:
+                desc_buf = b''
+
+            if desc_buf[-2:] == b'\n\n':
+                return desc_buf
+
+            time.sleep(0.1)
+
+    def _read_bytes(self):
+        if self.data_file is None:
+            try:
+                self.data_file = open(self.data_path, 'rb')
+            except OSError:
+                return b''
+
+        return self.data_file.read(File2Stream.READ_CHUNK_SIZE)
+
+    def _send_bytes(self, buf):
+        try:
+            self.out_stream.send_ev(buf)
+        except StreamError as err:
+            self.logger.error(f"Error: {err}. Unable to send data")
+            sys.exit()
+
+    def read_and_transmit_data(self):
+        desc_buf = self._read_all_events_descriptions()
+        try:
+            self.out_stream.send_desc(desc_buf)
+        except StreamError as err:
+            self.logger.error(f"Error: {err}. Unable to send data")
+            sys.exit()
+
+        while True:
+            if self.event_close.is_set():
+                self.close()
+
+            buf = self._read_bytes()
+            if len(buf) > 0:
+                self._send_bytes(buf)
+
+            if len(buf) < File2Stream.READ_CHUNK_SIZE:
+                time.sleep(File2Stream.READ_SLEEP_TIME)
+
+    def close(self):
+        self.logger.info("File transmission closed")
+
+        buf = self._read_bytes()
+        while len(buf) > 0:
+            self._send_bytes(buf)
+            buf = self._read_bytes()
+
+        if self.data_file is not None:
+            self.data_file.close()
+        sys.exit()
@@ -22,6 +22,7 @@ class Command(Enum):
     INFO = 3
 
 NRF_PROFILER_FATAL_ERROR_EVENT_NAME = "_nrf_profiler_fatal_error_event_"
+NRF_PROFILER_DROPPED_EVENTS_EVENT_NAME = "_nrf_profiler_dropped_events_"
 
 class ModelCreator:
 
@@ -317,9 +318,13 @@ class ModelCreator:
                 self.event_types_filename)
         while True:
             event = self._read_single_event()
-            if self.raw_data.registered_events_types[event.type_id].name == NRF_PROFILER_FATAL_ERROR_EVENT_NAME:
+            event_name = self.raw_data.registered_events_types[event.type_id].name
+            if event_name == NRF_PROFILER_FATAL_ERROR_EVENT_NAME:
                 self.logger.error("Fatal error of Profiler on device! Event has been dropped. "
                                   "Data buffer has overflown. No more events will be received.")
+            elif event_name == NRF_PROFILER_DROPPED_EVENTS_EVENT_NAME:
+                self.logger.warning(f"Profiler on device dropped {event.data[0]} events. "
+                                    "Staging buffer has overflown.")
 
             if event.type_id == self.event_processing_start_id:
                 self.start_event = event
@@ -0,0 +1,119 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+SCRIPTS_DIR = Path(__file__).parent.parent
+
+# Timestamps of the recorded streams are given in microseconds.
+SYS_CLOCK_HW_CYCLES_PER_SEC = 1000000
+
+
+def write_recording(path, descriptions, records):
+    """Write a stream in the format of the nrf_profiler file transport."""
+    info = '<ev_info_start>\n'
+    info += ''.join(f'{descr}\n' for descr in descriptions)
+    info += '<ev_info_stop>\n'
+    info += '<sys_config_start>\n'
+    info += f'sys_clock_hw_cycles_per_sec,{SYS_CLOCK_HW_CYCLES_PER_SEC}\n'
+    info += '<sys_config_stop>\n\n'
+    path.with_suffix('.info').write_text(info)
+
+    data = b''.join(struct.pack('<BI', type_id, timestamp) + payload
+                    for type_id, timestamp, payload in records)
+    path.with_suffix('.bin').write_bytes(data)
+
+
+def run_script(script, *args, cwd):
+    return subprocess.run([sys.executable, str(SCRIPTS_DIR / script), *args], cwd=cwd,
+                          capture_output=True, text=True, timeout=60, check=True)
+
+
+def event_latency(tmp_path, descriptions, records):
+    recording = tmp_path / 'recording'
+    write_recording(recording, descriptions, records)
+
+    # data_collector.py converts the recorded stream to a dataset.
+    run_script('data_collector.py', '2', 'dataset', '--file', str(recording), cwd=tmp_path)
+    assert (tmp_path / 'dataset.csv').exists()
+
+    return run_script('event_latency.py', 'dataset', cwd=tmp_path)
+
+
+def stats_line(output, event_name, measurement):
+    lines = output.splitlines()
+    event_idx = lines.index(event_name)
+    for line in lines[event_idx + 1:]:
+        if not line.startswith(' '):
+            break
+        if line.strip().startswith(f'{measurement}:'):
+            return line.strip()
+    return None
+
+
+def compact(type_id, timestamp, event_id, mem_address):
+    return (type_id, timestamp, struct.pack('<BI', event_id, mem_address))
+
+
+def test_compact_records(tmp_path):
+    descriptions = [
+        'button_event,0,u8,button',
+        'led_event,1',
+        'event_submit_compact,2,u8,u32,event_id,mem_address',
+        'event_processing_start_compact,3,u8,u32,event_id,mem_address',
+        'event_processing_end_compact,4,u8,u32,event_id,mem_address',
+    ]
+    records = [
+        compact(2, 100, 0, 0x20000000),
+        compact(3, 150, 0, 0x20000000),
+        compact(4, 175, 0, 0x20000000),
+        # Memory address of a processed event is reused by the next event.
+        compact(2, 200, 1, 0x20000000),
+        compact(2, 210, 0, 0x20000010),
+        compact(3, 220, 1, 0x20000000),
+        compact(4, 230, 1, 0x20000000),
+        compact(3, 310, 0, 0x20000010),
+        compact(4, 350, 0, 0x20000010),
+        # Submission of the event was sampled out.
+        compact(3, 400, 0, 0x20000020),
+        compact(4, 410, 0, 0x20000020),
+    ]
+
+    result = event_latency(tmp_path, descriptions, records)
+
+    assert stats_line(result.stdout, 'button_event', 'queue latency').startswith(
+        'queue latency: count 2, min 50.0 us, mean 75.0 us, median 100.0 us, '
+        '99th percentile 100.0 us, max 100.0 us')
+    assert stats_line(result.stdout, 'button_event', 'processing time').startswith(
+        'processing time: count 2, min 25.0 us, mean 32.5 us')
+    assert stats_line(result.stdout, 'led_event', 'queue latency').startswith(
+        'queue latency: count 1, min 20.0 us')
+    assert stats_line(result.stdout, 'led_event', 'processing time').startswith(
+        'processing time: count 1, min 10.0 us')
+    assert '2 compact records could not be matched' in result.stderr
+
+
+def test_tracked_events(tmp_path):
+    descriptions = [
+        'button_event,0,u32,u8,_em_mem_address_,button',
+        'event_processing_start,1,u32,_em_mem_address_',
+        'event_processing_end,2,u32,_em_mem_address_',
+    ]
+    records = [
+        (0, 100, struct.pack('<IB', 0x20000000, 1)),
+        (1, 130, struct.pack('<I', 0x20000000)),
+        (2, 190, struct.pack('<I', 0x20000000)),
+    ]
+
+    result = event_latency(tmp_path, descriptions, records)
+
+    assert stats_line(result.stdout, 'button_event', 'queue latency').startswith(
+        'queue latency: count 1, min 30.0 us')
+    assert stats_line(result.stdout, 'button_event', 'processing time').startswith(
+        'processing time: count 1, min 60.0 us')
+    assert 'could not be matched' not in result.stderr
@@ -4,19 +4,223 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <string.h>
+#include <stdlib.h>
 #include <app_event_manager.h>
 #include <app_event_manager_profiler_tracer.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/shell/shell.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(app_event_manager_profiler_tracer, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
-#define IDS_COUNT (CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT + 2)
+/* nrf_profiler events used by the tracer are stored after the events of profiled
+ * Application Event Manager event types.
+ */
+enum trace_id {
+	TRACE_ID_PROCESSING_START,
+	TRACE_ID_PROCESSING_END,
+	TRACE_ID_COMPACT_SUBMIT,
+
+	TRACE_ID_COUNT
+};
+
+#define IDS_COUNT (CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT + TRACE_ID_COUNT)
+
+/* Compact record data: nrf_profiler ID of the event type and memory address of the event. */
+#define COMPACT_DATA_LEN (sizeof(uint8_t) + sizeof(uint32_t))
 
 extern struct nrf_profiler_info _nrf_profiler_info_list_start[];
 extern struct nrf_profiler_info _nrf_profiler_info_list_end[];
 
 static uint16_t nrf_profiler_event_ids[IDS_COUNT];
 
+static uint16_t trace_id_get(enum trace_id id)
+{
+	size_t event_cnt = _nrf_profiler_info_list_end - _nrf_profiler_info_list_start;
+
+	return nrf_profiler_event_ids[event_cnt + id];
+}
+
+#ifdef CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING
+#define IN_FLIGHT_MAX CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING_IN_FLIGHT_MAX
+#define RATE_WINDOW_MS 1000
+
+struct sampling_config {
+	uint16_t sample_every;
+	uint16_t max_rate;
+	uint16_t event_cnt;
+	uint16_t window_cnt;
+	uint32_t window_start;
+};
+
+struct in_flight_event {
+	const struct app_event_header *aeh;
+	size_t event_idx;
+};
+
+static struct sampling_config sampling[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+/* Sampled events that are submitted, but not yet processed. */
+static struct in_flight_event in_flight[IN_FLIGHT_MAX];
+static struct k_spinlock sampling_lock;
+
+static bool sampling_is_active(const struct sampling_config *sc)
+{
+	return (sc->sample_every > 1) || (sc->max_rate > 0);
+}
+
+static bool rate_limit_check(struct sampling_config *sc)
+{
+	if (sc->max_rate == 0) {
+		return true;
+	}
+
+	uint32_t now = k_uptime_get_32();
+
+	if ((now - sc->window_start) >= RATE_WINDOW_MS) {
+		sc->window_start = now;
+		sc->window_cnt = 0;
+	}
+
+	if (sc->window_cnt >= sc->max_rate) {
+		return false;
+	}
+
+	sc->window_cnt++;
+
+	return true;
+}
+
+static bool in_flight_add(const struct app_event_header *aeh, size_t event_idx)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+		if (!in_flight[i].aeh) {
+			in_flight[i].aeh = aeh;
+			in_flight[i].event_idx = event_idx;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool sampling_submit_check(size_t event_idx, const struct app_event_header *aeh)
+{
+	struct sampling_config *sc = &sampling[event_idx];
+	bool sampled = false;
+
+	if (!sampling_is_active(sc)) {
+		return true;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&sampling_lock);
+
+	sc->event_cnt++;
+	if (sc->event_cnt >= sc->sample_every) {
+		sc->event_cnt = 0;
+		sampled = rate_limit_check(sc);
+	}
+
+	/* Remember the event to log its processing only if the submission was logged. */
+	if (sampled && IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION)) {
+		sampled = in_flight_add(aeh, event_idx);
+	}
+
+	k_spin_unlock(&sampling_lock, key);
+
+	return sampled;
+}
+
+static bool sampling_processing_check(size_t event_idx, const struct app_event_header *aeh,
+				      bool is_start)
+{
+	bool sampled = false;
+
+	if (!sampling_is_active(&sampling[event_idx])) {
+		return true;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&sampling_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+		if ((in_flight[i].aeh == aeh) && (in_flight[i].event_idx == event_idx)) {
+			if (!is_start) {
+				in_flight[i].aeh = NULL;
+			}
+			sampled = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&sampling_lock, key);
+
+	return sampled;
+}
+
+int app_event_manager_profiler_tracer_sampling_set(const char *event_name,
+						   uint16_t sample_every, uint16_t max_rate)
+{
+	STRUCT_SECTION_FOREACH(nrf_profiler_info, pi) {
+		if (strcmp(pi->name, event_name)) {
+			continue;
+		}
+
+		size_t event_idx = pi - _nrf_profiler_info_list_start;
+		struct sampling_config *sc = &sampling[event_idx];
+		k_spinlock_key_t key = k_spin_lock(&sampling_lock);
+
+		sc->sample_every = sample_every;
+		sc->max_rate = max_rate;
+		sc->event_cnt = 0;
+		sc->window_cnt = 0;
+		sc->window_start = k_uptime_get_32();
+
+		/* Forget sampled events that are in flight to make sure they are not
+		 * remembered forever if sampling of the event type is disabled.
+		 */
+		for (size_t i = 0; i < ARRAY_SIZE(in_flight); i++) {
+			if (in_flight[i].event_idx == event_idx) {
+				in_flight[i].aeh = NULL;
+			}
+		}
+
+		k_spin_unlock(&sampling_lock, key);
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+#else
+static bool sampling_submit_check(size_t event_idx, const struct app_event_header *aeh)
+{
+	return true;
+}
+
+static bool sampling_processing_check(size_t event_idx, const struct app_event_header *aeh,
+				      bool is_start)
+{
+	return true;
+}
+#endif /* CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING */
+
+/** @brief Log compact trace record.
+ *
+ * @param trace_evt_id nrf_profiler ID of the record type.
+ * @param event_id     nrf_profiler ID of the event type.
+ * @param aeh          Pointer to the application event header of the event.
+ **/
+static void trace_compact(uint16_t trace_evt_id, uint16_t event_id,
+			  const struct app_event_header *aeh)
+{
+	uint8_t data[COMPACT_DATA_LEN];
+
+	data[0] = event_id & UINT8_MAX;
+	sys_put_le32((uint32_t)(uintptr_t)aeh, &data[sizeof(uint8_t)]);
+
+	nrf_profiler_log_send_raw(trace_evt_id, data, sizeof(data));
+}
+
 /** @brief Trace event execution.
  *
  * @param aeh        Pointer to the application event header of the event that is
@@ -27,12 +231,36 @@ static uint16_t nrf_profiler_event_ids[IDS_COUNT];
 static void app_event_manager_trace_event_execution(const struct app_event_header *aeh,
 					      bool is_start)
 {
-	size_t event_cnt = _nrf_profiler_info_list_end - _nrf_profiler_info_list_start;
-	size_t event_idx = event_cnt + (is_start ? 0 : 1);
-	size_t trace_evt_id = nrf_profiler_event_ids[event_idx];
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION)) {
+		return;
+	}
+
+	const struct nrf_profiler_info *nrf_profiler_info = aeh->type_id->trace_data;
+	uint16_t trace_evt_id = trace_id_get(is_start ? TRACE_ID_PROCESSING_START :
+							TRACE_ID_PROCESSING_END);
+
+	if (nrf_profiler_info) {
+		size_t event_idx = nrf_profiler_info - _nrf_profiler_info_list_start;
+
+		/* Always check sampling first to forget the event when its processing ends. */
+		if (!sampling_processing_check(event_idx, aeh, is_start)) {
+			return;
+		}
+
+		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT)) {
+			uint16_t event_id = nrf_profiler_event_ids[event_idx];
+
+			if (is_profiling_enabled(trace_evt_id) && is_profiling_enabled(event_id)) {
+				trace_compact(trace_evt_id, event_id, aeh);
+			}
+			return;
+		}
+	} else if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT)) {
+		/* Compact records can only refer to profiled event types. */
+		return;
+	}
 
-	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION) ||
-	    !is_profiling_enabled(trace_evt_id)) {
+	if (!is_profiling_enabled(trace_evt_id)) {
 		return;
 	}
 
@@ -79,6 +307,19 @@ static void app_event_manager_trace_event_submission(const struct app_event_head
 		return;
 	}
 
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT)) {
+		uint16_t compact_id = trace_id_get(TRACE_ID_COMPACT_SUBMIT);
+
+		if (is_profiling_enabled(compact_id) && sampling_submit_check(event_idx, aeh)) {
+			trace_compact(compact_id, trace_evt_id, aeh);
+		}
+		return;
+	}
+
+	if (!sampling_submit_check(event_idx, aeh)) {
+		return;
+	}
+
 	struct log_event_buf buf;
 
 	ARG_UNUSED(buf);
@@ -111,13 +352,35 @@ static void trace_register_execution_tracking_events(void)
 	nrf_profiler_event_id = nrf_profiler_register_event_type(
 				"event_processing_start",
 				labels, types, 1);
-	nrf_profiler_event_ids[event_cnt] = nrf_profiler_event_id;
+	nrf_profiler_event_ids[event_cnt + TRACE_ID_PROCESSING_START] = nrf_profiler_event_id;
 
 	/* Event execution end event. */
 	nrf_profiler_event_id = nrf_profiler_register_event_type(
 				"event_processing_end",
 				labels, types, 1);
-	nrf_profiler_event_ids[event_cnt + 1] = nrf_profiler_event_id;
+	nrf_profiler_event_ids[event_cnt + TRACE_ID_PROCESSING_END] = nrf_profiler_event_id;
+}
+
+static void trace_register_compact_events(void)
+{
+	static const char * const labels[] = {"event_id", "mem_address"};
+	static const enum nrf_profiler_arg types[] = {NRF_PROFILER_ARG_U8, NRF_PROFILER_ARG_U32};
+	size_t event_cnt = _nrf_profiler_info_list_end - _nrf_profiler_info_list_start;
+
+	BUILD_ASSERT(ARRAY_SIZE(labels) == ARRAY_SIZE(types));
+
+	nrf_profiler_event_ids[event_cnt + TRACE_ID_COMPACT_SUBMIT] =
+		nrf_profiler_register_event_type("event_submit_compact", labels, types,
+						 ARRAY_SIZE(types));
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION)) {
+		nrf_profiler_event_ids[event_cnt + TRACE_ID_PROCESSING_START] =
+			nrf_profiler_register_event_type("event_processing_start_compact",
+							 labels, types, ARRAY_SIZE(types));
+		nrf_profiler_event_ids[event_cnt + TRACE_ID_PROCESSING_END] =
+			nrf_profiler_register_event_type("event_processing_end_compact",
+							 labels, types, ARRAY_SIZE(types));
+	}
 }
 
 static void trace_register_events(void)
@@ -134,7 +397,12 @@ static void trace_register_events(void)
 		nrf_profiler_event_ids[event_idx] = nrf_profiler_event_id;
 	}
 
-	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION)) {
+	/* Event types are registered also for compact records, so that the host can map
+	 * the nrf_profiler ID stored in a record to the event name.
+	 */
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT)) {
+		trace_register_compact_events();
+	} else if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_TRACE_EVENT_EXECUTION)) {
 		trace_register_execution_tracking_events();
 	}
 }
@@ -148,9 +416,11 @@ static int app_event_manager_trace_event_init(void)
 {
 	/* Every profiled Application Event Manager event registers a single nrf_profiler event.
 	 * Apart from that 2 additional nrf_profiler events are used to indicate processing
-	 * start and end of an Application Event Manager event.
+	 * start and end of an Application Event Manager event. Compact records use one more
+	 * nrf_profiler event to indicate event submission.
 	 */
-	__ASSERT_NO_MSG(_nrf_profiler_info_list_end - _nrf_profiler_info_list_start + 2 <=
+	__ASSERT_NO_MSG(_nrf_profiler_info_list_end - _nrf_profiler_info_list_start +
+			(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_COMPACT) ? 3 : 2) <=
 			CONFIG_NRF_PROFILER_MAX_NUMBER_OF_APP_EVENTS);
 
 	if (nrf_profiler_init()) {
@@ -163,3 +433,66 @@ static int app_event_manager_trace_event_init(void)
 }
 
 APP_EVENT_MANAGER_HOOK_POSTINIT_REGISTER(app_event_manager_trace_event_init);
+
+#ifdef CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING_SHELL
+static int parse_u16(const struct shell *shell, const char *str, uint16_t *value)
+{
+	char *end;
+	unsigned long val = strtoul(str, &end, 10);
+
+	if ((*end != '\0') || (val > UINT16_MAX)) {
+		shell_error(shell, "Invalid value: %s", str);
+		return -EINVAL;
+	}
+
+	*value = val;
+
+	return 0;
+}
+
+static int cmd_sampling_set(const struct shell *shell, size_t argc, char **argv)
+{
+	uint16_t sample_every;
+	uint16_t max_rate;
+	int err;
+
+	err = parse_u16(shell, argv[2], &sample_every);
+	if (!err) {
+		err = parse_u16(shell, argv[3], &max_rate);
+	}
+	if (err) {
+		return err;
+	}
+
+	err = app_event_manager_profiler_tracer_sampling_set(argv[1], sample_every, max_rate);
+	if (err) {
+		shell_error(shell, "Event type is not profiled: %s", argv[1]);
+	}
+
+	return err;
+}
+
+static int cmd_sampling_show(const struct shell *shell, size_t argc, char **argv)
+{
+	STRUCT_SECTION_FOREACH(nrf_profiler_info, pi) {
+		const struct sampling_config *sc = &sampling[pi - _nrf_profiler_info_list_start];
+
+		shell_print(shell, "%s: every %u event(s), max %u event(s)/s", pi->name,
+			    MAX(sc->sample_every, 1), sc->max_rate);
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_aem_tracer_sampling,
+	SHELL_CMD_ARG(set, NULL,
+		      "Profile every N-th event with a rate limit (0 - no limit) per second: "
+		      "<event name> <N> <max_rate>",
+		      cmd_sampling_set, 4, 0),
+	SHELL_CMD_ARG(show, NULL, "Show sampling configuration",
+		      cmd_sampling_show, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_REGISTER(aem_tracer_sampling, &sub_aem_tracer_sampling,
+		   "Application Event Manager profiler tracer sampling commands", NULL);
+#endif /* CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING_SHELL */
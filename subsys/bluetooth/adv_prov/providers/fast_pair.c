@@ -109,6 +109,7 @@ static int get_data(struct bt_data *ad, const struct bt_le_adv_prov_adv_state *s
 					   BT_FAST_PAIR_NOT_DISC_ADV_TYPE_SHOW_UI_IND :
 					   BT_FAST_PAIR_NOT_DISC_ADV_TYPE_HIDE_UI_IND;
 		adv_config.not_disc.battery_mode = adv_battery_mode;
+		adv_config.not_disc.keep_salt = !state->rpa_rotated && !state->new_adv_session;
 	}
 
 	if (IS_ENABLED(CONFIG_BT_ADV_PROV_FAST_PAIR_STOP_DISCOVERABLE_ON_RPA_ROTATION)) {
@@ -11,8 +11,8 @@
 
 #include <zephyr/bluetooth/hci_types.h>
 #include <zephyr/logging/log.h>
-#include <dsp/transform_functions.h>
 #include <dsp/fast_math_functions.h>
+#include <dsp/transform_functions.h>
 #include <dsp/statistics_functions.h>
 #include <arm_const_structs.h>
 #include <bluetooth/cs_de.h>
@@ -32,7 +32,15 @@ LOG_MODULE_REGISTER(cs_de, CONFIG_BT_CS_DE_LOG_LEVEL);
 #define NORMAL_PEAK_TO_NULL                                                                        \
 	((CONFIG_BT_CS_DE_NFFT_SIZE + CS_DE_NUM_CHANNELS - 1) / (CS_DE_NUM_CHANNELS))
 
-static float m_iq_scratch_mem[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+/* The peak search works on the squared IFFT magnitude, so magnitude ratios used by its
+ * heuristics are squared as well.
+ */
+#define SQUARED(x) ((x) * (x))
+
+/* Workspace used by cs_de_calc(). */
+static cs_de_workspace_t m_workspace;
+
+static float ifft_estimate(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE]);
 
 static cs_de_quality_t set_best_estimate(cs_de_dist_estimates_t *p_estimates_public)
 {
@@ -67,8 +75,15 @@ void cs_de_combined_iq_calculate(cs_de_iq_tones_t *cs_de_iq_tones,
 }
 
 cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
+{
+	return cs_de_calc_with_workspace(p_report, &m_workspace);
+}
+
+cs_de_quality_t cs_de_calc_with_workspace(cs_de_report_t *p_report,
+					  cs_de_workspace_t *p_workspace)
 {
 	cs_de_quality_t estimation_quality = CS_DE_QUALITY_DO_NOT_USE;
+	float *iq_scratch_mem = p_workspace->iq_scratch_mem;
 
 	float rtt_distance_m = cs_de_rtt(p_report->rtt_accumulated_half_ns, p_report->rtt_count);
 
@@ -83,14 +98,17 @@ cs_de_quality_t cs_de_calc(cs_de_report_t *p_report)
 			continue;
 		}
 
-		memset(m_iq_scratch_mem, 0, sizeof(m_iq_scratch_mem));
-
-		/* Combine init and refl IQ values and store in scratch mem. */
-		cs_de_combined_iq_calculate(&p_report->iq_tones[ap], m_iq_scratch_mem);
+		/* Combine init and refl IQ values and store in scratch mem. Only the zero padding
+		 * needs clearing, the tones are overwritten.
+		 */
+		cs_de_combined_iq_calculate(&p_report->iq_tones[ap], iq_scratch_mem);
+		memset(&iq_scratch_mem[2 * CS_DE_NUM_CHANNELS], 0,
+		       sizeof(p_workspace->iq_scratch_mem) -
+			       2 * CS_DE_NUM_CHANNELS * sizeof(iq_scratch_mem[0]));
 
-		p_report->distance_estimates[ap].phase_slope = cs_de_phase_slope(m_iq_scratch_mem);
+		p_report->distance_estimates[ap].phase_slope = cs_de_phase_slope(iq_scratch_mem);
 
-		p_report->distance_estimates[ap].ifft = cs_de_ifft(m_iq_scratch_mem);
+		p_report->distance_estimates[ap].ifft = ifft_estimate(iq_scratch_mem);
 
 		if (set_best_estimate(&p_report->distance_estimates[ap]) == CS_DE_QUALITY_OK) {
 			estimation_quality = CS_DE_QUALITY_OK;
@@ -136,18 +154,21 @@ float cs_de_phase_slope(float iq_tones_comb[CS_DE_NUM_CHANNELS * 2])
 }
 
 static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
-						   const float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+						   const float ifft_mag_sq[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
-	/* Peak interpolation */
-	float prompt = ifft_mag[peak_index];
+	/* Peak interpolation. It is done on the magnitude, which is only needed at the
+	 * three points around the peak.
+	 */
+	float prompt = sqrtf(ifft_mag_sq[peak_index]);
 
 	/* Find early and late magnitudes, if peak_index is at either first or last point in the
 	 * IFFT, wrap around since the IFFT is periodic.
 	 */
-	float early = (peak_index != 0) ? ifft_mag[peak_index - 1]
-					: ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE - 1];
-	float late = (peak_index != (CONFIG_BT_CS_DE_NFFT_SIZE - 1)) ? ifft_mag[peak_index + 1]
-								     : ifft_mag[0];
+	float early = sqrtf((peak_index != 0) ? ifft_mag_sq[peak_index - 1]
+					      : ifft_mag_sq[CONFIG_BT_CS_DE_NFFT_SIZE - 1]);
+	float late = sqrtf((peak_index != (CONFIG_BT_CS_DE_NFFT_SIZE - 1))
+				   ? ifft_mag_sq[peak_index + 1]
+				   : ifft_mag_sq[0]);
 	/* Avoid interpolation of early, prompt and late if left null compensation has taken place.
 	 */
 	float t_hat = (prompt >= early && prompt >= late)
@@ -164,7 +185,7 @@ static float calculate_ifft_peak_index_to_distance(int32_t peak_index,
 }
 
 static int32_t calculate_ifft_find_left_null(int32_t peak_index,
-					     float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+					     float ifft_mag_sq[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	int32_t left_null_index = peak_index;
 	bool found_left_null = false;
@@ -173,9 +194,10 @@ static int32_t calculate_ifft_find_left_null(int32_t peak_index,
 		int32_t next_left_null_index =
 			left_null_index == 0 ? CONFIG_BT_CS_DE_NFFT_SIZE - 1 : left_null_index - 1;
 		/* This is a heuristic, probably non-optimal definition of a null. */
-		if ((ifft_mag[left_null_index] * 2 > ifft_mag[peak_index] ||
-		     ifft_mag[left_null_index] > 1.10f * ifft_mag[next_left_null_index]) &&
-		    ifft_mag[left_null_index] * 10 > ifft_mag[peak_index] &&
+		if ((ifft_mag_sq[left_null_index] * SQUARED(2.0f) > ifft_mag_sq[peak_index] ||
+		     ifft_mag_sq[left_null_index] >
+			     SQUARED(1.10f) * ifft_mag_sq[next_left_null_index]) &&
+		    ifft_mag_sq[left_null_index] * SQUARED(10.0f) > ifft_mag_sq[peak_index] &&
 		    next_left_null_index != peak_index) {
 			left_null_index = next_left_null_index--;
 		} else {
@@ -193,10 +215,10 @@ static uint32_t calculate_distance_to_left_null(uint32_t peak_index, uint32_t le
 }
 
 static int32_t calculate_left_null_compensation_of_peak(int32_t peak_index,
-							float ifft_mag[CONFIG_BT_CS_DE_NFFT_SIZE])
+							float ifft_mag_sq[CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	int32_t compensated_peak_index = peak_index;
-	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_mag);
+	int32_t left_null_index = calculate_ifft_find_left_null(peak_index, ifft_mag_sq);
 	uint32_t peak_to_null_distance =
 		calculate_distance_to_left_null(peak_index, left_null_index);
 	if (peak_to_null_distance > NORMAL_PEAK_TO_NULL) {
@@ -213,9 +235,9 @@ static int32_t calculate_left_null_compensation_of_peak(int32_t peak_index,
 	return compensated_peak_index;
 }
 
-static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static void calculate_ifft_mag_sq(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
-	/* This function calculates the magnitude of the IFFT of the input IQ values.
+	/* This function calculates the squared magnitude of the IFFT of the input IQ values.
 	 * Note that the result is written back to the input array.
 	 * Also note that the input array is a complex array of size CONFIG_BT_CS_DE_NFFT_SIZE
 	 * Odd indexes contain the real part and even indexes contain the imaginary part.
@@ -227,6 +249,9 @@ static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE
 	 *  3. Complex conjugate the output.
 	 * Since we are interested in the magnitude of the IFFT, we can skip step 3.
 	 * and directly calculate the magnitude of the output of step 2.
+	 *
+	 * The peak search only compares magnitudes, so the squared magnitude is used and
+	 * no square root or 1/CONFIG_BT_CS_DE_NFFT_SIZE scaling is done per bin.
 	 */
 
 	/* Complex conjugate the input. */
@@ -245,20 +270,19 @@ static void calculate_ifft_mag(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE
 	#error
 	#endif
 
-	/* Compute the magnitude of complex values in
-	 * iq_tones_comb[0:2*CONFIG_BT_CS_DE_NFFT_SIZE - 1]
-	 * and scale by 1/CONFIG_BT_CS_DE_NFFT_SIZE.
+	/* Compute the squared magnitude of complex values in
+	 * iq_tones_comb[0:2*CONFIG_BT_CS_DE_NFFT_SIZE - 1].
 	 * Store output in iq_tones_comb[0:CONFIG_BT_CS_DE_NFFT_SIZE - 1]
 	 */
 	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
-		float realIn = iq_tones_comb[2 * n] / CONFIG_BT_CS_DE_NFFT_SIZE;
-		float imagIn = iq_tones_comb[(2 * n) + 1] / CONFIG_BT_CS_DE_NFFT_SIZE;
+		float realIn = iq_tones_comb[2 * n];
+		float imagIn = iq_tones_comb[(2 * n) + 1];
 
-		arm_sqrt_f32((realIn * realIn) + (imagIn * imagIn), &iq_tones_comb[n]);
+		iq_tones_comb[n] = (realIn * realIn) + (imagIn * imagIn);
 	}
 }
 
-static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static uint32_t find_ifft_peak_index(float ifft_mag_sq[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	/* This function tries to find the peak index of the input IFFT magnitude.
 	 *
@@ -269,9 +293,9 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 	 *  3. When applicable: Compensate peak based on left null location.
 	 */
 	uint32_t ifft_mag_max_index;
-	float ifft_mag_max;
+	float ifft_mag_sq_max;
 
-	arm_max_f32(ifft_mag, CONFIG_BT_CS_DE_NFFT_SIZE, &ifft_mag_max, &ifft_mag_max_index);
+	arm_max_f32(ifft_mag_sq, CONFIG_BT_CS_DE_NFFT_SIZE, &ifft_mag_sq_max, &ifft_mag_max_index);
 
 	/* Search for strong peaks closer than the max value. */
 	uint32_t nw = CONFIG_BT_CS_DE_NFFT_SIZE - 2;
@@ -282,9 +306,9 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 	uint32_t shortest_path_idx = ifft_mag_max_index;
 
 	while (nw != max_search_index && !short_path_found) {
-		if (ifft_mag[nw_next] < ifft_mag[nw]) {
+		if (ifft_mag_sq[nw_next] < ifft_mag_sq[nw]) {
 			/* Peak found */
-			if (2.5f * ifft_mag[nw] > ifft_mag_max && first_rise_found) {
+			if (SQUARED(2.5f) * ifft_mag_sq[nw] > ifft_mag_sq_max && first_rise_found) {
 				/* New peak found */
 				shortest_path_idx = nw;
 				short_path_found = true;
@@ -300,29 +324,44 @@ static uint32_t find_ifft_peak_index(float ifft_mag[2 * CONFIG_BT_CS_DE_NFFT_SIZ
 
 	if (compensated_peak_index < CONFIG_BT_CS_DE_NFFT_SIZE - 2) {
 		compensated_peak_index =
-			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_mag);
+			calculate_left_null_compensation_of_peak(shortest_path_idx, ifft_mag_sq);
 	}
 
 	return compensated_peak_index;
 }
 
-float cs_de_ifft(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+static float ifft_estimate(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
 {
 	/* This function calculates a distance estimate
 	 * based on the IFFT magnitude of the input IQ values
 	 *
 	 * To do this the function uses the following steps:
-	 *  1. Calculate the IFFT magnitude of the input IQ values.
+	 *  1. Calculate the squared IFFT magnitude of the input IQ values.
 	 *  2. Find index of the peak in the IFFT magnitude which is believed
 	 *     to correspond to the path with the shortest propagattion time.
 	 *  3. Convert the peak index to a distance estimate.
 	 */
-	calculate_ifft_mag(iq_tones_comb);
+	calculate_ifft_mag_sq(iq_tones_comb);
+
+	/* The input IQ values are overwritten with the squared IFFT magnitude. */
+	float *ifft_mag_sq = iq_tones_comb;
+
+	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_mag_sq);
 
-	/* The input IQ values are overwritten with the IFFT magnitude. */
-	float *ifft_mag = iq_tones_comb;
+	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_mag_sq);
+}
 
-	uint32_t ifft_peak_index = find_ifft_peak_index(ifft_mag);
+float cs_de_ifft(float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE])
+{
+	float distance = ifft_estimate(iq_tones_comb);
 
-	return calculate_ifft_peak_index_to_distance(ifft_peak_index, ifft_mag);
+	/* Callers of this function get the IFFT magnitude scaled by 1/CONFIG_BT_CS_DE_NFFT_SIZE.
+	 * The estimation itself does not need it.
+	 */
+	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
+		arm_sqrt_f32(iq_tones_comb[n], &iq_tones_comb[n]);
+		iq_tones_comb[n] /= CONFIG_BT_CS_DE_NFFT_SIZE;
+	}
+
+	return distance;
 }
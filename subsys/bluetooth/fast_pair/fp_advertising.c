@@ -14,6 +14,7 @@ LOG_MODULE_DECLARE(fast_pair, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 
 #include <bluetooth/fast_pair/fast_pair.h>
 #include <bluetooth/fast_pair/uuid.h>
+#include "fp_advertising.h"
 #include "fp_battery.h"
 #include "fp_common.h"
 #include "fp_crypto.h"
@@ -42,6 +43,11 @@ static const uint16_t fast_pair_uuid = BT_FAST_PAIR_UUID_FPS_VAL;
 static const uint8_t version_and_flags;
 static const uint8_t empty_account_key_list;
 
+static uint16_t adv_salt;
+static bool adv_salt_valid;
+
+FP_CRYPTO_ACCOUNT_KEY_FILTER_CTX_DEFINE(ak_filter_ctx, CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX);
+
 static int check_adv_config(struct bt_fast_pair_adv_config fp_adv_config)
 {
 	if ((fp_adv_config.mode >= BT_FAST_PAIR_ADV_MODE_COUNT) || (fp_adv_config.mode < 0)) {
@@ -179,9 +185,28 @@ static void fp_adv_data_fill_battery_info(uint8_t *battery_info,
 	}
 }
 
+static int fp_adv_salt_get(uint16_t *salt, bool keep_salt)
+{
+	if (!keep_salt || !adv_salt_valid) {
+		int err = sys_csrand_get(&adv_salt, sizeof(adv_salt));
+
+		if (err) {
+			adv_salt_valid = false;
+			return err;
+		}
+
+		adv_salt_valid = true;
+	}
+
+	*salt = adv_salt;
+
+	return 0;
+}
+
 static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t account_key_cnt,
 					     enum fp_field_type ak_filter_type,
-					     enum bt_fast_pair_adv_battery_mode adv_battery_mode)
+					     enum bt_fast_pair_adv_battery_mode adv_battery_mode,
+					     bool keep_salt)
 {
 	uint8_t battery_info[FP_CRYPTO_BATTERY_INFO_LEN];
 	bool add_battery_info = ((adv_battery_mode != BT_FAST_PAIR_ADV_BATTERY_MODE_NONE) &&
@@ -202,6 +227,9 @@ static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t
 	}
 
 	if (account_key_cnt == 0) {
+		/* Do not keep hashes of removed Account Keys. */
+		fp_crypto_account_key_filter_ctx_reset(&ak_filter_ctx);
+
 		net_buf_simple_add_u8(buf, empty_account_key_list);
 	} else {
 		struct fp_account_key ak[CONFIG_BT_FAST_PAIR_STORAGE_ACCOUNT_KEY_MAX];
@@ -210,7 +238,7 @@ static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t
 		uint16_t salt;
 		int err;
 
-		err = sys_csrand_get(&salt, sizeof(salt));
+		err = fp_adv_salt_get(&salt, keep_salt);
 		if (err) {
 			return err;
 		}
@@ -229,9 +257,10 @@ static int fp_adv_data_fill_non_discoverable(struct net_buf_simple *buf, size_t
 		__ASSERT_NO_MSG(ak_filter_size <= BIT_MASK(LEN_BITS));
 		net_buf_simple_add_u8(buf, ENCODE_FIELD_LEN_TYPE(ak_filter_size, ak_filter_type));
 
-		err = fp_crypto_account_key_filter(net_buf_simple_add(buf, ak_filter_size), ak,
-						   account_key_cnt, salt,
-						   add_battery_info ? battery_info : NULL);
+		err = fp_crypto_account_key_filter_cached(&ak_filter_ctx,
+							  net_buf_simple_add(buf, ak_filter_size),
+							  ak, account_key_cnt, salt,
+							  add_battery_info ? battery_info : NULL);
 		if (err) {
 			return err;
 		}
@@ -253,6 +282,11 @@ static int fp_adv_data_fill_discoverable(struct net_buf_simple *buf)
 					FP_REG_DATA_MODEL_ID_LEN);
 }
 
+void fp_advertising_account_key_filter_cache_clear(void)
+{
+	fp_crypto_account_key_filter_ctx_reset(&ak_filter_ctx);
+}
+
 int bt_fast_pair_adv_data_fill(struct bt_data *bt_adv_data, uint8_t *buf, size_t buf_size,
 			       struct bt_fast_pair_adv_config fp_adv_config)
 {
@@ -304,7 +338,8 @@ int bt_fast_pair_adv_data_fill(struct bt_data *bt_adv_data, uint8_t *buf, size_t
 			ak_filter_type = FP_FIELD_TYPE_HIDE_PAIRING_UI_INDICATION;
 		}
 		err = fp_adv_data_fill_non_discoverable(&nb, account_key_cnt, ak_filter_type,
-							fp_adv_config.not_disc.battery_mode);
+							fp_adv_config.not_disc.battery_mode,
+							fp_adv_config.not_disc.keep_salt);
 	}
 
 	if (!err) {
@@ -93,42 +93,145 @@ size_t fp_crypto_account_key_filter_size(size_t n)
 	}
 }
 
+static int account_key_hash(uint8_t *out, const struct fp_account_key *account_key,
+			    uint16_t salt, const uint8_t *battery_info)
+{
+	uint8_t v[FP_ACCOUNT_KEY_LEN + sizeof(salt) + FP_CRYPTO_BATTERY_INFO_LEN];
+	size_t pos = 0;
+
+	memcpy(v, account_key->key, FP_ACCOUNT_KEY_LEN);
+	pos += FP_ACCOUNT_KEY_LEN;
+
+	sys_put_be16(salt, &v[pos]);
+	pos += sizeof(salt);
+
+	if (battery_info) {
+		memcpy(&v[pos], battery_info, FP_CRYPTO_BATTERY_INFO_LEN);
+		pos += FP_CRYPTO_BATTERY_INFO_LEN;
+	}
+
+	return fp_crypto_sha256(out, v, pos);
+}
+
+static void account_key_filter_add(uint8_t *out, size_t s, const uint8_t *h)
+{
+	uint32_t x;
+	uint32_t m;
+
+	for (size_t j = 0; j < FP_CRYPTO_SHA256_HASH_LEN / sizeof(x); j++) {
+		x = sys_get_be32(&h[j * sizeof(x)]);
+		m = x % (s * __CHAR_BIT__);
+		WRITE_BIT(out[m / __CHAR_BIT__], m % __CHAR_BIT__, 1);
+	}
+}
+
 int fp_crypto_account_key_filter(uint8_t *out, const struct fp_account_key *account_key_list,
 				 size_t n, uint16_t salt, const uint8_t *battery_info)
 {
 	size_t s = fp_crypto_account_key_filter_size(n);
-	uint8_t v[FP_ACCOUNT_KEY_LEN + sizeof(salt) + FP_CRYPTO_BATTERY_INFO_LEN];
 	uint8_t h[FP_CRYPTO_SHA256_HASH_LEN];
-	uint32_t x;
-	uint32_t m;
 	int err;
 
 	memset(out, 0, s);
 	for (size_t i = 0; i < n; i++) {
-		size_t pos = 0;
+		err = account_key_hash(h, &account_key_list[i], salt, battery_info);
+		if (err) {
+			return err;
+		}
+
+		account_key_filter_add(out, s, h);
+	}
+	return 0;
+}
 
-		memcpy(v, account_key_list[i].key, FP_ACCOUNT_KEY_LEN);
-		pos += FP_ACCOUNT_KEY_LEN;
+void fp_crypto_account_key_filter_ctx_reset(struct fp_crypto_account_key_filter_ctx *ctx)
+{
+	memset(ctx->entries, 0, ctx->entry_max * sizeof(ctx->entries[0]));
+	ctx->entry_cnt = 0;
+}
 
-		sys_put_be16(salt, &v[pos]);
-		pos += sizeof(salt);
+static bool account_key_filter_ctx_inputs_equal(const struct fp_crypto_account_key_filter_ctx *ctx,
+						uint16_t salt, const uint8_t *battery_info)
+{
+	if ((ctx->salt != salt) || (ctx->has_battery_info != (battery_info != NULL))) {
+		return false;
+	}
 
-		if (battery_info) {
-			memcpy(&v[pos], battery_info, FP_CRYPTO_BATTERY_INFO_LEN);
-			pos += FP_CRYPTO_BATTERY_INFO_LEN;
+	return !battery_info ||
+	       !memcmp(ctx->battery_info, battery_info, FP_CRYPTO_BATTERY_INFO_LEN);
+}
+
+static size_t account_key_filter_entry_find(const struct fp_crypto_account_key_filter_ctx *ctx,
+					    size_t start, const struct fp_account_key *account_key)
+{
+	for (size_t i = start; i < ctx->entry_cnt; i++) {
+		if (!memcmp(&ctx->entries[i].account_key, account_key, sizeof(*account_key))) {
+			return i;
 		}
+	}
 
-		err = fp_crypto_sha256(h, v, pos);
-		if (err) {
-			return err;
+	return SIZE_MAX;
+}
+
+int fp_crypto_account_key_filter_cached(struct fp_crypto_account_key_filter_ctx *ctx,
+					uint8_t *out,
+					const struct fp_account_key *account_key_list,
+					size_t n, uint16_t salt, const uint8_t *battery_info)
+{
+	struct fp_crypto_account_key_filter_entry *entries = ctx->entries;
+	size_t s = fp_crypto_account_key_filter_size(n);
+	int err;
+
+	if (n > ctx->entry_max) {
+		return fp_crypto_account_key_filter(out, account_key_list, n, salt, battery_info);
+	}
+
+	if (!account_key_filter_ctx_inputs_equal(ctx, salt, battery_info)) {
+		ctx->entry_cnt = 0;
+		ctx->salt = salt;
+		ctx->has_battery_info = (battery_info != NULL);
+		if (battery_info) {
+			memcpy(ctx->battery_info, battery_info, FP_CRYPTO_BATTERY_INFO_LEN);
 		}
+	}
 
-		for (size_t j = 0; j < FP_CRYPTO_SHA256_HASH_LEN / sizeof(x); j++) {
-			x = sys_get_be32(&h[j * sizeof(x)]);
-			m = x % (s * __CHAR_BIT__);
-			WRITE_BIT(out[m / __CHAR_BIT__], m % __CHAR_BIT__, 1);
+	/* Entries are reordered to match the Account Key list order. Entries past the list
+	 * length are kept, as they stay valid until the Salt or the battery info changes.
+	 */
+	memset(out, 0, s);
+	for (size_t i = 0; i < n; i++) {
+		size_t found = account_key_filter_entry_find(ctx, i, &account_key_list[i]);
+
+		if (found != SIZE_MAX) {
+			if (found != i) {
+				struct fp_crypto_account_key_filter_entry tmp = entries[i];
+
+				entries[i] = entries[found];
+				entries[found] = tmp;
+			}
+		} else {
+			if (i < ctx->entry_cnt) {
+				/* A later Account Key may still match the entry. */
+				if (ctx->entry_cnt < ctx->entry_max) {
+					entries[ctx->entry_cnt] = entries[i];
+					ctx->entry_cnt++;
+				}
+			} else {
+				ctx->entry_cnt = i + 1;
+			}
+
+			entries[i].account_key = account_key_list[i];
+			err = account_key_hash(entries[i].hash, &account_key_list[i], salt,
+					       battery_info);
+			if (err) {
+				fp_crypto_account_key_filter_ctx_reset(ctx);
+				return err;
+			}
 		}
+
+		account_key_filter_add(out, s, entries[i].hash);
 	}
+
 	return 0;
 }
 
@@ -7,7 +7,9 @@
 #ifndef _FP_CRYPTO_H_
 #define _FP_CRYPTO_H_
 
+#include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/toolchain.h>
 
 #include "fp_common.h"
 
@@ -232,6 +234,83 @@ size_t fp_crypto_account_key_filter_size(size_t n);
 int fp_crypto_account_key_filter(uint8_t *out, const struct fp_account_key *account_key_list,
 				 size_t n, uint16_t salt, const uint8_t *battery_info);
 
+/** Account Key hash cached by the Account Key Filter context. */
+struct fp_crypto_account_key_filter_entry {
+	/** Account Key. */
+	struct fp_account_key account_key;
+
+	/** Hash of the Account Key concatenated with the Salt and the battery info. */
+	uint8_t hash[FP_CRYPTO_SHA256_HASH_LEN];
+};
+
+/** Account Key Filter context.
+ *
+ * The context caches the hashes of the Account Keys for the Salt and the battery info used in the
+ * last computation. The structure must be defined using
+ * @ref FP_CRYPTO_ACCOUNT_KEY_FILTER_CTX_DEFINE.
+ */
+struct fp_crypto_account_key_filter_ctx {
+	/** Array of cached entries. */
+	struct fp_crypto_account_key_filter_entry *entries;
+
+	/** Size of the array of cached entries. */
+	size_t entry_max;
+
+	/** Number of valid cached entries. */
+	size_t entry_cnt;
+
+	/** Salt used to compute the cached hashes. */
+	uint16_t salt;
+
+	/** True if the cached hashes include the battery info. */
+	bool has_battery_info;
+
+	/** Battery info used to compute the cached hashes. */
+	uint8_t battery_info[FP_CRYPTO_BATTERY_INFO_LEN];
+};
+
+/** Define an Account Key Filter context.
+ *
+ * @param _name Name of the context.
+ * @param _entry_max Maximum number of cached Account Key hashes.
+ */
+#define FP_CRYPTO_ACCOUNT_KEY_FILTER_CTX_DEFINE(_name, _entry_max)			\
+	static struct fp_crypto_account_key_filter_entry _CONCAT(_name, _entries)[_entry_max];	\
+	static struct fp_crypto_account_key_filter_ctx _name = {			\
+		.entries = _CONCAT(_name, _entries),					\
+		.entry_max = (_entry_max),						\
+	}
+
+/** Compute an Account Key Filter using the cached Account Key hashes.
+ *
+ * Works like @ref fp_crypto_account_key_filter, but the hashes of the Account Keys are cached in
+ * the context. An Account Key is hashed only if it has no cached hash for the given Salt and
+ * battery info. All cached hashes are dropped if the Salt or the battery info changes.
+ *
+ * If the number of Account Keys is larger than the context capacity, the filter is computed
+ * without the cache.
+ *
+ * @param[in,out] ctx Account Key Filter context.
+ * @param[out] out Buffer to receive Account Key Filter. Buffer size must be at least
+ *                 @ref fp_crypto_account_key_filter_size.
+ * @param[in] account_key_list Pointer to array of Account Keys.
+ * @param[in] n Number of account keys (n >= 1).
+ * @param[in] salt Random 2-byte value - Salt.
+ * @param[in] battery_info Battery info or NULL if there is no battery info.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error code is returned.
+ */
+int fp_crypto_account_key_filter_cached(struct fp_crypto_account_key_filter_ctx *ctx,
+					uint8_t *out,
+					const struct fp_account_key *account_key_list,
+					size_t n, uint16_t salt, const uint8_t *battery_info);
+
+/** Drop all Account Key hashes cached in the Account Key Filter context.
+ *
+ * @param[in,out] ctx Account Key Filter context.
+ */
+void fp_crypto_account_key_filter_ctx_reset(struct fp_crypto_account_key_filter_ctx *ctx);
+
 /** Encode data to Additional Data packet.
  *
  * @param[out] out_packet Buffer to receive Additional Data packet. Buffer size must be at least
@@ -12,6 +12,7 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(fast_pair, CONFIG_BT_FAST_PAIR_LOG_LEVEL);
 
+#include "fp_advertising.h"
 #include "fp_storage.h"
 #include "fp_activation.h"
 #include "fp_storage_ak.h"
@@ -28,6 +29,11 @@ int bt_fast_pair_factory_reset(void)
 		return -EOPNOTSUPP;
 	}
 
+	/* Drop the cached Account Key copies even if the storage reset fails. */
+	if (IS_ENABLED(CONFIG_BT_FAST_PAIR_ADVERTISING)) {
+		fp_advertising_account_key_filter_cache_clear();
+	}
+
 	err = fp_storage_factory_reset();
 	if (err) {
 		return err;
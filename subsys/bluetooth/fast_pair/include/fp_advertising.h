@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _FP_ADVERTISING_H_
+#define _FP_ADVERTISING_H_
+
+/**
+ * @defgroup fp_advertising Fast Pair advertising
+ * @brief Internal API for Fast Pair advertising data implementation
+ *
+ * Fast Pair advertising module generates the Fast Pair advertising data. The module caches
+ * Account Key hashes used to build the Account Key Filter.
+ *
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Drop the cached Account Keys and their hashes used to build the Account Key Filter.
+ *
+ * The function must be called when the stored Account Keys are removed.
+ */
+void fp_advertising_account_key_filter_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _FP_ADVERTISING_H_ */
@@ -6,7 +6,11 @@
 
 #include <inttypes.h>
 #include <zephyr/kernel.h>
+#include <zephyr/init.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/settings/settings.h>
 
 #include <bluetooth/gatt_dm.h>
 
@@ -55,6 +59,49 @@ struct data_chunk_item {
 	uint8_t data[CHUNK_DATA_SIZE];
 };
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+/* Settings subtree holding cached discovery results */
+#define CACHE_SETTINGS_ROOT "bt_dm"
+/* "bt_dm/<addr><type><id>/<uuid>" */
+#define CACHE_KEY_LEN (sizeof(CACHE_SETTINGS_ROOT "/") + 2 * BT_ADDR_SIZE + 6 + \
+		       BT_UUID_STR_LEN)
+#define CACHE_VERSION 2
+#define DB_HASH_LEN 16
+
+/* UUID storage of any supported type */
+union cache_uuid {
+	struct bt_uuid uuid;
+	struct bt_uuid_16 u16;
+	struct bt_uuid_32 u32;
+	struct bt_uuid_128 u128;
+};
+
+/* One cached attribute. For a service attribute val_handle is the end
+ * handle and val_uuid the service UUID; for a characteristic attribute
+ * they hold the value handle and the characteristic UUID. The structure
+ * is not packed, so that the UUIDs can be accessed in place.
+ */
+struct cache_attr {
+	uint16_t handle;
+	uint16_t val_handle;
+	uint8_t perm;
+	uint8_t properties;
+	union cache_uuid uuid;
+	union cache_uuid val_uuid;
+};
+
+/* Cached discovery result stored in settings */
+struct cache_hdr {
+	uint8_t version;
+	uint8_t db_hash[DB_HASH_LEN];
+	uint16_t attr_cnt;
+	struct cache_attr attrs[];
+};
+
+static atomic_t cache_hits;
+static atomic_t cache_misses;
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 /* The instance structure real declaration */
 struct bt_gatt_dm {
 	/* Connection object */
@@ -92,10 +139,68 @@ struct bt_gatt_dm {
 
 	/* Work item used for discovery callbacks. */
 	struct k_work discover_work;
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* Parameters used to read the peer GATT Database Hash */
+	struct bt_gatt_read_params hash_read_params;
+	/* GATT Database Hash of the peer, valid if has_db_hash is set */
+	uint8_t db_hash[DB_HASH_LEN];
+	/* Indicates that the peer GATT Database Hash was read. */
+	bool has_db_hash;
+	/* Indicates that the discovery result is to be stored in the cache. */
+	bool cache_store;
+	/* Settings key of the cached discovery result */
+	char cache_key[CACHE_KEY_LEN];
+#endif
 };
 
-/* Currently only one instance is supported */
-static struct bt_gatt_dm bt_gatt_dm_inst;
+static struct bt_gatt_dm bt_gatt_dm_pool[CONFIG_BT_GATT_DM_MAX_INSTANCES];
+/* Serializes instance allocation. */
+static struct k_spinlock dm_pool_lock;
+
+static void discovery_complete(struct bt_gatt_dm *dm);
+
+static void discover_work_submit(struct bt_gatt_dm *dm)
+{
+#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
+	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
+#else
+	k_work_submit(&dm->discover_work);
+#endif
+}
+
+static struct bt_gatt_dm *dm_alloc(struct bt_conn *conn)
+{
+	struct bt_gatt_dm *free_dm = NULL;
+	k_spinlock_key_t key = k_spin_lock(&dm_pool_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(bt_gatt_dm_pool); i++) {
+		struct bt_gatt_dm *dm = &bt_gatt_dm_pool[i];
+
+		if (!atomic_test_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+			if (!free_dm) {
+				free_dm = dm;
+			}
+		} else if (dm->conn == conn) {
+			/* Only one discovery per connection at a time. */
+			free_dm = NULL;
+			break;
+		}
+	}
+
+	/* The instance is assigned to the connection under the lock, so that
+	 * a concurrent call for the same connection finds it.
+	 */
+	if (free_dm && !atomic_test_and_set_bit(free_dm->state_flags, STATE_ATTRS_LOCKED)) {
+		free_dm->conn = conn;
+	} else {
+		free_dm = NULL;
+	}
+
+	k_spin_unlock(&dm_pool_lock, key);
+
+	return free_dm;
+}
 
 /* Returns pointer to newly allocated space in a dm->data_chunk */
 static void *user_data_alloc(struct bt_gatt_dm *dm,
@@ -268,9 +373,308 @@ static struct bt_gatt_dm_attr *attr_find_by_handle(
 	return NULL;
 }
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+static bool cache_key_set(struct bt_gatt_dm *dm, const struct bt_uuid *svc_uuid)
+{
+	struct bt_conn_info info;
+	char uuid_str[BT_UUID_STR_LEN];
+	const bt_addr_t *a;
+	int len;
+
+	if (bt_conn_get_info(dm->conn, &info) || (info.type != BT_CONN_TYPE_LE) ||
+	    !bt_le_bond_exists(info.id, info.le.dst)) {
+		return false;
+	}
+
+	if (svc_uuid) {
+		bt_uuid_to_str(svc_uuid, uuid_str, sizeof(uuid_str));
+	} else {
+		strcpy(uuid_str, "all");
+	}
+
+	a = &info.le.dst->a;
+	len = snprintk(dm->cache_key, sizeof(dm->cache_key),
+		       CACHE_SETTINGS_ROOT "/%02x%02x%02x%02x%02x%02x%u%u/%s",
+		       a->val[5], a->val[4], a->val[3], a->val[2], a->val[1], a->val[0],
+		       info.le.dst->type, info.id, uuid_str);
+
+	return (len > 0) && (len < sizeof(dm->cache_key));
+}
+
+static int cache_save(struct bt_gatt_dm *dm)
+{
+	struct cache_hdr *hdr;
+	struct cache_attr *rec;
+	size_t len = sizeof(*hdr) + dm->cur_attr_id * sizeof(*rec);
+	int err;
+
+	hdr = k_malloc(len);
+	if (!hdr) {
+		return -ENOMEM;
+	}
+
+	hdr->version = CACHE_VERSION;
+	memcpy(hdr->db_hash, dm->db_hash, sizeof(hdr->db_hash));
+	hdr->attr_cnt = dm->cur_attr_id;
+
+	rec = hdr->attrs;
+	for (size_t i = 0; i < dm->cur_attr_id; i++, rec++) {
+		const struct bt_gatt_dm_attr *attr = &dm->attrs[i];
+		const struct bt_gatt_service_val *service_val;
+		const struct bt_gatt_chrc *chrc;
+
+		memset(rec, 0, sizeof(*rec));
+		rec->handle = attr->handle;
+		rec->perm = attr->perm;
+		memcpy(&rec->uuid, attr->uuid, get_uuid_size(attr->uuid));
+
+		service_val = bt_gatt_dm_attr_service_val(attr);
+		chrc = bt_gatt_dm_attr_chrc_val(attr);
+		if (service_val) {
+			rec->val_handle = service_val->end_handle;
+			memcpy(&rec->val_uuid, service_val->uuid,
+			       get_uuid_size(service_val->uuid));
+		} else if (chrc) {
+			rec->val_handle = chrc->value_handle;
+			rec->properties = chrc->properties;
+			memcpy(&rec->val_uuid, chrc->uuid, get_uuid_size(chrc->uuid));
+		}
+	}
+
+	err = settings_save_one(dm->cache_key, hdr, len);
+	k_free(hdr);
+
+	return err;
+}
+
+static int cache_attr_restore(struct bt_gatt_dm *dm, const struct cache_attr *rec)
+{
+	struct bt_gatt_attr attr = {
+		.uuid = &rec->uuid.uuid,
+		.handle = rec->handle,
+		.perm = rec->perm,
+	};
+	struct bt_gatt_dm_attr *cur_attr;
+	bool is_service = !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_PRIMARY) ||
+			  !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_SECONDARY);
+	bool is_chrc = !bt_uuid_cmp(attr.uuid, BT_UUID_GATT_CHRC);
+
+	if (!get_uuid_size(attr.uuid)) {
+		return -EINVAL;
+	}
+
+	if (is_service) {
+		struct bt_gatt_service_val *service_val;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*service_val));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		service_val = bt_gatt_dm_attr_service_val(cur_attr);
+		service_val->end_handle = rec->val_handle;
+		service_val->uuid = uuid_store(dm, &rec->val_uuid.uuid);
+		if (!service_val->uuid) {
+			return -ENOMEM;
+		}
+	} else if (is_chrc) {
+		struct bt_gatt_chrc *chrc;
+
+		cur_attr = attr_store(dm, &attr, sizeof(*chrc));
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+
+		chrc = bt_gatt_dm_attr_chrc_val(cur_attr);
+		chrc->value_handle = rec->val_handle;
+		chrc->properties = rec->properties;
+		chrc->uuid = uuid_store(dm, &rec->val_uuid.uuid);
+		if (!chrc->uuid) {
+			return -ENOMEM;
+		}
+	} else {
+		cur_attr = attr_store(dm, &attr, 0);
+		if (!cur_attr) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+static int cache_load_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct bt_gatt_dm *dm = param;
+	const struct cache_hdr *hdr;
+	const struct cache_attr *rec;
+	struct bt_gatt_service_val *service_val;
+	ssize_t read_len;
+	int err = 0;
+
+	if (settings_name_next(key, NULL) != 0) {
+		/* Not the exact key. */
+		return 0;
+	}
+
+	if ((len < sizeof(*hdr)) ||
+	    ((len - sizeof(*hdr)) % sizeof(*rec) != 0) ||
+	    ((len - sizeof(*hdr)) / sizeof(*rec) > ARRAY_SIZE(dm->attrs))) {
+		LOG_WRN("Invalid cache entry size: %zu", len);
+		return 0;
+	}
+
+	hdr = k_malloc(len);
+	if (!hdr) {
+		return 0;
+	}
+
+	read_len = read_cb(cb_arg, (void *)hdr, len);
+	if ((read_len != len) || (hdr->version != CACHE_VERSION) ||
+	    (hdr->attr_cnt != (len - sizeof(*hdr)) / sizeof(*rec)) || (hdr->attr_cnt == 0) ||
+	    memcmp(hdr->db_hash, dm->db_hash, sizeof(hdr->db_hash))) {
+		goto out;
+	}
+
+	rec = hdr->attrs;
+	for (size_t i = 0; (i < hdr->attr_cnt) && !err; i++) {
+		err = cache_attr_restore(dm, &rec[i]);
+	}
+
+	service_val = err ? NULL : bt_gatt_dm_attr_service_val(&dm->attrs[0]);
+	if (!service_val) {
+		svc_attr_memory_release(dm);
+		goto out;
+	}
+
+	dm->discover_params.end_handle = service_val->end_handle;
+
+out:
+	k_free((void *)hdr);
+
+	/* Stop at the first entry. */
+	return 1;
+}
+
+static bool cache_restore(struct bt_gatt_dm *dm)
+{
+	int err = settings_load_subtree_direct(dm->cache_key, cache_load_cb, dm);
+
+	if (err) {
+		LOG_WRN("Cache load failed, error: %d.", err);
+		svc_attr_memory_release(dm);
+		return false;
+	}
+
+	return dm->cur_attr_id != 0;
+}
+
+static uint8_t cache_hash_read_cb(struct bt_conn *conn, uint8_t err,
+				  struct bt_gatt_read_params *params,
+				  const void *data, uint16_t length)
+{
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, hash_read_params);
+
+	if (!err && data && (length == sizeof(dm->db_hash))) {
+		memcpy(dm->db_hash, data, sizeof(dm->db_hash));
+		dm->has_db_hash = true;
+	} else {
+		LOG_DBG("GATT Database Hash not available, err: %u", err);
+	}
+
+	if (dm->has_db_hash && cache_restore(dm)) {
+		LOG_DBG("Discovery result restored from cache");
+		atomic_inc(&cache_hits);
+		discovery_complete(dm);
+		return BT_GATT_ITER_STOP;
+	}
+
+	atomic_inc(&cache_misses);
+	dm->cache_store = dm->has_db_hash;
+	discover_work_submit(dm);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int cache_hash_read(struct bt_gatt_dm *dm)
+{
+	dm->has_db_hash = false;
+	dm->hash_read_params.func = cache_hash_read_cb;
+	dm->hash_read_params.handle_count = 0;
+	dm->hash_read_params.by_uuid.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	dm->hash_read_params.by_uuid.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	dm->hash_read_params.by_uuid.uuid = BT_UUID_GATT_DB_HASH;
+
+	return bt_gatt_read(dm->conn, &dm->hash_read_params);
+}
+
+static int cache_delete_cb(const char *key, size_t len, settings_read_cb read_cb,
+			   void *cb_arg, void *param)
+{
+	const char *prefix = param;
+	char name[CACHE_KEY_LEN];
+	int err;
+
+	if (!key) {
+		return 0;
+	}
+
+	err = snprintk(name, sizeof(name), "%s/%s", prefix, key);
+	if ((err > 0) && (err < sizeof(name))) {
+		err = settings_delete(name);
+		if (err) {
+			LOG_WRN("Cache entry delete failed, error: %d.", err);
+		}
+	}
+
+	return 0;
+}
+
+static void cache_bond_deleted(uint8_t id, const bt_addr_le_t *peer)
+{
+	char prefix[CACHE_KEY_LEN];
+	const bt_addr_t *a = &peer->a;
+
+	snprintk(prefix, sizeof(prefix), CACHE_SETTINGS_ROOT "/%02x%02x%02x%02x%02x%02x%u%u",
+		 a->val[5], a->val[4], a->val[3], a->val[2], a->val[1], a->val[0],
+		 peer->type, id);
+
+	(void)settings_load_subtree_direct(prefix, cache_delete_cb, prefix);
+}
+
+static struct bt_conn_auth_info_cb cache_auth_info_cb = {
+	.bond_deleted = cache_bond_deleted,
+};
+
+static int gatt_dm_cache_init(void)
+{
+	return bt_conn_auth_info_cb_register(&cache_auth_info_cb);
+}
+
+SYS_INIT(gatt_dm_cache_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+void bt_gatt_dm_cache_stats_get(struct bt_gatt_dm_cache_stats *stats)
+{
+	stats->hits = (uint32_t)atomic_get(&cache_hits);
+	stats->misses = (uint32_t)atomic_get(&cache_misses);
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
+
 static void discovery_complete(struct bt_gatt_dm *dm)
 {
 	LOG_DBG("Discovery complete.");
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	if (dm->cache_store) {
+		int err = cache_save(dm);
+
+		if (err) {
+			LOG_WRN("Cache store failed, error: %d.", err);
+		}
+		dm->cache_store = false;
+	}
+#endif
+
 	atomic_set_bit(dm->state_flags, STATE_ATTRS_RELEASE_PENDING);
 	if (dm->callback->completed) {
 		dm->callback->completed(dm, dm->context);
@@ -373,11 +777,7 @@ static uint8_t discovery_process_service(struct bt_gatt_dm *dm,
 	dm->discover_params.start_handle = cur_attr->handle + 1;
 	LOG_DBG("Starting descriptors discovery");
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-	k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-	k_work_submit(&dm->discover_work);
-#endif
+	discover_work_submit(dm);
 
 	return BT_GATT_ITER_STOP;
 }
@@ -396,11 +796,7 @@ static uint8_t discovery_process_attribute(struct bt_gatt_dm *dm,
 			dm->discover_params.type =
 				BT_GATT_DISCOVER_CHARACTERISTIC;
 
-#if defined(CONFIG_BT_GATT_DM_WORKQ_OWN)
-			k_work_submit_to_queue(&bt_gatt_dm_wq, &dm->discover_work);
-#else
-			k_work_submit(&dm->discover_work);
-#endif
+			discover_work_submit(dm);
 		} else {
 			discovery_complete(dm);
 		}
@@ -469,34 +865,32 @@ static uint8_t discovery_callback(struct bt_conn *conn,
 			       const struct bt_gatt_attr *attr,
 			       struct bt_gatt_discover_params *params)
 {
+	struct bt_gatt_dm *dm = CONTAINER_OF(params, struct bt_gatt_dm, discover_params);
+
 	if (!attr) {
 		LOG_DBG("NULL attribute");
 	} else {
 		LOG_DBG("Attr: handle %u", attr->handle);
 	}
 
-	if (conn != bt_gatt_dm_inst.conn) {
+	if (conn != dm->conn) {
 		LOG_ERR("Unexpected conn object. Aborting.");
-		discovery_complete_error(&bt_gatt_dm_inst, -EFAULT);
+		discovery_complete_error(dm, -EFAULT);
 		return BT_GATT_ITER_STOP;
 	}
 
 	switch (params->type) {
 	case BT_GATT_DISCOVER_PRIMARY:
 	case BT_GATT_DISCOVER_SECONDARY:
-		return discovery_process_service(&bt_gatt_dm_inst,
-						 attr, params);
+		return discovery_process_service(dm, attr, params);
 	case BT_GATT_DISCOVER_ATTRIBUTE:
-		return discovery_process_attribute(&bt_gatt_dm_inst,
-						   attr, params);
+		return discovery_process_attribute(dm, attr, params);
 	case BT_GATT_DISCOVER_CHARACTERISTIC:
-		return discovery_process_characteristic(&bt_gatt_dm_inst,
-							attr,
-							params);
+		return discovery_process_characteristic(dm, attr, params);
 	default:
 		/* This should not be possible */
 		__ASSERT(false, "Unknown param type.");
-		discovery_complete_error(&bt_gatt_dm_inst, -EINVAL);
+		discovery_complete_error(dm, -EINVAL);
 
 		break;
 	}
@@ -651,13 +1045,11 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 		return -EINVAL;
 	}
 
-	dm = &bt_gatt_dm_inst;
-
-	if (atomic_test_and_set_bit(dm->state_flags, STATE_ATTRS_LOCKED)) {
+	dm = dm_alloc(conn);
+	if (!dm) {
 		return -EALREADY;
 	}
 
-	dm->conn = conn;
 	dm->context = context;
 	dm->callback = cb;
 	dm->cur_attr_id = 0;
@@ -679,6 +1071,20 @@ int bt_gatt_dm_start(struct bt_conn *conn,
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
 	k_work_init(&dm->discover_work, gatt_discover_work);
 
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	dm->cache_store = false;
+
+	if (cache_key_set(dm, svc_uuid)) {
+		/* Discovery is started or skipped once the hash is read. */
+		err = cache_hash_read(dm);
+		if (!err) {
+			return 0;
+		}
+
+		LOG_WRN("GATT Database Hash read failed, error: %d.", err);
+	}
+#endif
+
 	err = bt_gatt_discover(conn, &dm->discover_params);
 	if (err) {
 		LOG_ERR("Discover failed, error: %d.", err);
@@ -717,6 +1123,10 @@ int bt_gatt_dm_continue(struct bt_gatt_dm *dm, void *context)
 	}
 
 	dm->context = context;
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+	/* Only the result of bt_gatt_dm_start is cached. */
+	dm->cache_store = false;
+#endif
 	dm->discover_params.start_handle = dm->discover_params.end_handle + 1;
 	dm->discover_params.end_handle = 0xffff;
 	dm->discover_params.type = BT_GATT_DISCOVER_PRIMARY;
@@ -14,6 +14,14 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 
 #define BT_SCAN_UUID_128_SIZE 16
 
+/* Offset of the 16 or 32-bit value in a UUID derived from the Bluetooth Base UUID. */
+#define BT_SCAN_UUID_BASE_VAL_OFFSET 12
+
+/* Little-endian encoding of the Bluetooth Base UUID. */
+static const uint8_t uuid_base_le[BT_SCAN_UUID_128_SIZE] = {
+	BT_UUID_128_ENCODE(0x00000000, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB)
+};
+
 #define MODE_CHECK (BT_SCAN_NAME_FILTER | BT_SCAN_ADDR_FILTER | \
 	BT_SCAN_SHORT_NAME_FILTER | BT_SCAN_APPEARANCE_FILTER | \
 	BT_SCAN_UUID_FILTER | BT_SCAN_MANUFACTURER_DATA_FILTER)
@@ -89,6 +97,11 @@ struct bt_scan_addr_filter {
 	/* Addresses advertised by the peripherals. */
 	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
 
+	/* Bloom filter of the target addresses, used to reject
+	 * most advertisers without comparing the full address list.
+	 */
+	uint32_t bloom;
+
 	/* Address filter counter. */
 	uint8_t cnt;
 
@@ -110,6 +123,19 @@ struct bt_scan_uuid {
 		/* 128-bit UUID. */
 		struct bt_uuid_128 uuid_128;
 	} uuid_data;
+
+	/* Set if the UUID is derived from the Bluetooth Base UUID,
+	 * so it can be matched by its 16 or 32-bit value.
+	 */
+	bool base;
+
+	/* 16 or 32-bit value of a UUID derived from the Base UUID. */
+	uint32_t val;
+
+	/* Little-endian 128-bit encoding of the UUID, in advertising
+	 * data byte order.
+	 */
+	uint8_t le128[BT_SCAN_UUID_128_SIZE];
 };
 
 /* UUIDs filter structure.
@@ -435,11 +461,8 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
-	char addr_str[BT_ADDR_LE_STR_LEN];
 	bool attempts_exceeded = false;
 
-	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
-
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
 	/* Check if the device is in the filter array. */
@@ -448,8 +471,13 @@ static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 
 		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
 			if (device->attempts >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				LOG_DBG("Connection attempts count for %s exceeded",
-					addr_str);
+				if (IS_ENABLED(CONFIG_BT_SCAN_LOG_LEVEL_DBG)) {
+					char addr_str[BT_ADDR_LE_STR_LEN];
+
+					bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+					LOG_DBG("Connection attempts count for %s exceeded",
+						addr_str);
+				}
 				attempts_exceeded = true;
 			}
 
@@ -519,12 +547,25 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
+static uint32_t addr_bloom_bits(const bt_addr_le_t *addr)
+{
+	/* Device addresses are either random or assigned from a vendor
+	 * range, so the low octets are hashed well enough as they are.
+	 */
+	return BIT(addr->a.val[0] & 0x1F) | BIT(addr->a.val[1] & 0x1F);
+}
+
 static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 			     struct bt_scan_control *control)
 {
 	const bt_addr_le_t *addr =
 			bt_scan.scan_filters.addr.target_addr;
 	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	uint32_t bits = addr_bloom_bits(target_addr);
+
+	if ((bt_scan.scan_filters.addr.bloom & bits) != bits) {
+		return false;
+	}
 
 	for (size_t i = 0; i < counter; i++) {
 		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
@@ -577,6 +618,7 @@ static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 
 	/* Add target address to filter. */
 	bt_addr_le_copy(&addr_filter[counter], target_addr);
+	bt_scan.scan_filters.addr.bloom |= addr_bloom_bits(target_addr);
 
 	LOG_DBG("Filter set on address type %i",
 		addr_filter[counter].type);
@@ -782,38 +824,84 @@ static bool find_uuid(const uint8_t *data,
 		      uint8_t uuid_type,
 		      const struct bt_scan_uuid *target_uuid)
 {
-	uint8_t uuid_len;
-
+	/* The advertised UUIDs are compared in their raw encoding against
+	 * the forms prepared when the filter was added. This gives the same
+	 * result as bt_uuid_cmp(), which compares UUIDs of different types
+	 * in their 128-bit form, without decoding every advertised UUID.
+	 */
 	switch (uuid_type) {
 	case BT_UUID_TYPE_16:
-		uuid_len = sizeof(uint16_t);
-		break;
+		if (!target_uuid->base || (data_len % sizeof(uint16_t))) {
+			return false;
+		}
+
+		for (size_t i = 0; i < data_len; i += sizeof(uint16_t)) {
+			if (sys_get_le16(&data[i]) == target_uuid->val) {
+				return true;
+			}
+		}
+
+		return false;
 
 	case BT_UUID_TYPE_32:
-		uuid_len = sizeof(uint32_t);
-		break;
+		if (!target_uuid->base || (data_len % sizeof(uint32_t))) {
+			return false;
+		}
+
+		for (size_t i = 0; i < data_len; i += sizeof(uint32_t)) {
+			if (sys_get_le32(&data[i]) == target_uuid->val) {
+				return true;
+			}
+		}
+
+		return false;
 
 	case BT_UUID_TYPE_128:
-		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
-		break;
+		if (data_len % BT_SCAN_UUID_128_SIZE) {
+			return false;
+		}
+
+		for (size_t i = 0; i < data_len; i += BT_SCAN_UUID_128_SIZE) {
+			if (!memcmp(&data[i], target_uuid->le128, BT_SCAN_UUID_128_SIZE)) {
+				return true;
+			}
+		}
+
+		return false;
 
 	default:
 		return false;
 	}
+}
 
-	for (size_t i = 0; i < data_len; i += uuid_len) {
-		struct bt_uuid_128 uuid;
+static void uuid_filter_compile(struct bt_scan_uuid *target_uuid)
+{
+	switch (target_uuid->uuid->type) {
+	case BT_UUID_TYPE_16:
+		target_uuid->val = BT_UUID_16(target_uuid->uuid)->val;
+		target_uuid->base = true;
+		break;
 
-		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
-			return false;
-		}
+	case BT_UUID_TYPE_32:
+		target_uuid->val = BT_UUID_32(target_uuid->uuid)->val;
+		target_uuid->base = true;
+		break;
 
-		if (bt_uuid_cmp(&uuid.uuid, target_uuid->uuid) == 0) {
-			return true;
-		}
+	case BT_UUID_TYPE_128:
+		memcpy(target_uuid->le128, BT_UUID_128(target_uuid->uuid)->val,
+		       BT_SCAN_UUID_128_SIZE);
+		target_uuid->base = !memcmp(target_uuid->le128, uuid_base_le,
+					    BT_SCAN_UUID_BASE_VAL_OFFSET);
+		target_uuid->val =
+			sys_get_le32(&target_uuid->le128[BT_SCAN_UUID_BASE_VAL_OFFSET]);
+		return;
+
+	default:
+		return;
 	}
 
-	return false;
+	memcpy(target_uuid->le128, uuid_base_le, BT_SCAN_UUID_BASE_VAL_OFFSET);
+	sys_put_le32(target_uuid->val, &target_uuid->le128[BT_SCAN_UUID_BASE_VAL_OFFSET]);
 }
 
 static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
@@ -930,6 +1018,8 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 		return -EINVAL;
 	}
 
+	uuid_filter_compile(&uuid_filter[counter]);
+
 	bt_scan.scan_filters.uuid.cnt++;
 	LOG_DBG("Added filter on UUID type %x", uuid->type);
 
@@ -1242,6 +1332,7 @@ void bt_scan_filter_remove_all(void)
 	struct bt_scan_addr_filter *addr_filter =
 			&bt_scan.scan_filters.addr;
 	addr_filter->cnt = 0;
+	addr_filter->bloom = 0;
 
 	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
@@ -1471,13 +1562,30 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 	return true;
 }
 
-static void filter_state_check(struct bt_scan_control *control,
-			       const bt_addr_le_t *addr)
+static bool adv_data_check_needed(const struct bt_scan_control *control)
 {
-	if (!scan_device_filter_check(addr)) {
-		return;
+	uint8_t adv_data_filter_cnt = control->filter_cnt;
+
+	if (is_addr_filter_enabled()) {
+		/* In the multifilter mode, a device that does not match
+		 * the address filter cannot match anymore.
+		 */
+		if (control->all_mode && !control->filter_status.addr.match) {
+			return false;
+		}
+
+		adv_data_filter_cnt--;
 	}
 
+	/* The advertising data only needs to be walked if any of
+	 * the advertising data filters is enabled.
+	 */
+	return adv_data_filter_cnt > 0;
+}
+
+static void filter_state_check(struct bt_scan_control *control,
+			       const bt_addr_le_t *addr)
+{
 	if (control->all_mode &&
 	    (control->filter_match_cnt == control->filter_cnt)) {
 		notify_filter_matched(&control->device_info,
@@ -1551,15 +1659,24 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 		connectable_cache_add(info->addr);
 	}
 
+	/* Blocklisted devices are not reported, so there is no need
+	 * to evaluate the filters for them.
+	 */
+	if (!scan_device_filter_check(info->addr)) {
+		return;
+	}
+
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
-	/* Save advertising buffer state to transfer it
-	 * data to application if futher processing is needed.
-	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
+	if (adv_data_check_needed(&scan_control)) {
+		/* Save advertising buffer state to transfer it
+		 * data to application if futher processing is needed.
+		 */
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+	}
 
 	scan_control.device_info.recv_info = info;
 	scan_control.device_info.conn_param = &bt_scan.conn_param;
@@ -356,11 +356,9 @@ BT_GATT_SERVICE_DEFINE(cgms_svc,
 				BT_GATT_PERM_READ_AUTHEN | BT_GATT_PERM_WRITE_AUTHEN),
 );
 
-static void bt_cgms_notify_meas(struct bt_conn *conn, void *data)
+static void cgms_meas_encode(const struct cgms_meas *meas, struct net_buf_simple *meas_buf)
 {
-	struct cgms_meas *meas = (struct cgms_meas *)data;
 	uint8_t meas_size;
-	struct net_buf_simple *meas_buf = NET_BUF_SIMPLE(CGMS_MEAS_LENGTH);
 
 	net_buf_simple_init(meas_buf, sizeof(meas_size));
 
@@ -379,6 +377,16 @@ static void bt_cgms_notify_meas(struct bt_conn *conn, void *data)
 
 	meas_size = meas_buf->len + 1;
 	net_buf_simple_push_u8(meas_buf, meas_size);
+}
+
+static void bt_cgms_notify_meas(struct bt_conn *conn, void *data)
+{
+	struct cgms_meas *meas = (struct cgms_meas *)data;
+	struct net_buf_simple *meas_buf = NET_BUF_SIMPLE(CGMS_MEAS_LENGTH);
+	uint8_t meas_size;
+
+	cgms_meas_encode(meas, meas_buf);
+	meas_size = meas_buf->len;
 
 	/* If conn is NULL, it implies this is a periodic notification.
 	 * Send it to all peers.
@@ -408,10 +416,26 @@ int cgms_racp_send_response(struct bt_conn *peer, struct net_buf_simple *rsp)
 	return bt_gatt_indicate(peer, &indicate_data);
 }
 
-int cgms_racp_send_record(struct bt_conn *peer, struct cgms_meas *entry)
+int cgms_racp_send_record(struct bt_conn *peer, const struct cgms_meas *entry,
+			  bt_gatt_complete_func_t func, void *user_data)
 {
-	bt_cgms_notify_meas(peer, entry);
-	return 0;
+	struct net_buf_simple *meas_buf = NET_BUF_SIMPLE(CGMS_MEAS_LENGTH);
+	struct bt_gatt_notify_params params = {
+		.attr = &cgms_svc.attrs[CGMS_SVC_MEAS_ATTR_IDX],
+		.func = func,
+		.user_data = user_data,
+	};
+
+	if (!bt_gatt_is_subscribed(peer, params.attr, BT_GATT_CCC_NOTIFY)) {
+		LOG_INF("Client disabled the measurement notification");
+		return -EACCES;
+	}
+
+	cgms_meas_encode(entry, meas_buf);
+	params.data = meas_buf->data;
+	params.len = meas_buf->len;
+
+	return bt_gatt_notify_cb(peer, &params);
 }
 
 int cgms_socp_send_response(struct bt_conn *peer, struct net_buf_simple *rsp)
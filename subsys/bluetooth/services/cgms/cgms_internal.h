@@ -9,6 +9,7 @@
 
 #include <zephyr/types.h>
 #include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/gatt.h>
 #include <bluetooth/services/cgms.h>
 
 #ifdef __cplusplus
@@ -144,8 +145,11 @@ int cgms_racp_recv_request(struct bt_conn *peer, const uint8_t *req_data, uint16
 /* Function for sending RACP response. */
 int cgms_racp_send_response(struct bt_conn *peer, struct net_buf_simple *rsp);
 
-/* Function for sending RACP records. */
-int cgms_racp_send_record(struct bt_conn *peer, struct cgms_meas *entry);
+/* Function for sending RACP records.
+ * The func callback is called once the record has been sent.
+ */
+int cgms_racp_send_record(struct bt_conn *peer, const struct cgms_meas *entry,
+			  bt_gatt_complete_func_t func, void *user_data);
 
 /* Function for retrieving the newest RACP records. */
 int cgms_racp_meas_get_latest(struct cgms_meas *meas);
@@ -5,7 +5,7 @@
  */
 #include <zephyr/types.h>
 #include <zephyr/kernel.h>
-#include <zephyr/sys/slist.h>
+#include <zephyr/sys/util.h>
 #include <string.h>
 #include <zephyr/logging/log.h>
 
@@ -65,13 +65,6 @@ enum racp_rsp_code {
 	RACP_RESPONSE_OPERAND_UNSUPPORTED = 9,
 };
 
-/* structure of a record in db  */
-struct cgms_meas_db_entry {
-	sys_snode_t node;
-	bool used;
-	struct cgms_meas meas;
-};
-
 /** structure of racp task */
 struct racp_task {
 	struct k_work item;
@@ -80,25 +73,65 @@ struct racp_task {
 	uint8_t req_buf[CGMS_RACP_MAX_LENGTH];
 };
 
-static struct cgms_meas_db_entry cgms_meas_db_entry_pool[RECORD_NUM];
+/* Measurement records stored in a ring buffer, ordered by time offset.
+ * Every record gets a sequence number; record seq is stored at
+ * records[seq % RECORD_NUM]. The stored records are the ones from
+ * first_seq to first_seq + record_cnt - 1.
+ */
+static struct cgms_meas records[RECORD_NUM];
 
-static struct k_mutex lock;
+static uint32_t first_seq;
 
-static sys_slist_t database;
+static uint32_t record_cnt;
+
+static struct k_mutex lock;
 
 static struct k_work_q racp_work_q;
 
 static struct racp_task report_record_task;
 
-static struct cgms_meas_db_entry *entry_alloc(void)
+/* Limits the number of records queued in the Bluetooth host. */
+static struct k_sem record_tx_sem;
+
+/* Incremented when a report procedure starts. Records carry the generation
+ * they were queued in, so completions of records queued by an earlier
+ * procedure do not give back permits of the current one.
+ */
+static uint32_t record_tx_gen;
+
+/* Protects record_tx_gen and record_tx_sem against the completion callback. */
+static struct k_spinlock record_tx_lock;
+
+/* Set when the client aborts the ongoing report procedure. */
+static atomic_t abort_requested;
+
+/* Time to wait for a queued record to be sent. */
+#define RECORD_TX_TIMEOUT K_SECONDS(30)
+
+static struct cgms_meas *record_get(uint32_t seq)
 {
-	for (int i = 0; i < ARRAY_SIZE(cgms_meas_db_entry_pool); i++) {
-		if (!cgms_meas_db_entry_pool[i].used) {
-			cgms_meas_db_entry_pool[i].used = true;
-			return &cgms_meas_db_entry_pool[i];
+	return &records[seq % RECORD_NUM];
+}
+
+/* Returns the sequence number of the first record with time offset greater
+ * than or equal to time_offset_limit. Must be called with the lock held.
+ */
+static uint32_t record_lower_bound(uint16_t time_offset_limit)
+{
+	uint32_t lower = first_seq;
+	uint32_t upper = first_seq + record_cnt;
+
+	while (lower < upper) {
+		uint32_t mid = lower + (upper - lower) / 2;
+
+		if (record_get(mid)->time_offset < time_offset_limit) {
+			lower = mid + 1;
+		} else {
+			upper = mid;
 		}
 	}
-	return NULL;
+
+	return lower;
 }
 
 static int generic_handler(struct bt_conn *peer, uint8_t opcode, uint8_t response_code)
@@ -113,40 +146,141 @@ static int generic_handler(struct bt_conn *peer, uint8_t opcode, uint8_t respons
 	return cgms_racp_send_response(peer, &rsp);
 }
 
-static int report_recs_all_handler(struct bt_conn *peer)
+static void record_sent(struct bt_conn *conn, void *user_data)
 {
-	int rc;
-	struct cgms_meas_db_entry *entry;
-	sys_snode_t *record_node;
+	k_spinlock_key_t key = k_spin_lock(&record_tx_lock);
 
-	/* Check if database is empty */
-	if (sys_slist_is_empty(&database)) {
-		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_NO_RECORDS_FOUND);
+	if (POINTER_TO_UINT(user_data) == record_tx_gen) {
+		k_sem_give(&record_tx_sem);
+	}
+
+	k_spin_unlock(&record_tx_lock, key);
+}
+
+/* Records queued for a peer that disconnected may never be reported as sent,
+ * so every report procedure starts with all permits available. Records still
+ * queued by the previous procedure belong to an old generation and are ignored
+ * when they complete.
+ */
+static uint32_t record_tx_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&record_tx_lock);
+	uint32_t gen = ++record_tx_gen;
+
+	k_sem_reset(&record_tx_sem);
+	for (int i = 0; i < CONFIG_BT_CGMS_RACP_MAX_PENDING_RECORDS; i++) {
+		k_sem_give(&record_tx_sem);
+	}
+
+	k_spin_unlock(&record_tx_lock, key);
+
+	return gen;
+}
+
+/* Waits until all queued records are sent. */
+static int record_tx_drain(void)
+{
+	int rc = 0;
+	int taken;
+
+	for (taken = 0; taken < CONFIG_BT_CGMS_RACP_MAX_PENDING_RECORDS; taken++) {
+		rc = k_sem_take(&record_tx_sem, RECORD_TX_TIMEOUT);
+		if (rc != 0) {
+			break;
+		}
+	}
+
+	while (taken-- > 0) {
+		k_sem_give(&record_tx_sem);
 	}
 
-	SYS_SLIST_FOR_EACH_NODE(&database, record_node) {
-		entry = CONTAINER_OF(record_node, struct cgms_meas_db_entry, node);
-		rc = cgms_racp_send_record(peer, &entry->meas);
+	return rc;
+}
+
+/* Streams the records from start_seq to end_seq - 1. Records overwritten
+ * while the procedure runs are skipped. The lock is held only while a
+ * record is copied, so new measurements can be stored during the procedure.
+ */
+static int report_recs_stream(struct bt_conn *peer, uint32_t start_seq, uint32_t end_seq)
+{
+	int rc;
+	struct cgms_meas meas;
+	uint32_t gen = record_tx_reset();
+
+	for (uint32_t seq = start_seq; seq < end_seq; seq++) {
+		if (atomic_get(&abort_requested)) {
+			LOG_INF("RACP: report aborted");
+			(void)record_tx_drain();
+			return 0;
+		}
+
+		rc = k_sem_take(&record_tx_sem, RECORD_TX_TIMEOUT);
+		if (rc != 0) {
+			LOG_WRN("RACP: record transmission timed out");
+			return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
+					RACP_RESPONSE_PROCEDURE_NOT_DONE);
+		}
+
+		k_mutex_lock(&lock, K_FOREVER);
+		if (seq < first_seq) {
+			seq = first_seq;
+		}
+		if (seq < end_seq) {
+			meas = *record_get(seq);
+		}
+		k_mutex_unlock(&lock);
+
+		if (seq >= end_seq) {
+			k_sem_give(&record_tx_sem);
+			break;
+		}
+
+		rc = cgms_racp_send_record(peer, &meas, record_sent, UINT_TO_POINTER(gen));
 		if (rc != 0) {
+			/* Records already queued are not waited for, the permits are
+			 * restored when the next report starts.
+			 */
 			LOG_WRN("Error occurs when transmitting record: %d", rc);
 			return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
 					RACP_RESPONSE_PROCEDURE_NOT_DONE);
 		}
+	}
 
+	if (record_tx_drain() != 0) {
+		LOG_WRN("RACP: record transmission timed out");
+		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
+				RACP_RESPONSE_PROCEDURE_NOT_DONE);
 	}
 
 	return generic_handler(peer, RACP_OPCODE_REPORT_RECS, RACP_RESPONSE_SUCCESS);
 }
 
+static int report_recs_all_handler(struct bt_conn *peer)
+{
+	uint32_t start_seq;
+	uint32_t end_seq;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	start_seq = first_seq;
+	end_seq = first_seq + record_cnt;
+	k_mutex_unlock(&lock);
+
+	/* Check if database is empty */
+	if (start_seq == end_seq) {
+		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
+				RACP_RESPONSE_NO_RECORDS_FOUND);
+	}
+
+	return report_recs_stream(peer, start_seq, end_seq);
+}
+
 static int report_recs_greater_or_equal_handler(struct bt_conn *peer,
 					struct net_buf_simple *operand)
 {
-	int rc;
 	enum racp_operand_filter filter;
 	uint16_t time_offset_limit;
-	struct cgms_meas_db_entry *entry;
-	sys_snode_t *record_node;
+	uint32_t start_seq;
+	uint32_t end_seq;
 
 	/* In this case, the length of operand is at least 3 bytes,
 	 * 1 for filter type, another 2 for filter value.
@@ -164,74 +298,53 @@ static int report_recs_greater_or_equal_handler(struct bt_conn *peer,
 
 	time_offset_limit = net_buf_simple_pull_le16(operand);
 
-	/* Check if database is empty */
-	if (sys_slist_is_empty(&database)) {
-		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_NO_RECORDS_FOUND);
-	}
+	k_mutex_lock(&lock, K_FOREVER);
+	start_seq = record_lower_bound(time_offset_limit);
+	end_seq = first_seq + record_cnt;
+	k_mutex_unlock(&lock);
 
-	entry = CONTAINER_OF(sys_slist_peek_tail(&database), struct cgms_meas_db_entry, node);
-	/* If the latest one has a smaller time offset than threshold, no record is found */
-	if (entry->meas.time_offset < time_offset_limit) {
+	if (start_seq == end_seq) {
 		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
 				RACP_RESPONSE_NO_RECORDS_FOUND);
 	}
 
-	SYS_SLIST_FOR_EACH_NODE(&database, record_node) {
-		entry = CONTAINER_OF(record_node, struct cgms_meas_db_entry, node);
-		if (entry->meas.time_offset >= time_offset_limit) {
-			rc = cgms_racp_send_record(peer, &entry->meas);
-			if (rc != 0) {
-				LOG_WRN("Error occurs when transmitting record: %d", rc);
-				return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-						RACP_RESPONSE_PROCEDURE_NOT_DONE);
-			}
-		}
-	}
-
-	return generic_handler(peer, RACP_OPCODE_REPORT_RECS, RACP_RESPONSE_SUCCESS);
+	return report_recs_stream(peer, start_seq, end_seq);
 }
 
 static int report_recs_first_handler(struct bt_conn *peer)
 {
-	int rc;
-	struct cgms_meas_db_entry *entry;
+	uint32_t start_seq;
+	bool empty;
 
-	if (sys_slist_is_empty(&database)) {
-		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_NO_RECORDS_FOUND);
-	}
+	k_mutex_lock(&lock, K_FOREVER);
+	start_seq = first_seq;
+	empty = (record_cnt == 0);
+	k_mutex_unlock(&lock);
 
-	entry = CONTAINER_OF(sys_slist_peek_head(&database), struct cgms_meas_db_entry, node);
-	rc = cgms_racp_send_record(peer, &entry->meas);
-	if (rc != 0) {
-		LOG_WRN("Error occurs when transmitting record: %d", rc);
+	if (empty) {
 		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_PROCEDURE_NOT_DONE);
+				RACP_RESPONSE_NO_RECORDS_FOUND);
 	}
 
-	return generic_handler(peer, RACP_OPCODE_REPORT_RECS, RACP_RESPONSE_SUCCESS);
+	return report_recs_stream(peer, start_seq, start_seq + 1);
 }
 
 static int report_recs_last_handler(struct bt_conn *peer)
 {
-	int rc;
-	struct cgms_meas_db_entry *entry;
+	uint32_t end_seq;
+	bool empty;
 
-	if (sys_slist_is_empty(&database)) {
-		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_NO_RECORDS_FOUND);
-	}
+	k_mutex_lock(&lock, K_FOREVER);
+	end_seq = first_seq + record_cnt;
+	empty = (record_cnt == 0);
+	k_mutex_unlock(&lock);
 
-	entry = CONTAINER_OF(sys_slist_peek_tail(&database), struct cgms_meas_db_entry, node);
-	rc = cgms_racp_send_record(peer, &entry->meas);
-	if (rc != 0) {
-		LOG_WRN("Error occurs when transmitting record: %d", rc);
+	if (empty) {
 		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
-				RACP_RESPONSE_PROCEDURE_NOT_DONE);
+				RACP_RESPONSE_NO_RECORDS_FOUND);
 	}
 
-	return generic_handler(peer, RACP_OPCODE_REPORT_RECS, RACP_RESPONSE_SUCCESS);
+	return report_recs_stream(peer, end_seq - 1, end_seq);
 }
 
 static int report_recs_handler(struct bt_conn *peer, struct net_buf_simple *operators)
@@ -266,36 +379,34 @@ static int report_recs_handler(struct bt_conn *peer, struct net_buf_simple *oper
 	return rc;
 }
 
-static int report_num_recs_all_handler(struct bt_conn *peer)
+static int num_recs_response_send(struct bt_conn *peer, uint32_t count)
 {
-	uint16_t count = 0;
-	sys_snode_t *record_node;
-
 	NET_BUF_SIMPLE_DEFINE(rsp, CGMS_RACP_MAX_LENGTH);
 
-	if (!sys_slist_is_empty(&database)) {
-		SYS_SLIST_FOR_EACH_NODE(&database, record_node) {
-			count++;
-		}
-	}
-
 	net_buf_simple_add_u8(&rsp, RACP_OPCODE_NUM_RECS_RESPONSE);
 	net_buf_simple_add_u8(&rsp, RACP_OPERATOR_NULL);
-	net_buf_simple_add_le16(&rsp, count);
+	net_buf_simple_add_le16(&rsp, MIN(count, UINT16_MAX));
 
 	return cgms_racp_send_response(peer, &rsp);
 }
 
+static int report_num_recs_all_handler(struct bt_conn *peer)
+{
+	uint32_t count;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	count = record_cnt;
+	k_mutex_unlock(&lock);
+
+	return num_recs_response_send(peer, count);
+}
+
 static int report_num_recs_greater_or_equal_handler(struct bt_conn *peer,
 				struct net_buf_simple *operand)
 {
 	enum racp_operand_filter filter;
 	uint16_t time_offset_limit;
-	uint16_t count = 0;
-	struct cgms_meas_db_entry *entry;
-	sys_snode_t *record_node;
-
-	NET_BUF_SIMPLE_DEFINE(rsp, CGMS_RACP_MAX_LENGTH);
+	uint32_t count;
 
 	if (operand->len < 3) {
 		return generic_handler(peer, RACP_OPCODE_REPORT_RECS,
@@ -310,20 +421,11 @@ static int report_num_recs_greater_or_equal_handler(struct bt_conn *peer,
 
 	time_offset_limit = net_buf_simple_pull_le16(operand);
 
-	if (!sys_slist_is_empty(&database)) {
-		SYS_SLIST_FOR_EACH_NODE(&database, record_node) {
-			entry = CONTAINER_OF(record_node, struct cgms_meas_db_entry, node);
-			if (entry->meas.time_offset >= time_offset_limit) {
-				count++;
-			}
-		}
-	}
+	k_mutex_lock(&lock, K_FOREVER);
+	count = first_seq + record_cnt - record_lower_bound(time_offset_limit);
+	k_mutex_unlock(&lock);
 
-	net_buf_simple_add_u8(&rsp, RACP_OPCODE_NUM_RECS_RESPONSE);
-	net_buf_simple_add_u8(&rsp, RACP_OPERATOR_NULL);
-	net_buf_simple_add_le16(&rsp, count);
-
-	return cgms_racp_send_response(peer, &rsp);
+	return num_recs_response_send(peer, count);
 }
 
 static int report_num_recs_handler(struct bt_conn *peer, struct net_buf_simple *operators)
@@ -356,24 +458,21 @@ static void racp_task_handler(struct k_work *work_item)
 	task = CONTAINER_OF(work_item, struct racp_task, item);
 	opcode = net_buf_simple_pull_u8(&task->req);
 
-	if (k_mutex_lock(&lock, K_NO_WAIT) == 0) {
-		switch (opcode) {
-		case RACP_OPCODE_REPORT_RECS:
-			rc = report_recs_handler(task->peer,
-				&task->req);
-			break;
-		case RACP_OPCODE_REPORT_NUM_RECS:
-			rc = report_num_recs_handler(task->peer,
-				&task->req);
-			break;
-		default:
-			rc = generic_handler(task->peer, opcode,
-					RACP_RESPONSE_OPCODE_UNSUPPORTED);
-			break;
-		}
-		k_mutex_unlock(&lock);
-	} else {
-		rc = -EBUSY;
+	atomic_clear(&abort_requested);
+
+	switch (opcode) {
+	case RACP_OPCODE_REPORT_RECS:
+		rc = report_recs_handler(task->peer,
+			&task->req);
+		break;
+	case RACP_OPCODE_REPORT_NUM_RECS:
+		rc = report_num_recs_handler(task->peer,
+			&task->req);
+		break;
+	default:
+		rc = generic_handler(task->peer, opcode,
+				RACP_RESPONSE_OPCODE_UNSUPPORTED);
+		break;
 	}
 }
 
@@ -397,6 +496,12 @@ static int abort_handler(struct bt_conn *peer, struct net_buf_simple *operators)
 	}
 
 	rc = k_work_cancel(&report_record_task.item);
+	if (rc & K_WORK_RUNNING) {
+		/* The ongoing report stops before sending its next record. */
+		atomic_set(&abort_requested, 1);
+		rc = 0;
+	}
+
 	if (rc == 0) {
 		LOG_INF("RACP: work aborted");
 		rc = generic_handler(peer, RACP_OPCODE_ABORT_OPERATION,
@@ -447,16 +552,18 @@ int cgms_racp_recv_request(struct bt_conn *peer, const uint8_t *req_data, uint16
 int cgms_racp_meas_add(struct cgms_meas meas)
 {
 	int rc;
-	struct cgms_meas_db_entry *entry;
 
-	if (k_mutex_lock(&lock, K_NO_WAIT) == 0) {
-		entry = entry_alloc();
-		if (entry == NULL) {
-			entry = CONTAINER_OF(sys_slist_get(&database),
-					struct cgms_meas_db_entry, node);
+	/* The lock is only held for short record copies, never while records
+	 * are transmitted, so waiting here is bounded.
+	 */
+	if (k_mutex_lock(&lock, K_FOREVER) == 0) {
+		if (record_cnt == RECORD_NUM) {
+			/* Overwrite the oldest record. */
+			first_seq++;
+			record_cnt--;
 		}
-		memcpy(&entry->meas, &meas, sizeof(meas));
-		sys_slist_append(&database, &entry->node);
+		memcpy(record_get(first_seq + record_cnt), &meas, sizeof(meas));
+		record_cnt++;
 		k_mutex_unlock(&lock);
 		rc = 0;
 	} else {
@@ -469,13 +576,11 @@ int cgms_racp_meas_add(struct cgms_meas meas)
 int cgms_racp_meas_get_latest(struct cgms_meas *meas)
 {
 	int rc;
-	struct cgms_meas_db_entry *entry;
 
 	if (k_mutex_lock(&lock, K_NO_WAIT) == 0) {
-		if (!sys_slist_is_empty(&database)) {
-			entry = CONTAINER_OF(sys_slist_peek_tail(&database),
-				struct cgms_meas_db_entry, node);
-			memcpy(meas, &entry->meas, sizeof(struct cgms_meas));
+		if (record_cnt > 0) {
+			memcpy(meas, record_get(first_seq + record_cnt - 1),
+			       sizeof(struct cgms_meas));
 			rc = 0;
 		} else {
 			rc = -ENODATA;
@@ -490,11 +595,14 @@ int cgms_racp_meas_get_latest(struct cgms_meas *meas)
 
 void cgms_racp_init(void)
 {
-	memset(&cgms_meas_db_entry_pool, 0, sizeof(cgms_meas_db_entry_pool));
-
-	sys_slist_init(&database);
+	memset(records, 0, sizeof(records));
+	first_seq = 0;
+	record_cnt = 0;
 
 	k_mutex_init(&lock);
+	k_sem_init(&record_tx_sem, CONFIG_BT_CGMS_RACP_MAX_PENDING_RECORDS,
+		   CONFIG_BT_CGMS_RACP_MAX_PENDING_RECORDS);
+	atomic_clear(&abort_requested);
 
 	k_work_queue_init(&racp_work_q);
 	k_work_queue_start(&racp_work_q, racp_q_stack_area,
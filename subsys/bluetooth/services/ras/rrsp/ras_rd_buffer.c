@@ -29,6 +29,13 @@ static int8_t tx_power_cache[CONFIG_BT_MAX_CONN];
 static int32_t drop_procedure_counter[CONFIG_BT_MAX_CONN];
 static sys_slist_t callback_list = SYS_SLIST_STATIC_INIT(&callback_list);
 
+static struct {
+	atomic_t overwritten;
+	atomic_t alloc_failed;
+	atomic_t out_of_space;
+	atomic_t aborted;
+} rd_stats;
+
 static void notify_new_rd_stored(struct bt_conn *conn, uint16_t ranging_counter)
 {
 	struct bt_ras_rd_buffer_cb *cb;
@@ -137,6 +144,7 @@ static struct ras_rd_buffer *rd_buffer_alloc(struct bt_conn *conn, uint16_t rang
 	if (available_oldest_buffer != NULL) {
 		if (!available_oldest_buffer->acked) {
 			/* Only notify if the peer has not read the buffer yet. */
+			atomic_inc(&rd_stats.overwritten);
 			notify_rd_overwritten(conn, oldest_ranging_counter);
 		}
 		rd_buffer_free(available_oldest_buffer);
@@ -176,6 +184,7 @@ static bool process_step_data(struct bt_le_cs_subevent_step *step, void *user_da
 		__ASSERT_NO_MSG(conn_index < ARRAY_SIZE(drop_procedure_counter));
 		LOG_ERR("Out of buffer space: attempted to store %u bytes, buffer size: %u",
 			buffer_len, buffer_size);
+		atomic_inc(&rd_stats.out_of_space);
 		drop_procedure_counter[conn_index] = buf->ranging_counter;
 
 		return false;
@@ -205,6 +214,9 @@ static void subevent_data_available(struct bt_conn *conn,
 
 	if (result->header.procedure_done_status == BT_CONN_LE_CS_PROCEDURE_ABORTED) {
 		LOG_DBG("Procedure was aborted.");
+		if (drop_procedure_counter[conn_index] != result->header.procedure_counter) {
+			atomic_inc(&rd_stats.aborted);
+		}
 		drop_procedure_counter[conn_index] = result->header.procedure_counter;
 	}
 
@@ -229,6 +241,7 @@ static void subevent_data_available(struct bt_conn *conn,
 		if (!buf) {
 			LOG_INF("Failed to allocate buffer for procedure %u",
 				result->header.procedure_counter);
+			atomic_inc(&rd_stats.alloc_failed);
 			drop_procedure_counter[conn_index] = result->header.procedure_counter;
 
 			return;
@@ -250,6 +263,7 @@ static void subevent_data_available(struct bt_conn *conn,
 	if (buf->subevent_cursor > buffer_size) {
 		LOG_ERR("Out of buffer space: attempted to store %u bytes, buffer size: %u",
 			buf->subevent_cursor, buffer_size);
+		atomic_inc(&rd_stats.out_of_space);
 		drop_procedure_counter[conn_index] = buf->ranging_counter;
 
 		rd_buffer_free(buf);
@@ -372,3 +386,11 @@ int bt_ras_rd_buffer_bytes_pull(struct ras_rd_buffer *buf, uint8_t *out_buf, uin
 
 	return pull_bytes;
 }
+
+void bt_ras_rd_buffer_stats_get(struct bt_ras_rd_buffer_stats *stats)
+{
+	stats->overwritten = (uint32_t)atomic_get(&rd_stats.overwritten);
+	stats->alloc_failed = (uint32_t)atomic_get(&rd_stats.alloc_failed);
+	stats->out_of_space = (uint32_t)atomic_get(&rd_stats.out_of_space);
+	stats->aborted = (uint32_t)atomic_get(&rd_stats.aborted);
+}
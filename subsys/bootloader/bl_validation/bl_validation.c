@@ -145,6 +145,17 @@ bool bl_validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address)
 #include <zephyr/toolchain.h>
 #include <bl_crypto.h>
 #include "bl_validation_internal.h"
+#if defined(CONFIG_SB_VALIDATION_CACHE)
+#include <string.h>
+#include <zephyr/sys/util.h>
+#include <hw_unique_key.h>
+#if defined(CONFIG_NRFX_NVMC)
+#include <nrfx_nvmc.h>
+#elif defined(CONFIG_NRFX_RRAMC)
+#include <nrfx_rramc.h>
+#endif
+#include "bl_validation_cache.h"
+#endif
 
 /* We keep the S0/S1 nomenclature, regardless of core, but partition S0/S1
  * targets differs. Below configuration, currently, addresses nRF5340
@@ -268,9 +279,10 @@ validation_info_find(uint32_t start_address, uint32_t search_distance)
 }
 
 #if defined(CONFIG_SB_VALIDATE_FW_SIGNATURE)
+/* When fw_hash is not NULL, it is used instead of hashing the firmware. */
 static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_size,
 			       const struct fw_validation_info *fw_val_info,
-			       bool external)
+			       const uint8_t *fw_hash, bool external)
 {
 	int init_retval = bl_crypto_init();
 
@@ -327,11 +339,20 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 			LOG_INF("Hash: 0x%02x...%02x", key_data[0],
 				key_data[SB_PUBLIC_KEY_HASH_LEN-1]);
 		}
-		int retval = rot_verify(fw_val_info->public_key,
-					key_data,
-					fw_val_info->signature,
-					(const uint8_t *)fw_src_address + FIRMWARE_HEADER_SKIP,
-					fw_size - FIRMWARE_HEADER_SKIP);
+		int retval;
+
+		if (IS_ENABLED(CONFIG_SB_VALIDATION_CACHE) && fw_hash) {
+			retval = bl_root_of_trust_verify_hash(fw_val_info->public_key,
+							      key_data,
+							      fw_val_info->signature,
+							      fw_hash);
+		} else {
+			retval = rot_verify(fw_val_info->public_key,
+					    key_data,
+					    fw_val_info->signature,
+					    (const uint8_t *)fw_src_address + FIRMWARE_HEADER_SKIP,
+					    fw_size - FIRMWARE_HEADER_SKIP);
+		}
 
 		if (retval == 0) {
 			for (uint32_t i = 0; i < key_data_idx; i++) {
@@ -377,6 +398,180 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 }
 #endif
 
+#if defined(CONFIG_SB_VALIDATION_CACHE)
+#ifdef HUK_HAS_KMU
+#define VALIDATION_CACHE_KEY_SLOT HUK_KEYSLOT_MKEK
+#else
+#define VALIDATION_CACHE_KEY_SLOT HUK_KEYSLOT_KDR
+#endif
+
+static const uint8_t validation_cache_label[] = "bl_validation_cache";
+
+/* The validated record is placed in the erased space directly after the
+ * validation info, within the slot of the firmware.
+ */
+static const struct bl_validation_record *
+validation_record_find(uint32_t fw_src_address, const struct fw_validation_info *fw_val_info)
+{
+	const uint32_t record_address = ROUND_UP((uint32_t)fw_val_info + sizeof(*fw_val_info), 4);
+	const uint32_t record_end = record_address + sizeof(struct bl_validation_record);
+
+	if (!region_within(record_address, record_end,
+			   fw_src_address, fw_src_address + S0_SIZE)) {
+		return NULL;
+	}
+
+	return (const struct bl_validation_record *)record_address;
+}
+
+static int validation_record_write(const struct bl_validation_record *dst,
+				   const struct bl_validation_record *src)
+{
+	BUILD_ASSERT((sizeof(*src) % sizeof(uint32_t)) == 0);
+
+#if defined(CONFIG_NRFX_NVMC)
+	nrfx_nvmc_words_write((uint32_t)dst, src, sizeof(*src) / sizeof(uint32_t));
+#elif defined(CONFIG_NRFX_RRAMC)
+	/* Write directly, without the write buffer, so that the record can be read back. */
+	nrfx_rramc_write_enable_set(true, 0);
+	nrfx_rramc_words_write((uint32_t)dst, src, sizeof(*src) / sizeof(uint32_t));
+	nrfx_rramc_write_enable_set(false, 0);
+#endif
+
+	if (memcmp(dst, src, sizeof(*src)) != 0) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int validation_counter_get(uint32_t *counter)
+{
+#ifdef CONFIG_SB_MONOTONIC_COUNTER_ROLLBACK_PROTECTION
+	counter_t version;
+	int err = get_monotonic_version(&version);
+
+	if (err) {
+		return err;
+	}
+
+	*counter = version;
+#else
+	*counter = 0;
+#endif
+	return 0;
+}
+
+/* Check that the public key of the firmware has not been invalidated since
+ * the record was created.
+ */
+static bool public_key_trusted(const struct fw_validation_info *fw_val_info)
+{
+	__aligned(4) uint8_t key_data[SB_PUBLIC_KEY_HASH_LEN];
+	uint8_t key_hash[CONFIG_SB_HASH_LEN];
+
+	if (bl_sha256_hash(fw_val_info->public_key, CONFIG_SB_PUBLIC_KEY_LEN, key_hash)) {
+		return false;
+	}
+
+	for (uint32_t key_data_idx = 0; key_data_idx < num_public_keys_read();
+			key_data_idx++) {
+		if (public_key_data_read(key_data_idx, key_data) != SB_PUBLIC_KEY_HASH_LEN) {
+			continue;
+		}
+
+		if (memcmp(key_data, key_hash, SB_PUBLIC_KEY_HASH_LEN) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Skip the signature verification if the firmware matches a validated record
+ * created by an earlier boot. Otherwise validate the signature and create the
+ * record. The firmware hash is computed once and used for both purposes.
+ */
+static bool validate_signature_cached(const uint32_t fw_src_address, const uint32_t fw_size,
+				      const struct fw_validation_info *fw_val_info)
+{
+	const struct bl_validation_record *record =
+		validation_record_find(fw_src_address, fw_val_info);
+	struct bl_validation_binding binding = {
+		.fw_address = fw_src_address,
+		.fw_size = fw_size,
+	};
+	__aligned(4) struct bl_validation_record new_record;
+	uint8_t key[BL_VALIDATION_CACHE_KEY_LEN];
+	bool valid;
+	int err;
+
+	if (!record) {
+		LOG_WRN("No space for the validated record.");
+		return validate_signature(fw_src_address, fw_size, fw_val_info, NULL, false);
+	}
+
+	err = bl_crypto_init();
+	if (err) {
+		LOG_ERR("bl_crypto_init() returned %d.", err);
+		return false;
+	}
+
+	err = validation_counter_get(&binding.counter);
+	if (err) {
+		LOG_ERR("Cannot read the monotonic counter. %d", err);
+		return false;
+	}
+
+	err = bl_sha256_hash((const uint8_t *)fw_src_address + FIRMWARE_HEADER_SKIP,
+			     fw_size - FIRMWARE_HEADER_SKIP, binding.hash);
+	if (err) {
+		LOG_ERR("Firmware hashing failed with error %d.", err);
+		return false;
+	}
+
+	err = hw_unique_key_derive_key(VALIDATION_CACHE_KEY_SLOT, NULL, 0,
+				       validation_cache_label,
+				       sizeof(validation_cache_label) - 1,
+				       key, sizeof(key));
+	if (err != HW_UNIQUE_KEY_SUCCESS) {
+		LOG_WRN("Cannot derive the validated record key: %d.", err);
+		return validate_signature(fw_src_address, fw_size, fw_val_info,
+					  binding.hash, false);
+	}
+
+	if (bl_validation_record_check(key, &binding, record) &&
+	    public_key_trusted(fw_val_info)) {
+		LOG_INF("Firmware matches the validated record.");
+		valid = true;
+		goto out;
+	}
+
+	valid = validate_signature(fw_src_address, fw_size, fw_val_info, binding.hash, false);
+	if (!valid) {
+		goto out;
+	}
+
+	if (!bl_validation_record_is_erased(record)) {
+		LOG_WRN("Validated record location is not erased.");
+		goto out;
+	}
+
+	if (bl_validation_record_create(key, &binding, &new_record) == 0) {
+		if (validation_record_write(record, &new_record) == 0) {
+			LOG_INF("Validated record written.");
+		} else {
+			LOG_ERR("Validated record verification failed.");
+		}
+	}
+
+out:
+	memset(key, 0, sizeof(key));
+
+	return valid;
+}
+#endif /* CONFIG_SB_VALIDATION_CACHE */
+
 #if defined(CONFIG_SB_VALIDATE_FW_HASH) || (defined(CONFIG_SB_LCS_AWARE) && \
     defined(SB_VALIDATION_STRUCT_HAS_HASH))
 static bool validate_hash(const uint32_t fw_src_address, const uint32_t fw_size,
@@ -562,9 +757,14 @@ static bool validate_firmware(uint32_t fw_dst_address, uint32_t fw_src_address,
 		return true;
 #endif /* SB_VALIDATION_STRUCT_HAS_HASH */
 	}
+#endif
+#if defined(CONFIG_SB_VALIDATION_CACHE)
+	if (!external) {
+		return validate_signature_cached(fw_src_address, fwinfo->size, fw_val_info);
+	}
 #endif
 	return validate_signature(fw_src_address, fwinfo->size, fw_val_info,
-				external);
+				NULL, external);
 #elif defined(CONFIG_SB_VALIDATE_FW_HASH)
 	return validate_hash(fw_src_address, fwinfo->size, fw_val_info,
 				external);
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <zephyr/sys/byteorder.h>
+#include <bl_crypto.h>
+#include "bl_validation_cache.h"
+
+#define SHA256_BLOCK_LEN 64
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+/* Serialized binding: address, size and counter followed by the hash. */
+#define BINDING_LEN (3 * sizeof(uint32_t) + BL_VALIDATION_CACHE_HASH_LEN)
+
+BUILD_ASSERT(BL_VALIDATION_CACHE_KEY_LEN <= SHA256_BLOCK_LEN);
+BUILD_ASSERT(BL_VALIDATION_CACHE_MAC_LEN == BL_VALIDATION_CACHE_HASH_LEN);
+
+static int sha256_padded(const uint8_t *key, uint8_t pad, const uint8_t *data, size_t data_len,
+			 uint8_t *hash)
+{
+	uint8_t block[SHA256_BLOCK_LEN];
+	bl_sha256_ctx_t ctx;
+	int err;
+
+	for (size_t i = 0; i < sizeof(block); i++) {
+		block[i] = ((i < BL_VALIDATION_CACHE_KEY_LEN) ? key[i] : 0) ^ pad;
+	}
+
+	err = bl_sha256_init(&ctx);
+	if (!err) {
+		err = bl_sha256_update(&ctx, block, sizeof(block));
+	}
+	if (!err) {
+		err = bl_sha256_update(&ctx, data, data_len);
+	}
+	if (!err) {
+		err = bl_sha256_finalize(&ctx, hash);
+	}
+
+	/* The block contains the key material. */
+	memset(block, 0, sizeof(block));
+
+	return err;
+}
+
+/* HMAC-SHA256 as defined in RFC 2104. */
+static int hmac_sha256(const uint8_t *key, const uint8_t *data, size_t data_len, uint8_t *mac)
+{
+	uint8_t inner[BL_VALIDATION_CACHE_HASH_LEN];
+	int err;
+
+	err = sha256_padded(key, HMAC_IPAD, data, data_len, inner);
+	if (!err) {
+		err = sha256_padded(key, HMAC_OPAD, inner, sizeof(inner), mac);
+	}
+
+	return err;
+}
+
+static int binding_mac(const uint8_t *key, const struct bl_validation_binding *binding,
+		       uint8_t *mac)
+{
+	uint8_t data[BINDING_LEN];
+
+	sys_put_le32(binding->fw_address, &data[0]);
+	sys_put_le32(binding->fw_size, &data[4]);
+	sys_put_le32(binding->counter, &data[8]);
+	memcpy(&data[12], binding->hash, sizeof(binding->hash));
+
+	return hmac_sha256(key, data, sizeof(data), mac);
+}
+
+static bool constant_time_equal(const uint8_t *a, const uint8_t *b, size_t len)
+{
+	uint8_t diff = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		diff |= a[i] ^ b[i];
+	}
+
+	return (diff == 0);
+}
+
+int bl_validation_record_create(const uint8_t *key, const struct bl_validation_binding *binding,
+				struct bl_validation_record *record)
+{
+	if (!key || !binding || !record) {
+		return -EINVAL;
+	}
+
+	record->magic = BL_VALIDATION_CACHE_MAGIC;
+
+	return binding_mac(key, binding, record->mac);
+}
+
+bool bl_validation_record_check(const uint8_t *key, const struct bl_validation_binding *binding,
+				const struct bl_validation_record *record)
+{
+	uint8_t mac[BL_VALIDATION_CACHE_MAC_LEN];
+	bool equal;
+
+	if (!key || !binding || !record) {
+		return false;
+	}
+
+	if (record->magic != BL_VALIDATION_CACHE_MAGIC) {
+		return false;
+	}
+
+	if (binding_mac(key, binding, mac)) {
+		return false;
+	}
+
+	equal = constant_time_equal(mac, record->mac, sizeof(mac));
+	memset(mac, 0, sizeof(mac));
+
+	return equal;
+}
+
+bool bl_validation_record_is_erased(const struct bl_validation_record *record)
+{
+	const uint8_t *data = (const uint8_t *)record;
+
+	for (size_t i = 0; i < sizeof(*record); i++) {
+		if (data[i] != 0xFF) {
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BL_VALIDATION_CACHE_H__
+#define BL_VALIDATION_CACHE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <zephyr/types.h>
+#include <zephyr/toolchain.h>
+
+/* Magic value of a validated record ("BLVC"). */
+#define BL_VALIDATION_CACHE_MAGIC 0x43564c42
+
+#define BL_VALIDATION_CACHE_HASH_LEN 32
+#define BL_VALIDATION_CACHE_KEY_LEN 32
+#define BL_VALIDATION_CACHE_MAC_LEN 32
+
+/* Record stating that the firmware passed the full validation. */
+struct __packed bl_validation_record {
+	uint32_t magic;
+	/* HMAC-SHA256 over the binding, see struct bl_validation_binding. */
+	uint8_t mac[BL_VALIDATION_CACHE_MAC_LEN];
+};
+
+/* Data the record is bound to. */
+struct bl_validation_binding {
+	uint32_t fw_address;
+	uint32_t fw_size;
+	/* Value of the monotonic counter at the time of the validation. */
+	uint32_t counter;
+	/* SHA-256 hash of the signed part of the firmware. */
+	uint8_t hash[BL_VALIDATION_CACHE_HASH_LEN];
+};
+
+/**
+ * @brief Create a validated record.
+ *
+ * @param[in]  key     Key of BL_VALIDATION_CACHE_KEY_LEN bytes used to authenticate the record.
+ * @param[in]  binding Data the record is bound to.
+ * @param[out] record  Created record.
+ *
+ * @return 0 if success, error code otherwise.
+ */
+int bl_validation_record_create(const uint8_t *key, const struct bl_validation_binding *binding,
+				struct bl_validation_record *record);
+
+/**
+ * @brief Check if a validated record matches the given data.
+ *
+ * @param[in] key     Key of BL_VALIDATION_CACHE_KEY_LEN bytes used to authenticate the record.
+ * @param[in] binding Data the record must be bound to.
+ * @param[in] record  Record to check.
+ *
+ * @retval true  The record is authentic and bound to the given data.
+ * @retval false Otherwise.
+ */
+bool bl_validation_record_check(const uint8_t *key, const struct bl_validation_binding *binding,
+				const struct bl_validation_record *record);
+
+/**
+ * @brief Check if a validated record is erased and can be written.
+ *
+ * @param[in] record Record to check.
+ *
+ * @retval true  All bytes of the record are erased.
+ * @retval false Otherwise.
+ */
+bool bl_validation_record_is_erased(const struct bl_validation_record *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BL_VALIDATION_CACHE_H__ */
@@ -10,6 +10,7 @@
 
 #include <caf/events/sensor_event.h>
 #include <caf/events/sensor_data_aggregator_event.h>
+#include <caf/sensor_data_aggregator.h>
 #include <caf/sensor_manager.h>
 
 #define MODULE sensor_data_aggregator
@@ -24,30 +25,34 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_SENSOR_DATA_AGGREGATOR_LOG_LEVEL);
 #define __AGG_BUFFS_NAME(agg_node) DT_CAT3(agg_, agg_node, _buffs)
 
 /* This macros are used only if no memory region is used and the aggregator buffers are created
- * in BSS.
+ * in BSS. The buffers of an aggregator are placed in a single slab, so that the buffer index
+ * can be computed from the samples pointer.
  */
-#define __DATA_BUFF_NAME(agg_node, n) DT_CAT5(agg_, agg_node,  _buff_,  n,  _data)
-#define __DEFINE_DATA(n, agg_node, size)                         \
-	static struct sensor_value __DATA_BUFF_NAME(agg_node, n) \
-		[DIV_ROUND_UP(size, sizeof(struct sensor_value))]
+#define __DATA_BUFF_NAME(agg_node) DT_CAT3(agg_, agg_node, _data)
+#define __DEFINE_DATA(agg_node)                                             \
+	static struct sensor_value __DATA_BUFF_NAME(agg_node)               \
+		[DT_PROP(agg_node, buf_count)]                              \
+		[DIV_ROUND_UP(DT_PROP(agg_node, buf_data_length), sizeof(struct sensor_value))]
 /* End of BSS version only macros. */
 
+#define __FREE_BUFFS_NAME(agg_node) DT_CAT3(agg_, agg_node, _free_buffs)
+
 #define __INITIALIZE_BUFF(n, agg_node)                                                        \
 	COND_CODE_1(DT_NODE_HAS_PROP(agg_node, memory_region),                                \
 		({(struct sensor_value *) (DT_REG_ADDR(DT_PHANDLE(agg_node, memory_region)) + \
 			n * (DT_PROP(agg_node, buf_data_length)))}),                          \
-		({__DATA_BUFF_NAME(agg_node, n)})                                             \
+		({__DATA_BUFF_NAME(agg_node)[n]})                                             \
 	)
 
 #define __XDEFINE_BUF_DATA(agg_node)                                                    \
 	COND_CODE_0(DT_NODE_HAS_PROP(agg_node, memory_region),                          \
-		(LISTIFY(DT_PROP(agg_node, buf_count), __DEFINE_DATA, (;),              \
-			agg_node, DT_PROP(agg_node, buf_data_length));),                \
+		(__DEFINE_DATA(agg_node);),                                             \
 		()                                                                      \
 	)                                                                               \
 	static struct aggregator_buffer __AGG_BUFFS_NAME(agg_node)[] = {                \
 		LISTIFY(DT_PROP(agg_node, buf_count), __INITIALIZE_BUFF, (,), agg_node) \
 	};                                                                              \
+	static uint8_t __FREE_BUFFS_NAME(agg_node)[DT_PROP(agg_node, buf_count)];       \
 	BUILD_ASSERT((DT_PROP(agg_node, buf_data_length) %                              \
 		(DT_PROP(agg_node, sample_size) * sizeof(struct sensor_value))) == 0,   \
 		"Wrong sensor data or buffer size in " DT_NODE_FULL_NAME(agg_node));
@@ -57,15 +62,19 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_SENSOR_DATA_AGGREGATOR_LOG_LEVEL);
 #define __DEFINE_AGGREGATOR(i)                               \
 	[i].sensor_descr = DT_INST_PROP(i, sensor_descr),    \
 	[i].values_in_sample = DT_INST_PROP(i, sample_size), \
+	[i].samples_in_buf = DT_INST_PROP(i, buf_data_length) /                      \
+		(DT_INST_PROP(i, sample_size) * sizeof(struct sensor_value)),        \
 	[i].buf_count = DT_INST_PROP(i, buf_count),          \
 	[i].buf_len = DT_INST_PROP(i, buf_data_length),      \
 	[i].agg_buffers = __AGG_BUFFS_NAME(DT_DRV_INST(i)),  \
+	[i].free_buffers = __FREE_BUFFS_NAME(DT_DRV_INST(i)), \
 	[i].active_buf  = __AGG_BUFFS_NAME(DT_DRV_INST(i)),
 
 
 struct aggregator_buffer {
 	struct sensor_value *samples;	/* Dynamic data. */
-	bool busy;			/* Buffer status. */
+	int64_t first_sample_time;	/* Uptime of the first sample in the buffer. */
+	int64_t last_sample_time;	/* Uptime of the last sample in the buffer. */
 	uint8_t sample_cnt;		/* Number of samples already saved in the buffer. */
 };
 
@@ -73,93 +82,273 @@ struct aggregator {
 	const char *sensor_descr;		/* sensor_description of the sensor. */
 	struct aggregator_buffer *agg_buffers;	/* Buffers. */
 	struct aggregator_buffer *active_buf;	/* Active buffer to which data will be placed. */
+	struct aggregator_buffer *claimed_buf;	/* Buffer with sample slot claimed by producer. */
+	uint8_t *free_buffers;			/* Ring of indices of the free buffers. */
+	uint8_t free_head;			/* Index of the first free buffer in the ring. */
+	uint8_t free_cnt;			/* Number of free buffers. */
 	enum sensor_state sensor_state;		/* Sensors state. */
 	const uint8_t values_in_sample;		/* Number of sensor values in a sample. */
+	const uint8_t samples_in_buf;		/* Number of samples that fit in a buffer. */
 	const uint8_t buf_count;		/* Number of buffers. */
 	const uint8_t buf_len;			/* Size of buffor data in bytes. */
 };
 
+#define AGGREGATOR_CNT DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)
+/* Open addressing lookup table is kept at most half full. */
+#define LOOKUP_SIZE (2 * AGGREGATOR_CNT + 1)
+
 
 DT_INST_FOREACH_STATUS_OKAY(__DEFINE_BUF_DATA) /* no semicolon on purpose. */
 static struct aggregator aggregators[] = {
 	DT_INST_FOREACH_STATUS_OKAY(__DEFINE_AGGREGATOR)
 };
 
+/* Aggregator indices increased by one, 0 marks an empty entry. */
+static uint8_t descr_lookup[LOOKUP_SIZE];
+static atomic_t initialized;
+static struct k_spinlock lock;
 
-static struct aggregator_buffer *get_free_buffer(struct aggregator *agg)
+
+static size_t lookup_hash(const char *sensor_descr)
+{
+	return ((uintptr_t)sensor_descr >> 2) % LOOKUP_SIZE;
+}
+
+static void aggregators_init(void)
 {
-	for (size_t i = 0; i < agg->buf_count; i++) {
-		if (!agg->agg_buffers[i].busy) {
-			return &agg->agg_buffers[i];
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (!atomic_get(&initialized)) {
+		for (size_t i = 0; i < ARRAY_SIZE(aggregators); i++) {
+			struct aggregator *agg = &aggregators[i];
+			size_t pos = lookup_hash(agg->sensor_descr);
+
+			while (descr_lookup[pos] != 0) {
+				pos = (pos + 1) % LOOKUP_SIZE;
+			}
+			descr_lookup[pos] = i + 1;
+
+			/* The first buffer is active. */
+			for (size_t j = 1; j < agg->buf_count; j++) {
+				agg->free_buffers[agg->free_cnt++] = j;
+			}
 		}
+
+		atomic_set(&initialized, true);
 	}
-	return NULL;
+
+	k_spin_unlock(&lock, key);
 }
 
 static struct aggregator *get_aggregator(const char *sensor_descr)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(aggregators); i++) {
-		if (sensor_descr == aggregators[i].sensor_descr) {
-			return &aggregators[i];
+	if (!atomic_get(&initialized)) {
+		aggregators_init();
+	}
+
+	for (size_t pos = lookup_hash(sensor_descr); descr_lookup[pos] != 0;
+	     pos = (pos + 1) % LOOKUP_SIZE) {
+		struct aggregator *agg = &aggregators[descr_lookup[pos] - 1];
+
+		if (sensor_descr == agg->sensor_descr) {
+			return agg;
 		}
 	}
 	return NULL;
 }
 
+/* Must be called with the lock held. */
+static struct aggregator_buffer *get_free_buffer(struct aggregator *agg)
+{
+	if (agg->free_cnt == 0) {
+		return NULL;
+	}
+
+	uint8_t idx = agg->free_buffers[agg->free_head];
+
+	agg->free_head = (agg->free_head + 1) % agg->buf_count;
+	agg->free_cnt--;
+
+	return &agg->agg_buffers[idx];
+}
+
+static struct aggregator_buffer *get_buffer(struct aggregator *agg,
+					    const struct sensor_value *samples)
+{
+	/* Buffers of the aggregator are placed in a single slab. */
+	ptrdiff_t offset = (const uint8_t *)samples - (const uint8_t *)agg->agg_buffers[0].samples;
+	size_t idx = offset / agg->buf_len;
+
+	if ((offset < 0) || (idx >= agg->buf_count) || (agg->agg_buffers[idx].samples != samples)) {
+		return NULL;
+	}
+
+	return &agg->agg_buffers[idx];
+}
+
+/* Must be called with the lock held. */
 static void release_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
 {
 	__ASSERT_NO_MSG(ab);
 
 	ab->sample_cnt = 0;
-	ab->busy = false;
+	ab->first_sample_time = 0;
+	ab->last_sample_time = 0;
 	if (agg->active_buf == NULL) {
 		agg->active_buf = ab;
+	} else {
+		__ASSERT_NO_MSG(agg->free_cnt < agg->buf_count);
+		agg->free_buffers[(agg->free_head + agg->free_cnt) % agg->buf_count] =
+			ab - agg->agg_buffers;
+		agg->free_cnt++;
+	}
+}
+
+/* Take the active buffer to be sent and switch to the next free buffer.
+ * Must be called with the lock held.
+ */
+static struct aggregator_buffer *take_active_buffer(struct aggregator *agg)
+{
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	if (agg->claimed_buf == ab) {
+		/* The sample being written by the producer is dropped. */
+		agg->claimed_buf = NULL;
 	}
+	agg->active_buf = get_free_buffer(agg);
+
+	return ab;
 }
 
-static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
+static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab,
+			enum sensor_state sensor_state)
 {
-	ab->busy = true;
 	struct sensor_data_aggregator_event *event = new_sensor_data_aggregator_event();
+
 	event->values_in_sample = agg->values_in_sample;
 	event->samples = ab->samples;
 	event->sample_cnt = ab->sample_cnt;
-	event->sensor_state = agg->sensor_state;
+	event->first_sample_time = ab->first_sample_time;
+	event->last_sample_time = ab->last_sample_time;
+	event->sensor_state = sensor_state;
 	event->sensor_descr = agg->sensor_descr;
 	APP_EVENT_SUBMIT(event);
 }
 
+/* Store the sample written to the active buffer. Returns the buffer that needs to be sent,
+ * if the active buffer is full. Must be called with the lock held.
+ */
+static struct aggregator_buffer *commit_sample(struct aggregator *agg, int64_t timestamp)
+{
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	if (ab->sample_cnt == 0) {
+		ab->first_sample_time = timestamp;
+	}
+	ab->last_sample_time = timestamp;
+	ab->sample_cnt++;
+
+	if (ab->sample_cnt < agg->samples_in_buf) {
+		return NULL;
+	}
+
+	return take_active_buffer(agg);
+}
+
 static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
 {
 	size_t chunk_bytes = agg->values_in_sample * sizeof(struct sensor_value);
+	struct aggregator_buffer *full_buf;
+	enum sensor_state sensor_state;
 
 	if ((event->dyndata.size) != chunk_bytes) {
 		return -EBADMSG;
 	}
-	if (!agg->active_buf) {
-		return -ENOMEM;
-	}
 
+	k_spinlock_key_t key = k_spin_lock(&lock);
 	struct aggregator_buffer *ab = agg->active_buf;
-	size_t pos_values = ab->sample_cnt * agg->values_in_sample;
-	size_t avail_bytes = agg->buf_len - pos_values * sizeof(struct sensor_value);
 
-	if (avail_bytes < chunk_bytes) {
-		__ASSERT_NO_MSG(false);
+	if (!ab || (agg->claimed_buf == ab)) {
+		k_spin_unlock(&lock, key);
 		return -ENOMEM;
 	}
-	memcpy(&ab->samples[pos_values], (uint8_t *)event->dyndata.data, chunk_bytes);
-	ab->sample_cnt++;
-	avail_bytes -= chunk_bytes;
 
-	if (avail_bytes < chunk_bytes) {
-		send_buffer(agg, ab);
-		agg->active_buf = get_free_buffer(agg);
+	memcpy(&ab->samples[ab->sample_cnt * agg->values_in_sample], event->dyndata.data,
+	       chunk_bytes);
+	full_buf = commit_sample(agg, k_uptime_get());
+	sensor_state = agg->sensor_state;
+	k_spin_unlock(&lock, key);
+
+	if (full_buf) {
+		send_buffer(agg, full_buf, sensor_state);
 	}
 
 	return 0;
 }
 
+struct sensor_value *sensor_data_aggregator_sample_claim(const char *sensor_descr,
+							 size_t value_cnt)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+	struct sensor_value *slot = NULL;
+
+	if (!agg || (value_cnt != agg->values_in_sample)) {
+		return NULL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	__ASSERT(!agg->claimed_buf, "Only one producer per sensor is allowed");
+
+	if (ab) {
+		agg->claimed_buf = ab;
+		slot = &ab->samples[ab->sample_cnt * agg->values_in_sample];
+	} else {
+		LOG_WRN("No free buffer for %s", sensor_descr);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return slot;
+}
+
+void sensor_data_aggregator_sample_commit(const char *sensor_descr, int64_t timestamp)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+	struct aggregator_buffer *full_buf = NULL;
+	enum sensor_state sensor_state;
+
+	__ASSERT_NO_MSG(agg);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* The buffer could be sent because of the sensor state change in the meantime. */
+	if (agg->claimed_buf) {
+		agg->claimed_buf = NULL;
+		full_buf = commit_sample(agg, timestamp);
+	}
+	sensor_state = agg->sensor_state;
+
+	k_spin_unlock(&lock, key);
+
+	if (full_buf) {
+		send_buffer(agg, full_buf, sensor_state);
+	}
+}
+
+void sensor_data_aggregator_sample_abort(const char *sensor_descr)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+
+	__ASSERT_NO_MSG(agg);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	agg->claimed_buf = NULL;
+	k_spin_unlock(&lock, key);
+}
+
 static bool event_handler(const struct app_event_header *aeh)
 {
 	if (is_sensor_event(aeh)) {
@@ -186,11 +375,13 @@ static bool event_handler(const struct app_event_header *aeh)
 
 		__ASSERT_NO_MSG(agg);
 
-		for (size_t i = 0; i < agg->buf_count; i++) {
-			if (agg->agg_buffers[i].samples == event->samples) {
-				release_buffer(agg, &agg->agg_buffers[i]);
-				break;
-			}
+		struct aggregator_buffer *ab = get_buffer(agg, event->samples);
+
+		if (ab) {
+			k_spinlock_key_t key = k_spin_lock(&lock);
+
+			release_buffer(agg, ab);
+			k_spin_unlock(&lock, key);
 		}
 
 		return false;
@@ -201,11 +392,16 @@ static bool event_handler(const struct app_event_header *aeh)
 		struct aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			struct aggregator_buffer *ab = agg->active_buf;
+			k_spinlock_key_t key = k_spin_lock(&lock);
+			struct aggregator_buffer *ab;
 
 			agg->sensor_state = event->state;
-			send_buffer(agg, ab);
-			agg->active_buf = get_free_buffer(agg);
+			ab = take_active_buffer(agg);
+			k_spin_unlock(&lock, key);
+
+			if (ab) {
+				send_buffer(agg, ab, event->state);
+			}
 		}
 
 		return false;
@@ -10,6 +10,7 @@
 
 #include <caf/events/sensor_event.h>
 #include <caf/sensor_manager.h>
+#include <caf/sensor_data_aggregator.h>
 
 #include CONFIG_CAF_SENSOR_MANAGER_DEF_PATH
 
@@ -23,6 +24,15 @@ LOG_MODULE_REGISTER(MODULE, CONFIG_CAF_SENSOR_MANAGER_LOG_LEVEL);
 
 #define SAMPLE_THREAD_STACK_SIZE	CONFIG_CAF_SENSOR_MANAGER_THREAD_STACK_SIZE
 #define SAMPLE_THREAD_PRIORITY		CONFIG_CAF_SENSOR_MANAGER_THREAD_PRIORITY
+#define WORKER_CNT			CONFIG_CAF_SENSOR_MANAGER_WORKER_CNT
+#define WORKER_STACK_SIZE		CONFIG_CAF_SENSOR_MANAGER_WORKER_STACK_SIZE
+#define WORKER_PRIORITY			CONFIG_CAF_SENSOR_MANAGER_WORKER_PRIORITY
+
+#define SENSOR_CNT			ARRAY_SIZE(sensor_configs)
+/* Open addressing lookup tables are kept at most half full. */
+#define LOOKUP_SIZE			(2 * SENSOR_CNT + 1)
+
+BUILD_ASSERT(SENSOR_CNT < UINT8_MAX);
 
 struct sensor_data {
 	int sampling_period;
@@ -31,14 +41,183 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+	/* Position in the deadline heap increased by one, 0 if sensor is not scheduled. */
+	uint8_t heap_pos;
+	atomic_t busy;
 };
 
-static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
+static struct sensor_data sensor_data[SENSOR_CNT];
+
+/* Min-heap of indices of the active sensors ordered by the next sample deadline. */
+static uint8_t sched_heap[SENSOR_CNT];
+static size_t sched_heap_cnt;
+static struct k_spinlock sched_lock;
+
+/* Sensor indices increased by one, 0 marks an empty entry. */
+static uint8_t dev_lookup[LOOKUP_SIZE];
+static uint8_t descr_lookup[LOOKUP_SIZE];
+
+static atomic_t alive_sensors = ATOMIC_INIT(SENSOR_CNT);
 
 static K_THREAD_STACK_DEFINE(sample_thread_stack, SAMPLE_THREAD_STACK_SIZE);
 static struct k_thread sample_thread;
 static struct k_sem can_sample;
 
+#if WORKER_CNT > 0
+struct sample_worker {
+	struct k_thread thread;
+	struct k_msgq queue;
+	uint8_t queue_buf[SENSOR_CNT];
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, WORKER_CNT, WORKER_STACK_SIZE);
+static struct sample_worker workers[WORKER_CNT];
+static uint8_t sensor_worker[SENSOR_CNT];
+#endif /* WORKER_CNT > 0 */
+
+static size_t lookup_hash(const void *key)
+{
+	return ((uintptr_t)key >> 2) % LOOKUP_SIZE;
+}
+
+static void lookup_add(uint8_t *table, const void *key, size_t idx)
+{
+	size_t pos = lookup_hash(key);
+
+	while (table[pos] != 0) {
+		pos = (pos + 1) % LOOKUP_SIZE;
+	}
+
+	table[pos] = idx + 1;
+}
+
+static int lookup_find(const uint8_t *table, const void *key, const void *(*key_get)(size_t))
+{
+	for (size_t pos = lookup_hash(key); table[pos] != 0; pos = (pos + 1) % LOOKUP_SIZE) {
+		size_t idx = table[pos] - 1;
+
+		if (key_get(idx) == key) {
+			return idx;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static const void *dev_key_get(size_t idx)
+{
+	return sensor_configs[idx].dev;
+}
+
+static const void *descr_key_get(size_t idx)
+{
+	return sensor_configs[idx].event_descr;
+}
+
+static void lookup_init(void)
+{
+	/* Entries are added in configuration order, so the first matching sensor is found. */
+	for (size_t i = 0; i < SENSOR_CNT; i++) {
+		lookup_add(dev_lookup, sensor_configs[i].dev, i);
+		lookup_add(descr_lookup, sensor_configs[i].event_descr, i);
+	}
+}
+
+static int get_sensor_idx_by_descr(const char *descr)
+{
+	return lookup_find(descr_lookup, descr, descr_key_get);
+}
+
+static bool sched_before(size_t a, size_t b)
+{
+	return sensor_data[sched_heap[a]].sample_timeout <
+	       sensor_data[sched_heap[b]].sample_timeout;
+}
+
+static void sched_swap(size_t a, size_t b)
+{
+	uint8_t tmp = sched_heap[a];
+
+	sched_heap[a] = sched_heap[b];
+	sched_heap[b] = tmp;
+
+	sensor_data[sched_heap[a]].heap_pos = a + 1;
+	sensor_data[sched_heap[b]].heap_pos = b + 1;
+}
+
+static void sched_sift(size_t pos)
+{
+	while ((pos > 0) && sched_before(pos, (pos - 1) / 2)) {
+		sched_swap(pos, (pos - 1) / 2);
+		pos = (pos - 1) / 2;
+	}
+
+	while (true) {
+		size_t min = pos;
+		size_t left = 2 * pos + 1;
+		size_t right = left + 1;
+
+		if ((left < sched_heap_cnt) && sched_before(left, min)) {
+			min = left;
+		}
+		if ((right < sched_heap_cnt) && sched_before(right, min)) {
+			min = right;
+		}
+		if (min == pos) {
+			break;
+		}
+
+		sched_swap(pos, min);
+		pos = min;
+	}
+}
+
+/* Set the next sample deadline of the sensor and schedule it if needed.
+ * Must be called with sched_lock held.
+ */
+static void sched_set(size_t idx, int64_t deadline)
+{
+	struct sensor_data *sd = &sensor_data[idx];
+
+	sd->sample_timeout = deadline;
+
+	if (sd->heap_pos == 0) {
+		sched_heap[sched_heap_cnt] = idx;
+		sched_heap_cnt++;
+		sd->heap_pos = sched_heap_cnt;
+	}
+
+	sched_sift(sd->heap_pos - 1);
+}
+
+/* Must be called with sched_lock held. */
+static void sched_remove(size_t idx)
+{
+	struct sensor_data *sd = &sensor_data[idx];
+	size_t pos = sd->heap_pos;
+
+	if (pos == 0) {
+		return;
+	}
+
+	pos--;
+	sd->heap_pos = 0;
+	sched_heap_cnt--;
+
+	if (pos != sched_heap_cnt) {
+		sched_heap[pos] = sched_heap[sched_heap_cnt];
+		sensor_data[sched_heap[pos]].heap_pos = pos + 1;
+		sched_sift(pos);
+	}
+}
+
+static void schedule_sensor(struct sensor_data *sd, int64_t deadline)
+{
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
+
+	sched_set(sd - sensor_data, deadline);
+	k_spin_unlock(&sched_lock, key);
+}
 
 static void update_sensor_state(const struct sm_sensor_config *sc, struct sensor_data *sd,
 				const enum sensor_state state)
@@ -48,7 +227,18 @@ static void update_sensor_state(const struct sm_sensor_config *sc, struct sensor
 	event->descr = sc->event_descr;
 	event->state = state;
 
-	atomic_set(&sd->state, state);
+	if (state != SENSOR_STATE_ACTIVE) {
+		k_spinlock_key_t key = k_spin_lock(&sched_lock);
+
+		sched_remove(sd - sensor_data);
+		k_spin_unlock(&sched_lock, key);
+	}
+
+	if ((atomic_set(&sd->state, state) != SENSOR_STATE_ERROR) &&
+	    (state == SENSOR_STATE_ERROR)) {
+		atomic_dec(&alive_sensors);
+	}
+
 	APP_EVENT_SUBMIT(event);
 }
 
@@ -69,29 +259,21 @@ static void send_sensor_event(const char *descr, const struct sensor_value *data
 
 static struct sensor_data *get_sensor_data(const struct device *dev)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
-		if (dev == sensor_configs[i].dev) {
-			/* sensor_configs indices match sensor_data ones */
-			return &sensor_data[i];
-		}
-	}
+	int idx = lookup_find(dev_lookup, dev, dev_key_get);
 
-	__ASSERT_NO_MSG(false);
+	__ASSERT_NO_MSG(idx >= 0);
 
-	return NULL;
+	/* sensor_configs indices match sensor_data ones */
+	return (idx >= 0) ? &sensor_data[idx] : NULL;
 }
 
 static const struct sm_sensor_config *get_sensor_config(const struct device *dev)
 {
-	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
-		if (dev == sensor_configs[i].dev) {
-			return &sensor_configs[i];
-		}
-	}
+	int idx = lookup_find(dev_lookup, dev, dev_key_get);
 
-	__ASSERT_NO_MSG(false);
+	__ASSERT_NO_MSG(idx >= 0);
 
-	return NULL;
+	return (idx >= 0) ? &sensor_configs[idx] : NULL;
 }
 
 static size_t get_sensor_data_cnt(const struct sm_sensor_config *sc)
@@ -167,11 +349,11 @@ static bool is_sensor_active(const struct sensor_data *sd)
 
 static void sensor_wake_up_post(const struct sm_sensor_config *sc, struct sensor_data *sd)
 {
-	sd->sample_timeout = k_uptime_get();
 	if (sc->trigger) {
 		reset_sensor_sleep_cnt(sc, sd);
 	}
 	update_sensor_state(sc, sd, SENSOR_STATE_ACTIVE);
+	schedule_sensor(sd, k_uptime_get());
 }
 
 static void trigger_handler(const struct device *dev, const struct sensor_trigger *trigger)
@@ -219,7 +401,23 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 {
 	size_t data_idx = 0;
 	size_t data_cnt = get_sensor_data_cnt(sc);
-	struct sensor_value data[data_cnt];
+	struct sensor_value local_data[data_cnt];
+	struct sensor_value *data = NULL;
+
+	/* Sensor could be put to sleep after the sample was dispatched. */
+	if (atomic_get(&sd->state) != SENSOR_STATE_ACTIVE) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT)) {
+		data = sensor_data_aggregator_sample_claim(sc->event_descr, data_cnt);
+	}
+
+	bool direct = (data != NULL);
+
+	if (!direct) {
+		data = local_data;
+	}
 
 	int err = sensor_sample_fetch(sc->dev);
 
@@ -231,65 +429,144 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 	}
 
 	if (err) {
+		if (direct) {
+			sensor_data_aggregator_sample_abort(sc->event_descr);
+		}
 		LOG_ERR("Sensor sampling error (err %d)", err);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
 	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
-					  &sd->event_cnt);
+		bool process_activity = sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM);
+
+		/* Data written directly to the aggregator must not be accessed after commit. */
+		if (process_activity) {
+			process_sensor_activity(sc, sd, data);
+		}
+
+		if (direct) {
+			sensor_data_aggregator_sample_commit(sc->event_descr, k_uptime_get());
+		} else if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+			send_sensor_event(sc->event_descr, data, data_cnt, &sd->event_cnt);
 		} else {
 			LOG_WRN("Did not send event due to too many active events on sensor: %s",
 				sc->dev->name);
 		}
 
-		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
-			process_sensor_activity(sc, sd, data);
-			if (!is_sensor_active(sd)) {
-				enter_sleep(sc, sd);
-			}
-
+		if (process_activity && !is_sensor_active(sd)) {
+			enter_sleep(sc, sd);
 		}
 	}
 }
 
-static size_t sample_sensors(int64_t *next_timeout)
+#if WORKER_CNT > 0
+static void worker_fn(void *p1, void *p2, void *p3)
 {
-	size_t alive_sensors = 0;
-	int64_t cur_uptime = k_uptime_get();
+	struct sample_worker *w = p1;
+	uint8_t idx;
 
-	*next_timeout = INT64_MAX;
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
 
-	for (size_t i = 0; i < ARRAY_SIZE(sensor_data); i++) {
-		struct sensor_data *sd = &sensor_data[i];
-		const struct sm_sensor_config *sc = &sensor_configs[i];
+	while (true) {
+		int err = k_msgq_get(&w->queue, &idx, K_FOREVER);
 
-		if (atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) {
-			if (sd->sample_timeout <= cur_uptime) {
-				sample_sensor(sd, sc);
-			}
+		__ASSERT_NO_MSG(!err);
+		ARG_UNUSED(err);
 
-			int drops = -1;
-			while (sd->sample_timeout <= cur_uptime) {
-				sd->sample_timeout += sd->sampling_period;
-				drops++;
-			}
+		sample_sensor(&sensor_data[idx], &sensor_configs[idx]);
+		atomic_clear(&sensor_data[idx].busy);
+	}
+}
+
+static void workers_init(void)
+{
+	size_t next_worker = 0;
+
+	/* Sensors on the same bus are assigned to the same worker, because the bus
+	 * transfers are serialized anyway. Other sensors are distributed evenly.
+	 */
+	for (size_t i = 0; i < SENSOR_CNT; i++) {
+		const struct device *bus = sensor_configs[i].bus;
+		size_t j;
 
-			if (drops > 0) {
-				LOG_WRN("%d sample dropped", drops);
+		for (j = 0; (bus != NULL) && (j < i); j++) {
+			if (sensor_configs[j].bus == bus) {
+				break;
 			}
 		}
 
-		if (atomic_get(&sd->state) != SENSOR_STATE_ERROR) {
-			alive_sensors++;
-			if (atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) {
-				if (*next_timeout > sd->sample_timeout) {
-					*next_timeout = sd->sample_timeout;
-				}
-			}
+		if ((bus != NULL) && (j < i)) {
+			sensor_worker[i] = sensor_worker[j];
+		} else {
+			sensor_worker[i] = next_worker;
+			next_worker = (next_worker + 1) % WORKER_CNT;
 		}
 	}
 
-	return alive_sensors;
+	for (size_t i = 0; i < WORKER_CNT; i++) {
+		struct sample_worker *w = &workers[i];
+
+		k_msgq_init(&w->queue, w->queue_buf, sizeof(w->queue_buf[0]),
+			    ARRAY_SIZE(w->queue_buf));
+		k_thread_create(&w->thread, worker_stacks[i], K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_fn, w, NULL, NULL, WORKER_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&w->thread, "caf_sensor_worker");
+	}
+}
+#endif /* WORKER_CNT > 0 */
+
+static void sample_dispatch(size_t idx)
+{
+#if WORKER_CNT > 0
+	struct sensor_data *sd = &sensor_data[idx];
+	uint8_t msg = idx;
+
+	if (!atomic_cas(&sd->busy, 0, 1)) {
+		LOG_WRN("Sensor %s busy, sample dropped", sensor_configs[idx].dev->name);
+		return;
+	}
+
+	/* Queue can hold all the sensors and a busy sensor is never queued twice. */
+	int err = k_msgq_put(&workers[sensor_worker[idx]].queue, &msg, K_NO_WAIT);
+
+	__ASSERT_NO_MSG(!err);
+	ARG_UNUSED(err);
+#else
+	sample_sensor(&sensor_data[idx], &sensor_configs[idx]);
+#endif /* WORKER_CNT > 0 */
+}
+
+static int64_t sample_sensors(void)
+{
+	int64_t cur_uptime = k_uptime_get();
+
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&sched_lock);
+
+		if (sched_heap_cnt == 0) {
+			k_spin_unlock(&sched_lock, key);
+			return INT64_MAX;
+		}
+
+		size_t idx = sched_heap[0];
+		struct sensor_data *sd = &sensor_data[idx];
+		int64_t sample_timeout = sd->sample_timeout;
+
+		if (sample_timeout > cur_uptime) {
+			k_spin_unlock(&sched_lock, key);
+			return sample_timeout;
+		}
+
+		int drops = (cur_uptime - sample_timeout) / sd->sampling_period;
+
+		sched_set(idx, sample_timeout + (drops + 1) * sd->sampling_period);
+		k_spin_unlock(&sched_lock, key);
+
+		if (drops > 0) {
+			LOG_WRN("%d sample dropped", drops);
+		}
+
+		sample_dispatch(idx);
+	}
 }
 
 static int sensor_trigger_init(const struct sm_sensor_config *sc, struct sensor_data *sd)
@@ -373,9 +650,8 @@ static void configure_max_power_state(void)
 	}
 }
 
-static size_t sensor_init(void)
+static bool sensor_init(void)
 {
-	size_t alive_sensors = 0;
 	int64_t cur_uptime = k_uptime_get();
 
 	for (size_t i = 0; i < ARRAY_SIZE(sensor_data); i++) {
@@ -388,7 +664,6 @@ static size_t sensor_init(void)
 			continue;
 		}
 		sd->sampling_period = sc->sampling_period_ms;
-		sd->sample_timeout = cur_uptime + sc->sampling_period_ms;
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
 			int err = sensor_trigger_init(sc, sd);
@@ -401,28 +676,29 @@ static size_t sensor_init(void)
 		}
 
 		update_sensor_state(sc, sd, SENSOR_STATE_ACTIVE);
-		alive_sensors++;
+		schedule_sensor(sd, cur_uptime + sc->sampling_period_ms);
 	}
 
-	return alive_sensors;
+	return atomic_get(&alive_sensors) > 0;
 }
 
 static void sample_thread_fn(void)
 {
-	size_t alive_sensors = 0;
 	int64_t next_timeout = 0;
 
 	k_sem_init(&can_sample, 0, 1);
 
-	alive_sensors = sensor_init();
+#if WORKER_CNT > 0
+	workers_init();
+#endif
 
-	if (alive_sensors) {
+	if (sensor_init()) {
 		module_set_state(MODULE_STATE_READY);
 
-		while (alive_sensors > 0) {
+		while (atomic_get(&alive_sensors) > 0) {
 			k_sem_take(&can_sample, K_TIMEOUT_ABS_MS(next_timeout));
 
-			alive_sensors = sample_sensors(&next_timeout);
+			next_timeout = sample_sensors();
 			configure_max_power_state();
 		}
 	}
@@ -432,6 +708,8 @@ static void sample_thread_fn(void)
 
 static void init(void)
 {
+	lookup_init();
+
 	k_thread_create(&sample_thread, sample_thread_stack, SAMPLE_THREAD_STACK_SIZE,
 			(k_thread_entry_t)sample_thread_fn, NULL, NULL, NULL,
 			SAMPLE_THREAD_PRIORITY, 0, K_NO_WAIT);
@@ -510,15 +788,13 @@ static bool handle_wake_up_event(const struct app_event_header *aeh)
 static bool handle_sensor_event(const struct app_event_header *aeh)
 {
 	const struct sensor_event *event = cast_sensor_event(aeh);
+	int idx = get_sensor_idx_by_descr(event->descr);
 
-	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
-		if (event->descr == sensor_configs[i].event_descr) {
-			struct sensor_data *sd = &sensor_data[i];
+	if (idx >= 0) {
+		struct sensor_data *sd = &sensor_data[idx];
 
-			atomic_dec(&sd->event_cnt);
-			__ASSERT_NO_MSG(!(atomic_get(&sd->event_cnt) < 0));
-			return false;
-		}
+		atomic_dec(&sd->event_cnt);
+		__ASSERT_NO_MSG(!(atomic_get(&sd->event_cnt) < 0));
 	}
 
 	return false;
@@ -527,20 +803,23 @@ static bool handle_sensor_event(const struct app_event_header *aeh)
 static bool handle_set_sensor_period_event(const struct app_event_header *aeh)
 {
 	const struct set_sensor_period_event *event = cast_set_sensor_period_event(aeh);
+	int idx = get_sensor_idx_by_descr(event->descr);
 
-	for (size_t i = 0; i < ARRAY_SIZE(sensor_data); i++) {
-		const struct sm_sensor_config *sc = &sensor_configs[i];
-
-		if (event->descr == sc->event_descr) {
-			struct sensor_data *sd = &sensor_data[i];
+	if (idx >= 0) {
+		struct sensor_data *sd = &sensor_data[idx];
+		int64_t deadline = k_uptime_get() + event->sampling_period;
+		k_spinlock_key_t key = k_spin_lock(&sched_lock);
 
-			sd->sampling_period = event->sampling_period;
-			sd->sample_timeout = k_uptime_get() + event->sampling_period;
-			if (sd->state == SENSOR_STATE_ACTIVE) {
-				k_sem_give(&can_sample);
-			}
+		sd->sampling_period = event->sampling_period;
+		if (sd->heap_pos != 0) {
+			sched_set(idx, deadline);
+		} else {
+			sd->sample_timeout = deadline;
+		}
+		k_spin_unlock(&sched_lock, key);
 
-			break;
+		if (atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) {
+			k_sem_give(&can_sample);
 		}
 	}
 
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <debug/cpu_load.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/shell/shell.h>
+#include <tracing_user.h>
+
+#ifdef CONFIG_CPU_CORTEX_M
+#include <cmsis_core.h>
+#endif
+
+#define WINDOW_COUNT CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_COUNT
+/* One additional window is being filled while the complete windows are reported. */
+#define BUCKET_COUNT (WINDOW_COUNT + 1)
+#define THREADS_MAX CONFIG_NRF_CPU_LOAD_CONTEXT_THREADS_MAX
+#define IRQ_UNKNOWN CONFIG_NUM_IRQS
+#define ISR_NESTING_MAX 8
+
+struct context_slot {
+	const struct k_thread *thread;
+	uint32_t cycles[BUCKET_COUNT];
+};
+
+/* Threads are added to the table when they are switched in for the first time. */
+static struct context_slot thread_slots[THREADS_MAX];
+static struct context_slot other_threads_slot;
+/* The last slot accounts the interrupts that could not be identified. */
+static struct context_slot isr_slots[CONFIG_NUM_IRQS + 1];
+
+static struct context_slot *current_slot;
+static struct context_slot *interrupted_slot[ISR_NESTING_MAX];
+/* The nesting level reported to the hooks by the architecture is not reliable, for example
+ * it is always 0 on Cortex-M. Track it here instead.
+ */
+static uint8_t isr_depth;
+static uint32_t last_cycles;
+
+static uint32_t bucket_cycles[BUCKET_COUNT];
+static uint32_t bucket_start;
+static uint8_t bucket;
+/* Incremented whenever the windows are moved, used to detect a concurrent update. */
+static volatile uint32_t window_seq;
+
+static bool ready;
+static struct k_timer window_timer;
+
+static inline uint32_t cycles_get(void)
+{
+#ifdef CONFIG_NRF_CPU_LOAD_CONTEXT_DWT
+	return DWT->CYCCNT;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static int current_irq_get(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M)
+	/* Exception numbers below 16 are not interrupt lines. */
+	return (int)__get_IPSR() - 16;
+#elif defined(CONFIG_ARCH_POSIX)
+	extern int posix_get_current_irq(void);
+
+	return posix_get_current_irq();
+#else
+	return -1;
+#endif
+}
+
+static struct context_slot *thread_slot_get(const struct k_thread *thread)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(thread_slots); i++) {
+		if (thread_slots[i].thread == thread) {
+			return &thread_slots[i];
+		}
+
+		if (thread_slots[i].thread == NULL) {
+			thread_slots[i].thread = thread;
+			return &thread_slots[i];
+		}
+	}
+
+	return &other_threads_slot;
+}
+
+static struct context_slot *isr_slot_get(void)
+{
+	int irq = current_irq_get();
+
+	if ((irq < 0) || (irq >= CONFIG_NUM_IRQS)) {
+		irq = IRQ_UNKNOWN;
+	}
+
+	return &isr_slots[irq];
+}
+
+/* Account the cycles elapsed since the last call to the current context.
+ * Must be called with interrupts locked.
+ */
+static uint32_t account(void)
+{
+	uint32_t now = cycles_get();
+
+	current_slot->cycles[bucket] += now - last_cycles;
+	last_cycles = now;
+
+	return now;
+}
+
+/* The tracing_user hooks are called with interrupts locked. */
+void sys_trace_thread_switched_out_user(void)
+{
+	if (ready) {
+		(void)account();
+	}
+}
+
+void sys_trace_thread_switched_in_user(void)
+{
+	if (ready) {
+		(void)account();
+		current_slot = thread_slot_get(k_current_get());
+	}
+}
+
+void sys_trace_isr_enter_user(int nested_interrupts)
+{
+	ARG_UNUSED(nested_interrupts);
+
+	if (!ready) {
+		return;
+	}
+
+	(void)account();
+
+	/* Interrupts nested deeper than the limit are accounted to the outer interrupt. */
+	if (isr_depth < ISR_NESTING_MAX) {
+		interrupted_slot[isr_depth] = current_slot;
+		current_slot = isr_slot_get();
+	}
+
+	isr_depth++;
+}
+
+void sys_trace_isr_exit_user(int nested_interrupts)
+{
+	ARG_UNUSED(nested_interrupts);
+
+	if (!ready) {
+		return;
+	}
+
+	(void)account();
+
+	/* The interrupt could have been entered before the module was ready. */
+	if (isr_depth == 0) {
+		return;
+	}
+
+	isr_depth--;
+
+	if (isr_depth < ISR_NESTING_MAX) {
+		current_slot = interrupted_slot[isr_depth];
+	}
+}
+
+static void bucket_clear(struct context_slot *slots, size_t cnt, uint8_t idx)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		slots[i].cycles[idx] = 0;
+	}
+}
+
+static void window_timer_handler(struct k_timer *timer)
+{
+	unsigned int key = irq_lock();
+	uint32_t now = account();
+
+	bucket_cycles[bucket] = now - bucket_start;
+	bucket_start = now;
+	bucket = (bucket + 1) % BUCKET_COUNT;
+
+	bucket_clear(thread_slots, ARRAY_SIZE(thread_slots), bucket);
+	bucket_clear(&other_threads_slot, 1, bucket);
+	bucket_clear(isr_slots, ARRAY_SIZE(isr_slots), bucket);
+	window_seq++;
+
+	irq_unlock(key);
+}
+
+static uint32_t complete_cycles_get(const uint32_t *cycles, uint8_t current)
+{
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < BUCKET_COUNT; i++) {
+		if (i != current) {
+			sum += cycles[i];
+		}
+	}
+
+	return sum;
+}
+
+static size_t context_add(struct cpu_load_context *ctx, size_t ctx_cnt, size_t idx,
+			  const struct context_slot *slot, enum cpu_load_context_type type,
+			  int irq, uint8_t current)
+{
+	uint32_t cycles = complete_cycles_get(slot->cycles, current);
+
+	if ((cycles == 0) || (idx >= ctx_cnt)) {
+		return idx;
+	}
+
+	ctx[idx].type = type;
+	ctx[idx].thread = slot->thread;
+	ctx[idx].irq = irq;
+	ctx[idx].cycles = cycles;
+
+	return idx + 1;
+}
+
+int cpu_load_context_get(struct cpu_load_context *ctx, size_t ctx_cnt, uint32_t *window_cycles)
+{
+	uint32_t seq;
+	size_t cnt;
+
+	if (!ready) {
+		return -ENODEV;
+	}
+
+	/* Complete windows change only when the windows are moved. Retry if it happened
+	 * while the results were being collected instead of locking interrupts.
+	 */
+	do {
+		uint8_t current;
+
+		seq = window_seq;
+		current = bucket;
+		cnt = 0;
+
+		for (size_t i = 0; i < ARRAY_SIZE(thread_slots); i++) {
+			cnt = context_add(ctx, ctx_cnt, cnt, &thread_slots[i],
+					  CPU_LOAD_CONTEXT_THREAD, -1, current);
+		}
+
+		cnt = context_add(ctx, ctx_cnt, cnt, &other_threads_slot, CPU_LOAD_CONTEXT_THREAD,
+				  -1, current);
+
+		for (size_t i = 0; i < ARRAY_SIZE(isr_slots); i++) {
+			int irq = (i == IRQ_UNKNOWN) ? -1 : (int)i;
+
+			cnt = context_add(ctx, ctx_cnt, cnt, &isr_slots[i], CPU_LOAD_CONTEXT_ISR,
+					  irq, current);
+		}
+
+		*window_cycles = complete_cycles_get(bucket_cycles, current);
+	} while (seq != window_seq);
+
+	return cnt;
+}
+
+static int cpu_load_context_init(void)
+{
+	unsigned int key;
+
+#ifdef CONFIG_NRF_CPU_LOAD_CONTEXT_DWT
+#if defined(DCB)
+	DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+#else
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#endif
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	key = irq_lock();
+	current_slot = thread_slot_get(k_current_get());
+	last_cycles = cycles_get();
+	bucket_start = last_cycles;
+	ready = true;
+	irq_unlock(key);
+
+	k_timer_init(&window_timer, window_timer_handler, NULL);
+	k_timer_start(&window_timer, K_MSEC(CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_MS),
+		      K_MSEC(CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_MS));
+
+	return 0;
+}
+
+SYS_INIT(cpu_load_context_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#ifdef CONFIG_NRF_CPU_LOAD_CONTEXT_CMDS
+static int cmd_cpu_load_context(const struct shell *shell, size_t argc, char **argv)
+{
+	static struct cpu_load_context ctx[THREADS_MAX + CONFIG_NUM_IRQS + 2];
+	uint32_t window_cycles;
+	int cnt;
+
+	cnt = cpu_load_context_get(ctx, ARRAY_SIZE(ctx), &window_cycles);
+	if (cnt < 0) {
+		shell_error(shell, "Not initialized.");
+		return 0;
+	}
+
+	if (window_cycles == 0) {
+		shell_print(shell, "No complete measurement window.");
+		return 0;
+	}
+
+	for (int i = 0; i < cnt; i++) {
+		/* Load in 0,001% units, as returned by cpu_load_get. */
+		uint32_t load = (uint32_t)(((uint64_t)ctx[i].cycles * 100000) / window_cycles);
+
+		if (ctx[i].type == CPU_LOAD_CONTEXT_ISR) {
+			shell_print(shell, "ISR %d: %d,%03d%%", ctx[i].irq, load / 1000,
+				    load % 1000);
+		} else if (ctx[i].thread == NULL) {
+			shell_print(shell, "Other threads: %d,%03d%%", load / 1000, load % 1000);
+		} else {
+			const char *name = k_thread_name_get((k_tid_t)ctx[i].thread);
+
+			shell_print(shell, "Thread %p %s: %d,%03d%%", (void *)ctx[i].thread,
+				    (name != NULL) ? name : "", load / 1000, load % 1000);
+		}
+	}
+
+	return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(cpu_load_context, NULL, "CPU load of threads and interrupts",
+		       cmd_cpu_load_context, 1, 0);
+#endif /* CONFIG_NRF_CPU_LOAD_CONTEXT_CMDS */
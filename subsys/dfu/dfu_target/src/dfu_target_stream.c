@@ -24,6 +24,8 @@ static const char *current_id;
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
 
 static char current_name_key[32];
+static size_t progress_stored_bytes;
+static int64_t progress_stored_time;
 
 /**
  * @brief Store the information stored in the stream_flash instance so that it
@@ -42,9 +44,40 @@ static int store_progress(void)
 		return err;
 	}
 
+	progress_stored_bytes = bytes_written;
+	progress_stored_time = k_uptime_get();
+
 	return 0;
 }
 
+/**
+ * @brief Store the progress if it changed and the configured interval has passed.
+ */
+static int store_progress_throttled(void)
+{
+	size_t bytes_written = stream_flash_bytes_written(&stream);
+
+	if (bytes_written == progress_stored_bytes) {
+		return 0;
+	}
+
+	if ((CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES > 0) ||
+	    (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS > 0)) {
+		bool bytes_passed = (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES > 0) &&
+			(bytes_written - progress_stored_bytes >=
+			 CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES);
+		bool time_passed = (CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS > 0) &&
+			(k_uptime_get() - progress_stored_time >=
+			 CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_MS);
+
+		if (!bytes_passed && !time_passed) {
+			return 0;
+		}
+	}
+
+	return store_progress();
+}
+
 /**
  * @brief Function used by settings_load() to restore the stream_flash ctx.
  *	  See the Zephyr documentation of the settings subsystem for more
@@ -98,8 +131,206 @@ SETTINGS_STATIC_HANDLER_DEFINE(dfu_target, MODULE, NULL, settings_set,
 
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
+/**
+ * @brief Write a chunk to the stream.
+ */
+static int stream_write(const uint8_t *buf, size_t len)
+{
+#ifdef CONFIG_DFU_TARGET_STREAM_SYNCHRONOUS
+	/**
+	 * Flush immediately.
+	 * This may be necessary in scenarios where the server
+	 * cannot retransmit data that has already been ack-ed.
+	 * by the device. Without flushing, if an unaligned write
+	 * occurred prior to a reboot, some bytes that were already
+	 * sent to the device would need to be retransmitted.
+	 * This will lead to issues on the server side in the
+	 * described case, as the server would need to retransmit
+	 * already ack-ed data.
+	 */
+	int err = stream_flash_buffered_write(&stream, buf, len, true);
+#else
+	int err = stream_flash_buffered_write(&stream, buf, len, false);
+#endif
+
+	if (err != 0) {
+		LOG_ERR("stream_flash_buffered_write error %d", err);
+	}
+
+	return err;
+}
+
+/**
+ * @brief Store the progress after a chunk was written to the stream, if needed.
+ */
+static int progress_update(void)
+{
+	int err = 0;
+
+#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+	err = store_progress_throttled();
+	if (err != 0) {
+		/* Failing to store progress is not a critical error you'll just
+		 * be left to download a bit more if you fail and resume.
+		 */
+		LOG_WRN("Unable to store write progress: %d", err);
+	}
+#endif
+
+	return err;
+}
+
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+
+#define ASYNC_BUF_NONE UINT8_MAX
+
+struct async_buf {
+	size_t len;
+	uint8_t data[CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_SIZE];
+};
+
+static struct async_buf async_bufs[CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_COUNT];
+/* Index of the buffer that is being filled by dfu_target_stream_write. */
+static uint8_t async_fill_idx = ASYNC_BUF_NONE;
+/* First error reported by the background writer, reset by init. */
+static atomic_t async_err;
+
+K_MSGQ_DEFINE(async_free_msgq, sizeof(uint8_t), CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_COUNT, 1);
+K_MSGQ_DEFINE(async_write_msgq, sizeof(uint8_t), CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_COUNT, 1);
+
+static void async_writer_thread_fn(void)
+{
+	uint8_t idx;
+
+	for (;;) {
+		(void)k_msgq_get(&async_write_msgq, &idx, K_FOREVER);
+
+		/* Once a write failed, drop the remaining data until the stream is
+		 * finished or reset.
+		 */
+		if (atomic_get(&async_err) == 0) {
+			int err = stream_write(async_bufs[idx].data, async_bufs[idx].len);
+
+			if (err != 0) {
+				(void)atomic_cas(&async_err, 0, err);
+			} else {
+				/* Progress store errors do not affect the image data. */
+				(void)progress_update();
+			}
+		}
+
+		async_bufs[idx].len = 0;
+		(void)k_msgq_put(&async_free_msgq, &idx, K_NO_WAIT);
+	}
+}
+
+K_THREAD_DEFINE(dfu_target_stream_writer, CONFIG_DFU_TARGET_STREAM_ASYNC_STACK_SIZE,
+		async_writer_thread_fn, NULL, NULL, NULL,
+		K_PRIO_PREEMPT(CONFIG_DFU_TARGET_STREAM_ASYNC_THREAD_PRIO), 0, 0);
+
+/* The free queue is filled before the first use, so that draining the stream never blocks even
+ * if it was not initialized.
+ */
+static int async_bufs_init(void)
+{
+	for (uint8_t i = 0; i < ARRAY_SIZE(async_bufs); i++) {
+		(void)k_msgq_put(&async_free_msgq, &i, K_NO_WAIT);
+	}
+
+	return 0;
+}
+
+SYS_INIT(async_bufs_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
+
+static void async_init(void)
+{
+	atomic_set(&async_err, 0);
+}
+
+static void async_fill_submit(void)
+{
+	if (async_fill_idx == ASYNC_BUF_NONE) {
+		return;
+	}
+
+	if (async_bufs[async_fill_idx].len > 0) {
+		(void)k_msgq_put(&async_write_msgq, &async_fill_idx, K_NO_WAIT);
+	} else {
+		(void)k_msgq_put(&async_free_msgq, &async_fill_idx, K_NO_WAIT);
+	}
+
+	async_fill_idx = ASYNC_BUF_NONE;
+}
+
+/**
+ * @brief Wait until all buffered data has been passed to the stream.
+ *
+ * @return The error reported by the background writer, if any.
+ */
+static int async_drain(void)
+{
+	uint8_t idx[CONFIG_DFU_TARGET_STREAM_ASYNC_BUF_COUNT];
+
+	async_fill_submit();
+
+	/* All buffers are returned to the free queue once processed. */
+	for (size_t i = 0; i < ARRAY_SIZE(idx); i++) {
+		(void)k_msgq_get(&async_free_msgq, &idx[i], K_FOREVER);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(idx); i++) {
+		(void)k_msgq_put(&async_free_msgq, &idx[i], K_NO_WAIT);
+	}
+
+	return atomic_get(&async_err);
+}
+
+static int async_write(const uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		int err = atomic_get(&async_err);
+
+		if (err != 0) {
+			return err;
+		}
+
+		if (async_fill_idx == ASYNC_BUF_NONE) {
+			(void)k_msgq_get(&async_free_msgq, &async_fill_idx, K_FOREVER);
+		}
+
+		struct async_buf *ab = &async_bufs[async_fill_idx];
+		size_t cpy_len = MIN(len, sizeof(ab->data) - ab->len);
+
+		memcpy(&ab->data[ab->len], buf, cpy_len);
+		ab->len += cpy_len;
+		buf += cpy_len;
+		len -= cpy_len;
+
+		if (ab->len == sizeof(ab->data)) {
+			async_fill_submit();
+		}
+	}
+
+	return 0;
+}
+
+#else
+
+static inline void async_init(void)
+{
+}
+
+static inline int async_drain(void)
+{
+	return 0;
+}
+
+#endif /* CONFIG_DFU_TARGET_STREAM_ASYNC */
+
 struct stream_flash_ctx *dfu_target_stream_get_stream(void)
 {
+	(void)async_drain();
+
 	return &stream;
 }
 
@@ -117,6 +348,7 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 	}
 
 	current_id = init->id;
+	async_init();
 
 	err = stream_flash_init(&stream, init->fdev, init->buf, init->len,
 				init->offset, init->size, NULL);
@@ -145,6 +377,9 @@ int dfu_target_stream_init(const struct dfu_target_stream_init *init)
 		LOG_ERR("settings_load failed (err %d)", err);
 		return err;
 	}
+
+	progress_stored_bytes = stream_flash_bytes_written(&stream);
+	progress_stored_time = k_uptime_get();
 #endif /* CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS */
 
 	return 0;
@@ -156,6 +391,7 @@ int dfu_target_stream_offset_get(size_t *out)
 		return -EINVAL;
 	}
 
+	(void)async_drain();
 	*out = stream_flash_bytes_written(&stream);
 
 	return 0;
@@ -167,6 +403,7 @@ int dfu_target_stream_bytes_buffered_get(size_t *out)
 		return -EINVAL;
 	}
 
+	(void)async_drain();
 	*out = stream_flash_bytes_buffered(&stream);
 
 	return 0;
@@ -174,44 +411,29 @@ int dfu_target_stream_bytes_buffered_get(size_t *out)
 
 int dfu_target_stream_write(const uint8_t *buf, size_t len)
 {
-#ifdef CONFIG_DFU_TARGET_STREAM_SYNCHRONOUS
-	/**
-	 * Flush immediately.
-	 * This may be necessary in scenarios where the server
-	 * cannot retransmit data that has already been ack-ed.
-	 * by the device. Without flushing, if an unaligned write
-	 * occurred prior to a reboot, some bytes that were already
-	 * sent to the device would need to be retransmitted.
-	 * This will lead to issues on the server side in the
-	 * described case, as the server would need to retransmit
-	 * already ack-ed data.
-	 */
-	int err = stream_flash_buffered_write(&stream, buf, len, true);
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	return async_write(buf, len);
 #else
-	int err = stream_flash_buffered_write(&stream, buf, len, false);
-#endif
+	int err = stream_write(buf, len);
 
 	if (err != 0) {
-		LOG_ERR("stream_flash_buffered_write error %d", err);
 		return err;
 	}
 
-#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
-	err = store_progress();
-	if (err != 0) {
-		/* Failing to store progress is not a critical error you'll just
-		 * be left to download a bit more if you fail and resume.
-		 */
-		LOG_WRN("Unable to store write progress: %d", err);
-	}
+	return progress_update();
 #endif
-
-	return err;
 }
 
 int dfu_target_stream_done(bool successful)
 {
 	int err = 0;
+	int write_err = async_drain();
+
+	if (write_err != 0) {
+		LOG_ERR("Background flash write error %d", write_err);
+		/* Some data was not written, so the stream cannot be completed. */
+		successful = false;
+	}
 
 	if (successful) {
 		err = stream_flash_buffered_write(&stream, NULL, 0, true);
@@ -240,13 +462,15 @@ int dfu_target_stream_done(bool successful)
 
 	current_id = NULL;
 
-	return err;
+	return (write_err != 0) ? write_err : err;
 }
 
 int dfu_target_stream_reset(void)
 {
 	int err = 0;
 
+	(void)async_drain();
+
 	stream.buf_bytes = 0;
 	stream.bytes_written = 0;
 
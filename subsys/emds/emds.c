@@ -81,6 +81,7 @@ enum emds_state {
 static enum emds_state emds_state = EMDS_STATE_NOT_INITIALIZED;
 static struct emds_snapshot_candidate freshest_snapshot;
 static struct emds_snapshot_candidate allocated_snapshot;
+static size_t chunk_write_cnt;
 
 static sys_slist_t emds_dynamic_entries;
 static struct emds_partition partition[PARTITIONS_NUM_MAX];
@@ -246,6 +247,11 @@ int emds_store_time_get(uint32_t *store_time)
 	*store_time = words * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US;
 	*store_time += chunk_handling * CONFIG_EMDS_CHUNK_PREPARATION_TIME_US;
 
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* Worst case: every chunk differs from the baseline and has to be rewritten. */
+	*store_time += chunk_handling * CONFIG_EMDS_CHUNK_COMPARISON_TIME_US;
+#endif
+
 	return 0;
 }
 
@@ -342,6 +348,123 @@ int emds_load(void)
 			      &freshest_snapshot.metadata);
 }
 
+static void chunk_write(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
+			size_t *wp)
+{
+	allocated_snapshot.metadata.snapshot_crc =
+		crc32_k_4_2_update(allocated_snapshot.metadata.snapshot_crc, out, *wp);
+
+	/* With incremental storing, the chunk is skipped if the allocated snapshot area
+	 * already holds the same data. This applies both to the baseline written by
+	 * emds_prepare() and to the snapshot written by emds_store().
+	 */
+	if (!IS_ENABLED(CONFIG_EMDS_INCREMENTAL_STORE) ||
+	    !emds_flash_data_equal(partition, *data_off, out, *wp)) {
+		uint32_t key = irq_lock();
+
+		emds_flash_write_data(partition, *data_off, out, *wp);
+		irq_unlock(key);
+		chunk_write_cnt++;
+	}
+
+	*data_off += *wp;
+	*wp = 0;
+}
+
+static void data_stream_pack(uint8_t *in, uint8_t *out, size_t *wp, size_t *rp, size_t len)
+{
+	size_t size = MIN(CHUNK_SIZE - *wp, len - *rp);
+
+	memcpy(out + *wp, in + *rp, size);
+	*rp += size;
+	*wp += size;
+}
+
+static void data_to_stream(const struct emds_partition *partition, off_t *data_off, uint8_t *in,
+			   uint8_t *out, size_t *wp, size_t len)
+{
+	size_t rp = 0;
+
+	while (rp != len) {
+		data_stream_pack(in, out, wp, &rp, len);
+		if (*wp == CHUNK_SIZE) {
+			chunk_write(partition, data_off, out, wp);
+		}
+	}
+}
+
+static void entry_to_stream(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
+			    size_t *wp, struct emds_entry *entry)
+{
+	struct emds_data_entry data_entry = {
+		.id = entry->id,
+		.length = entry->len,
+	};
+
+	LOG_DBG("Storing entry ID %u, length %u", entry->id, entry->len);
+	data_to_stream(partition, data_off, (uint8_t *)&data_entry, out, wp, sizeof(data_entry));
+	data_to_stream(partition, data_off, entry->data, out, wp, entry->len);
+}
+
+static void stream_fflush(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
+			  size_t *wp)
+{
+	if (*wp > 0) {
+		chunk_write(partition, data_off, out, wp);
+	}
+}
+
+static void entries_to_stream(const struct emds_partition *partition)
+{
+	uint8_t data_chunk[CHUNK_SIZE];
+	size_t wp = 0;
+	off_t data_off = allocated_snapshot.metadata.data_instance_off;
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		entry_to_stream(partition, &data_off, data_chunk, &wp, ch);
+	}
+
+	struct emds_dynamic_entry *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		entry_to_stream(partition, &data_off, data_chunk, &wp, &ch->entry);
+	}
+
+	stream_fflush(partition, &data_off, data_chunk, &wp);
+}
+
+static void snapshot_baseline_write(void)
+{
+	/* The allocated snapshot area is only written where the baseline is missing or
+	 * stale. It is missing after a snapshot has been stored, as the next snapshot is
+	 * then allocated in an unused area. If emds_prepare() is called again without
+	 * storing, the area already holds the baseline and only the chunks that changed
+	 * since then are rewritten.
+	 *
+	 * Interrupts are only locked for a single chunk write. The snapshot CRC is
+	 * computed again by emds_store().
+	 */
+	chunk_write_cnt = 0;
+	entries_to_stream(&partition[allocated_snapshot.partition_index]);
+	allocated_snapshot.metadata.snapshot_crc = 0;
+
+	LOG_DBG("Baseline for snapshot with fresh_cnt %u: %zu chunks written",
+		allocated_snapshot.metadata.fresh_cnt, chunk_write_cnt);
+}
+
+static int snapshot_ready(int idx)
+{
+	allocated_snapshot.partition_index = idx;
+
+	if (IS_ENABLED(CONFIG_EMDS_INCREMENTAL_STORE)) {
+		snapshot_baseline_write();
+	}
+
+	emds_state = EMDS_STATE_READY;
+
+	return 0;
+}
+
 int emds_prepare(void)
 {
 	size_t data_size;
@@ -366,9 +489,7 @@ int emds_prepare(void)
 						  &freshest_snapshot, &allocated_snapshot,
 						  data_size);
 		if (rc == 0) {
-			allocated_snapshot.partition_index = freshest_partition_idx;
-			emds_state = EMDS_STATE_READY;
-			return 0;
+			return snapshot_ready(freshest_partition_idx);
 		}
 		rc = 0;
 	}
@@ -387,9 +508,7 @@ int emds_prepare(void)
 			rc = emds_flash_allocate_snapshot(&partition[idx], NULL,
 							  &allocated_snapshot, data_size);
 			if (rc == 0) {
-				allocated_snapshot.partition_index = idx;
-				emds_state = EMDS_STATE_READY;
-				return 0;
+				return snapshot_ready(idx);
 			}
 		}
 
@@ -404,63 +523,9 @@ int emds_prepare(void)
 	return -ENOENT;
 }
 
-static void data_stream_pack(uint8_t *in, uint8_t *out, size_t *wp, size_t *rp, size_t len)
-{
-	size_t size = MIN(CHUNK_SIZE - *wp, len - *rp);
-
-	memcpy(out + *wp, in + *rp, size);
-	*rp += size;
-	*wp += size;
-}
-
-static void data_to_stream(const struct emds_partition *partition, off_t *data_off, uint8_t *in,
-			   uint8_t *out, size_t *wp, size_t len)
-{
-	size_t rp = 0;
-
-	while (rp != len) {
-		data_stream_pack(in, out, wp, &rp, len);
-		if (*wp == CHUNK_SIZE) {
-			allocated_snapshot.metadata.snapshot_crc = crc32_k_4_2_update(
-				allocated_snapshot.metadata.snapshot_crc, out, *wp);
-			emds_flash_write_data(partition, *data_off, out, *wp);
-			*data_off += *wp;
-			*wp = 0;
-		}
-	}
-}
-
-static void entry_to_stream(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
-			    size_t *wp, struct emds_entry *entry)
-{
-	struct emds_data_entry data_entry = {
-		.id = entry->id,
-		.length = entry->len,
-	};
-
-	LOG_DBG("Storing entry ID %u, length %u", entry->id, entry->len);
-	data_to_stream(partition, data_off, (uint8_t *)&data_entry, out, wp, sizeof(data_entry));
-	data_to_stream(partition, data_off, entry->data, out, wp, entry->len);
-}
-
-static void stream_fflush(const struct emds_partition *partition, off_t *data_off, uint8_t *out,
-			  size_t *wp)
-{
-	if (*wp > 0) {
-		allocated_snapshot.metadata.snapshot_crc =
-			crc32_k_4_2_update(allocated_snapshot.metadata.snapshot_crc, out, *wp);
-		emds_flash_write_data(partition, *data_off, out, *wp);
-		*data_off += *wp;
-		*wp = 0;
-	}
-}
-
 int emds_store(void)
 {
 	uint32_t store_key;
-	uint8_t data_chunk[CHUNK_SIZE];
-	size_t wp = 0;
-	off_t data_off = allocated_snapshot.metadata.data_instance_off;
 	int idx = allocated_snapshot.partition_index;
 	int rc = 0;
 
@@ -485,17 +550,7 @@ int emds_store(void)
 				      offsetof(struct emds_snapshot_metadata, snapshot_crc));
 	}
 
-	STRUCT_SECTION_FOREACH(emds_entry, ch) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, ch);
-	}
-
-	struct emds_dynamic_entry *ch;
-
-	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
-		entry_to_stream(&partition[idx], &data_off, data_chunk, &wp, &ch->entry);
-	}
-
-	stream_fflush(&partition[idx], &data_off, data_chunk, &wp);
+	entries_to_stream(&partition[idx]);
 
 	if (flash_params_get_erase_cap(partition[idx].fp) & FLASH_ERASE_C_EXPLICIT) {
 		LOG_DBG("Writing snapshot crc on offset: 0x%4lx, crc : 0x%4x",
@@ -364,6 +364,16 @@ void emds_flash_write_data(const struct emds_partition *partition, off_t data_of
 	nvmc_wait_ready();
 }
 
+bool emds_flash_data_equal(const struct emds_partition *partition, off_t data_off,
+			   const void *data_chunk, size_t data_size)
+{
+	uint32_t flash_addr = data_off + partition->fa->fa_off;
+
+	flash_addr += DT_REG_ADDR(SOC_NV_FLASH_NODE);
+
+	return memcmp((const void *)flash_addr, data_chunk, data_size) == 0;
+}
+
 int emds_flash_erase_partition(const struct emds_partition *partition)
 {
 	const struct flash_area *fa = partition->fa;
@@ -163,6 +163,23 @@ int emds_flash_allocate_snapshot(const struct emds_partition *partition,
 void emds_flash_write_data(const struct emds_partition *partition, off_t data_off, void *data_chunk,
 			   size_t data_size);
 
+/**
+ * @brief Check if the data in the emergency data storage partition matches the given chunk.
+ *
+ * The partition is read directly through the memory-mapped flash, so the function
+ * can be used with interrupts locked.
+ *
+ * @param partition Pointer to the emergency data storage partition structure.
+ * @param data_off Offset in the partition where the data chunk is located.
+ * @param data_chunk Pointer to data chunk.
+ * @param data_size Size of the data chunk.
+ *
+ * @retval true if the flash content is equal to the data chunk.
+ * @retval false otherwise.
+ */
+bool emds_flash_data_equal(const struct emds_partition *partition, off_t data_off,
+			   const void *data_chunk, size_t data_size);
+
 /**
  * @brief Erase the specified emergency data storage partition.
  *
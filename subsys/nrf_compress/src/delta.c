@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <nrf_compress/implementation.h>
+#include <nrf_compress/delta_types.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+
+LOG_MODULE_REGISTER(nrf_compress_delta, CONFIG_NRF_COMPRESS_LOG_LEVEL);
+
+/* The patch is a header followed by records in the following format (all values are
+ * little-endian):
+ *
+ * Header:
+ *   uint32_t magic		NRF_COMPRESS_DELTA_MAGIC
+ *   uint8_t version		NRF_COMPRESS_DELTA_VERSION
+ *   uint8_t reserved[3]
+ *   uint32_t source_size	Size of the source image the patch was created against
+ *   uint32_t target_size	Size of the patched image
+ *
+ * Record:
+ *   uint32_t diff_len		Number of diff bytes following the record header
+ *   uint32_t extra_len		Number of extra bytes following the diff bytes
+ *   int32_t seek		Source position adjustment applied after the record
+ *   uint8_t diff[diff_len]	Added (modulo 256) to the source bytes at the source position
+ *   uint8_t extra[extra_len]	Copied to the output as-is
+ */
+
+enum delta_state {
+	DELTA_STATE_HEADER,
+	DELTA_STATE_RECORD,
+	DELTA_STATE_DIFF,
+	DELTA_STATE_EXTRA,
+};
+
+static const delta_codec *codec;
+static uint8_t output_buffer[CONFIG_NRF_COMPRESS_CHUNK_SIZE];
+static uint8_t header_buffer[NRF_COMPRESS_DELTA_HEADER_SIZE];
+static size_t header_len;
+static enum delta_state state;
+static size_t source_pos;
+static size_t diff_left;
+static size_t extra_left;
+static int32_t seek;
+static size_t target_left;
+static size_t output_limit = SIZE_MAX;
+
+static int delta_reset(void *inst, size_t decompressed_size);
+
+static int delta_init(void *inst, size_t decompressed_size)
+{
+	const delta_codec *delta_inst = inst;
+
+	if (delta_inst == NULL || delta_inst->source_read == NULL) {
+		return -EINVAL;
+	}
+
+	codec = delta_inst;
+
+	return delta_reset(inst, decompressed_size);
+}
+
+static int delta_deinit(void *inst)
+{
+	int rc = delta_reset(inst, 0);
+
+	codec = NULL;
+
+	return rc;
+}
+
+static int delta_reset(void *inst, size_t decompressed_size)
+{
+	ARG_UNUSED(inst);
+
+	output_limit = decompressed_size != 0 ? decompressed_size : SIZE_MAX;
+
+	state = DELTA_STATE_HEADER;
+	header_len = 0;
+	source_pos = 0;
+	diff_left = 0;
+	extra_left = 0;
+	seek = 0;
+	target_left = 0;
+
+#ifdef CONFIG_NRF_COMPRESS_CLEANUP
+	memset(output_buffer, 0x00, sizeof(output_buffer));
+#endif
+
+	return 0;
+}
+
+static size_t delta_bytes_needed(void *inst)
+{
+	ARG_UNUSED(inst);
+
+	if (state == DELTA_STATE_HEADER) {
+		return NRF_COMPRESS_DELTA_HEADER_SIZE - header_len;
+	}
+
+	return CONFIG_NRF_COMPRESS_CHUNK_SIZE;
+}
+
+static size_t header_fill(const uint8_t *input, size_t input_size, size_t header_size)
+{
+	size_t len = MIN(header_size - header_len, input_size);
+
+	memcpy(&header_buffer[header_len], input, len);
+	header_len += len;
+
+	return len;
+}
+
+static int header_parse(void)
+{
+	uint32_t source_size = sys_get_le32(&header_buffer[8]);
+
+	if (sys_get_le32(&header_buffer[0]) != NRF_COMPRESS_DELTA_MAGIC ||
+	    header_buffer[4] != NRF_COMPRESS_DELTA_VERSION) {
+		LOG_ERR("Invalid delta patch header");
+		return -EINVAL;
+	}
+
+	if (source_size != codec->source_size) {
+		LOG_ERR("Patch created for a source of %u bytes, source has %zu bytes",
+			source_size, codec->source_size);
+		return -EINVAL;
+	}
+
+	target_left = sys_get_le32(&header_buffer[12]);
+
+	if (target_left > output_limit) {
+		LOG_ERR("Patched image too large: %zu", target_left);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int record_end(void)
+{
+	/* The source position may be moved anywhere within the source image. */
+	if ((seek < 0 && (size_t)(-(int64_t)seek) > source_pos) ||
+	    (seek > 0 && (size_t)seek > codec->source_size - source_pos)) {
+		LOG_ERR("Invalid source position adjustment: %d", seek);
+		return -EINVAL;
+	}
+
+	source_pos += seek;
+	state = DELTA_STATE_RECORD;
+
+	return 0;
+}
+
+static int record_parse(void)
+{
+	diff_left = sys_get_le32(&header_buffer[0]);
+	extra_left = sys_get_le32(&header_buffer[4]);
+	seek = (int32_t)sys_get_le32(&header_buffer[8]);
+
+	if (diff_left > target_left || extra_left > target_left - diff_left) {
+		LOG_ERR("Record exceeds patched image size");
+		return -EINVAL;
+	}
+
+	if (diff_left > codec->source_size - source_pos) {
+		LOG_ERR("Record exceeds source image size");
+		return -EINVAL;
+	}
+
+	if (diff_left > 0) {
+		state = DELTA_STATE_DIFF;
+	} else if (extra_left > 0) {
+		state = DELTA_STATE_EXTRA;
+	} else {
+		return record_end();
+	}
+
+	return 0;
+}
+
+static int diff_apply(const uint8_t *input, size_t len, uint8_t *output)
+{
+	int rc = codec->source_read(source_pos, output, len);
+
+	if (rc) {
+		LOG_ERR("Failed to read source image at 0x%zx: %d", source_pos, rc);
+		return -EIO;
+	}
+
+	for (size_t i = 0; i < len; i++) {
+		output[i] += input[i];
+	}
+
+	source_pos += len;
+
+	return 0;
+}
+
+static int delta_decompress(void *inst, const uint8_t *input, size_t input_size,
+			    bool last_part, uint32_t *offset, uint8_t **output,
+			    size_t *output_size)
+{
+	size_t input_pos = 0;
+	size_t output_pos = 0;
+	int rc = 0;
+
+	ARG_UNUSED(inst);
+
+	if (codec == NULL) {
+		return -ESRCH;
+	}
+
+	if (input == NULL || input_size == 0 || offset == NULL || output == NULL ||
+	    output_size == NULL) {
+		return -EINVAL;
+	}
+
+	*output = NULL;
+	*output_size = 0;
+
+	while (input_pos < input_size && output_pos < sizeof(output_buffer) && rc == 0) {
+		size_t avail = input_size - input_pos;
+		size_t len;
+
+		switch (state) {
+		case DELTA_STATE_HEADER:
+			input_pos += header_fill(&input[input_pos], avail,
+						 NRF_COMPRESS_DELTA_HEADER_SIZE);
+
+			if (header_len == NRF_COMPRESS_DELTA_HEADER_SIZE) {
+				header_len = 0;
+				rc = header_parse();
+				state = DELTA_STATE_RECORD;
+			}
+			break;
+
+		case DELTA_STATE_RECORD:
+			input_pos += header_fill(&input[input_pos], avail,
+						 NRF_COMPRESS_DELTA_RECORD_SIZE);
+
+			if (header_len == NRF_COMPRESS_DELTA_RECORD_SIZE) {
+				header_len = 0;
+				rc = record_parse();
+			}
+			break;
+
+		case DELTA_STATE_DIFF:
+			len = MIN(MIN(avail, diff_left), sizeof(output_buffer) - output_pos);
+			rc = diff_apply(&input[input_pos], len, &output_buffer[output_pos]);
+			input_pos += len;
+			output_pos += len;
+			diff_left -= len;
+			target_left -= len;
+
+			if (rc == 0 && diff_left == 0) {
+				if (extra_left > 0) {
+					state = DELTA_STATE_EXTRA;
+				} else {
+					rc = record_end();
+				}
+			}
+			break;
+
+		case DELTA_STATE_EXTRA:
+			len = MIN(MIN(avail, extra_left), sizeof(output_buffer) - output_pos);
+			memcpy(&output_buffer[output_pos], &input[input_pos], len);
+			input_pos += len;
+			output_pos += len;
+			extra_left -= len;
+			target_left -= len;
+
+			if (extra_left == 0) {
+				rc = record_end();
+			}
+			break;
+		}
+	}
+
+	if (rc) {
+		return rc;
+	}
+
+	output_limit -= output_pos;
+
+	if (last_part && input_pos == input_size &&
+	    (state != DELTA_STATE_RECORD || header_len != 0 || target_left != 0)) {
+		LOG_ERR("Delta patch ended prematurely");
+		return -EINVAL;
+	}
+
+	*offset = input_pos;
+	*output = output_buffer;
+	*output_size = output_pos;
+
+	return 0;
+}
+
+NRF_COMPRESS_IMPLEMENTATION_DEFINE(delta, NRF_COMPRESS_TYPE_DELTA, delta_init, delta_deinit,
+				   delta_reset, NULL, delta_bytes_needed, delta_decompress);
@@ -147,6 +147,24 @@ typedef struct dict_cache_t {
 
 static dict_cache cache;
 #endif
+
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+/**
+ * @brief Dictionary Read Cache Line Structure
+ */
+typedef struct dict_read_cache_line_t {
+	/** Cached dictionary data. */
+	uint8_t data[CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINE_SIZE];
+	/** Indicates which dictionary element is stored as first element of @a data. */
+	SizeT dict_pos;
+	/** Number of valid bytes in @a data, 0 if the line is not in use. */
+	SizeT len;
+} dict_read_cache_line;
+
+static dict_read_cache_line read_cache[CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES];
+/** Index of the line to be replaced on the next miss. */
+static size_t read_cache_victim;
+#endif
 #endif
 
 static size_t lzma_output_limit = SIZE_MAX;
@@ -157,6 +175,120 @@ static CLzma2Dec lzma_decoder;
 static CLzmaDec lzma_decoder;
 #endif
 
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+/**
+ * @brief Drop read cache lines that overlap with data written to external dictionary.
+ *
+ * @param pos position of the first written dictionary element.
+ * @param len number of written dictionary elements.
+ */
+static void read_cache_invalidate(SizeT pos, SizeT len)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(read_cache); i++) {
+		dict_read_cache_line *line = &read_cache[i];
+
+		if (line->len > 0 && pos < line->dict_pos + line->len &&
+		    line->dict_pos < pos + len) {
+			line->len = 0;
+		}
+	}
+}
+
+/**
+ * @brief Get read cache line holding given dictionary element.
+ *
+ * On a miss, the line is filled from the external dictionary.
+ *
+ * @param handle pointer to Lzma dictionary handle struct, for dictionary size reference.
+ * @param pos position of the dictionary element.
+ *
+ * @retval pointer to the cache line, NULL on any error with reading from external dictionary
+ */
+static dict_read_cache_line *read_cache_line_get(const DictHandle *handle, SizeT pos)
+{
+	dict_read_cache_line *line;
+
+	for (size_t i = 0; i < ARRAY_SIZE(read_cache); i++) {
+		line = &read_cache[i];
+
+		if (line->len > 0 && pos >= line->dict_pos && pos < line->dict_pos + line->len) {
+			return line;
+		}
+	}
+
+	line = &read_cache[read_cache_victim];
+	read_cache_victim = (read_cache_victim + 1) % ARRAY_SIZE(read_cache);
+
+	line->dict_pos = ROUND_DOWN(pos, sizeof(line->data));
+	line->len = MIN(sizeof(line->data), handle->dicBufSize - line->dict_pos);
+
+	if (ext_dict->read(line->dict_pos, line->data, line->len) != line->len) {
+		line->len = 0;
+		return NULL;
+	}
+
+	return line;
+}
+#endif
+
+/**
+ * @brief Read data from external dictionary, through the read cache if enabled.
+ *
+ * @param handle pointer to Lzma dictionary handle struct, for dictionary size reference.
+ * @param pos position of the dictionary to start reading from.
+ * @param data data buffer to read into.
+ * @param len number of bytes to read.
+ *
+ * @retval number of bytes read from the dictionary
+ */
+static SizeT dict_read(const DictHandle *handle, SizeT pos, Byte *data, SizeT len)
+{
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+	SizeT bytes_read = 0;
+
+	while (bytes_read < len) {
+		const dict_read_cache_line *line = read_cache_line_get(handle, pos + bytes_read);
+		SizeT line_off;
+		SizeT copy_len;
+
+		if (line == NULL) {
+			break;
+		}
+
+		line_off = pos + bytes_read - line->dict_pos;
+		copy_len = MIN(len - bytes_read, line->len - line_off);
+		memcpy(data + bytes_read, line->data + line_off, copy_len);
+		bytes_read += copy_len;
+	}
+
+	return bytes_read;
+#else
+	ARG_UNUSED(handle);
+
+	return ext_dict->read(pos, data, len);
+#endif
+}
+
+/**
+ * @brief Write data to external dictionary and drop stale read cache lines.
+ *
+ * @param pos position of the dictionary to start writing to.
+ * @param data data to write.
+ * @param len number of bytes to write.
+ *
+ * @retval number of bytes written to the dictionary
+ */
+static SizeT dict_write(SizeT pos, const Byte *data, SizeT len)
+{
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+	read_cache_invalidate(pos, len);
+#endif
+
+	return ext_dict->write(pos, data, len);
+}
+#endif
+
 #if CONFIG_NRF_COMPRESS_DICTIONARY_CACHE_SIZE > 0
 /**
  * @brief Synchronize dictionary cache with external dictionary.
@@ -174,7 +306,7 @@ static int synchronize_cache(const DictHandle *handle)
 	SizeT dict_read_size;
 	const SizeT dict_write_size = cache.write_offset;
 
-	if (ext_dict->write(cache.dict_pos_begin, cache.data, dict_write_size) !=
+	if (dict_write(cache.dict_pos_begin, cache.data, dict_write_size) !=
 			dict_write_size) {
 		return -EIO;
 	}
@@ -647,6 +779,10 @@ DictHandle *LzmaDictionaryOpen(SizeT size)
 	cache.dict_pos_end = sizeof(cache.data) - 1;
 	cache.write_offset = 0;
 #endif
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+	read_cache_invalidate(0, dict_size);
+	read_cache_victim = 0;
+#endif
 
 	return &dict_handle;
 }
@@ -696,7 +832,7 @@ SizeT LzmaDictionaryWrite(DictHandle *handle, SizeT pos, const Byte *data, SizeT
 	}
 	return bytes_written;
 #else
-	return ext_dict->write(pos, data, write_len);
+	return dict_write(pos, data, write_len);
 #endif
 }
 
@@ -722,7 +858,7 @@ SizeT LzmaDictionaryRead(DictHandle *handle, SizeT pos, Byte *data, SizeT len)
 
 		if (pos < cache.dict_pos_begin) {
 			/* First part of data is from dictionary... */
-			bytes_read = ext_dict->read(pos, data, cache.dict_pos_begin - pos);
+			bytes_read = dict_read(handle, pos, data, cache.dict_pos_begin - pos);
 			if (bytes_read != cache.dict_pos_begin - pos) {
 				return bytes_read;
 			}
@@ -741,16 +877,16 @@ SizeT LzmaDictionaryRead(DictHandle *handle, SizeT pos, Byte *data, SizeT len)
 
 		if (bytes_read != read_len) {
 			/* Last part of data is from dictionary. */
-			bytes_read += ext_dict->read(pos + bytes_read, data + bytes_read,
-								read_len - bytes_read);
+			bytes_read += dict_read(handle, pos + bytes_read, data + bytes_read,
+						read_len - bytes_read);
 		}
 	} else {
 		/* Requested data is not cached at all. */
-		bytes_read = ext_dict->read(pos, data, read_len);
+		bytes_read = dict_read(handle, pos, data, read_len);
 	}
 	return bytes_read;
 #else
-	return ext_dict->read(pos, data, read_len);
+	return dict_read(handle, pos, data, read_len);
 #endif
 }
 
@@ -772,6 +908,9 @@ SRes LzmaDictionaryClose(DictHandle *handle)
 	/* Clear the cache. */
 	memset(cache.data, 0, sizeof(cache.data));
 #endif
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+	memset(read_cache, 0, sizeof(read_cache));
+#endif
 
 	if (ext_dict->close() != 0) {
 		rc = SZ_ERROR_FAIL;
@@ -9,11 +9,12 @@
 #include <zephyr/sys/time_units.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/kernel.h>
-#include <SEGGER_RTT.h>
 #include <nrf_profiler.h>
 #include <string.h>
-#include <nrfx.h>
+
+#include "profiler_nordic_transport.h"
 
 
 enum state {
@@ -26,10 +27,14 @@ enum state {
 /* By default, when there is no shell, all events are profiled. */
 struct nrf_profiler_event_enabled_bm _nrf_profiler_event_enabled_bm;
 
-static K_SEM_DEFINE(nrf_profiler_sem, 0, 1);
+static K_SEM_DEFINE(nrf_profiler_sem, 0, 2);
 static atomic_t nrf_profiler_state;
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+static uint16_t dropped_events_event_id;
+#else
 static uint16_t fatal_error_event_id;
 static struct k_spinlock lock;
+#endif
 
 enum nordic_command {
 	NORDIC_COMMAND_START	= 1,
@@ -52,16 +57,44 @@ static char *arg_types_encodings[] = {
 
 uint8_t nrf_profiler_num_events;
 
-static uint8_t buffer_data[CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE];
-static uint8_t buffer_info[CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE];
-static uint8_t buffer_commands[CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
-
 static k_tid_t protocol_thread_id;
 
 static K_THREAD_STACK_DEFINE(nrf_profiler_nordic_stack,
 			     CONFIG_NRF_PROFILER_NORDIC_STACK_SIZE);
 static struct k_thread nrf_profiler_nordic_thread;
 
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+#define STAGING_BUF_SIZE CONFIG_NRF_PROFILER_NORDIC_STAGING_BUFFER_SIZE
+#define STAGING_HDR_SIZE sizeof(uint16_t)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(STAGING_BUF_SIZE),
+	     "Staging buffer size must be a power of two");
+BUILD_ASSERT(STAGING_BUF_SIZE >= STAGING_HDR_SIZE + CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN,
+	     "Staging buffer too small to hold an event");
+
+/* Ring buffer with a single producer (the CPU owning the buffer) and a single consumer
+ * (the flush thread). Events are stored as a 16-bit length followed by the event data.
+ * Producers running on the same CPU are serialized by locking interrupts on that CPU, so
+ * logging an event never takes a lock shared with other CPUs.
+ */
+struct staging_buf {
+	/* Position of the next write, updated only by the producer. */
+	atomic_t head;
+	/* Position of the next read, updated only by the consumer. */
+	atomic_t tail;
+	/* Number of events dropped since the last report. */
+	atomic_t dropped;
+	uint8_t data[STAGING_BUF_SIZE];
+};
+
+static struct staging_buf staging_bufs[CONFIG_MP_MAX_NUM_CPUS];
+static K_SEM_DEFINE(flush_sem, 0, 1);
+
+static K_THREAD_STACK_DEFINE(nrf_profiler_flush_stack,
+			     CONFIG_NRF_PROFILER_NORDIC_FLUSH_STACK_SIZE);
+static struct k_thread nrf_profiler_flush_thread;
+#endif /* CONFIG_NRF_PROFILER_NORDIC_STAGING */
+
 static int send_info_data(const char *data, size_t data_len)
 {
 	uint8_t retry_cnt = 0;
@@ -69,17 +102,13 @@ static int send_info_data(const char *data, size_t data_len)
 
 	size_t num_bytes_send;
 
-	num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
+	num_bytes_send = nrf_profiler_transport_info_write(data, data_len);
 
 	while (num_bytes_send != data_len) {
 		/* Give host time to read the data and free some space
 		 * in the buffer. */
 		k_sleep(K_MSEC(100));
-		num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
+		num_bytes_send = nrf_profiler_transport_info_write(data, data_len);
 
 		/* Avoid being blocked in while loop if host does not read
 		 * the RTT data.
@@ -104,7 +133,7 @@ static int send_system_description(void)
 	static const char * const ev_info_stop = "<ev_info_stop>\n";
 	static const char end_line = '\n';
 
-	__DMB();
+	barrier_dmem_fence_full();
 
 	err = send_info_data(ev_info_start, strlen(ev_info_start));
 	if (err) {
@@ -163,43 +192,202 @@ static int send_system_configuration(void)
 	return err;
 }
 
-static void nrf_profiler_nordic_thread_fn(void)
+static int send_info(void)
+{
+	int err;
+	static const char end_line = '\n';
+
+	nrf_profiler_transport_info_start();
+
+	err = send_system_description();
+	if (err) {
+		return err;
+	}
+
+	err = send_system_configuration();
+	if (err) {
+		return err;
+	}
+
+	return send_info_data(&end_line, 1);
+}
+
+#ifdef CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_COMMANDS
+static void handle_commands(void)
 {
-	int ret_err;
 	uint8_t read_data;
 	enum nordic_command command;
-	static const char end_line = '\n';
 
-	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
-		if (SEGGER_RTT_Read(
-		     CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		     &read_data, sizeof(read_data))) {
-			command = (enum nordic_command)read_data;
-			switch (command) {
-			case NORDIC_COMMAND_START:
-				atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
-				break;
-			case NORDIC_COMMAND_STOP:
-				atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
-				break;
-			case NORDIC_COMMAND_INFO:
-				ret_err = send_system_description();
-				if (ret_err) {
-					break;
-				}
-				ret_err = send_system_configuration();
-				if (!ret_err) {
-					(void)send_info_data(&end_line, 1);
-				}
-				break;
-			default:
-				break;
-			}
+	if (nrf_profiler_transport_command_read(&read_data, sizeof(read_data))) {
+		command = (enum nordic_command)read_data;
+		switch (command) {
+		case NORDIC_COMMAND_START:
+			atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
+			break;
+		case NORDIC_COMMAND_STOP:
+			atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
+			break;
+		case NORDIC_COMMAND_INFO:
+			(void)send_info();
+			break;
+		default:
+			break;
 		}
+	}
+}
+#else
+static void update_info(void)
+{
+	static uint8_t info_num_events;
+	uint8_t ne = nrf_profiler_num_events;
+
+	/* The host cannot request the information. Write it again whenever a new event type
+	 * is registered.
+	 */
+	if ((ne != info_num_events) && !send_info()) {
+		info_num_events = ne;
+	}
+}
+#endif /* CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_COMMANDS */
+
+static void nrf_profiler_nordic_thread_fn(void)
+{
+	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
+#ifdef CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_COMMANDS
+		handle_commands();
+#else
+		update_info();
+#endif
 		k_sleep(K_MSEC(500));
 	}
+
+#ifndef CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_COMMANDS
+	update_info();
+#endif
+	k_sem_give(&nrf_profiler_sem);
+}
+
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+static void staging_copy_in(struct staging_buf *sbuf, uint32_t pos, const uint8_t *data,
+			    size_t len)
+{
+	size_t idx = pos & (STAGING_BUF_SIZE - 1);
+	size_t first = MIN(len, STAGING_BUF_SIZE - idx);
+
+	memcpy(&sbuf->data[idx], data, first);
+	memcpy(sbuf->data, &data[first], len - first);
+}
+
+static void staging_copy_out(const struct staging_buf *sbuf, uint32_t pos, uint8_t *data,
+			     size_t len)
+{
+	size_t idx = pos & (STAGING_BUF_SIZE - 1);
+	size_t first = MIN(len, STAGING_BUF_SIZE - idx);
+
+	memcpy(data, &sbuf->data[idx], first);
+	memcpy(&data[first], sbuf->data, len - first);
+}
+
+static void staging_put(const uint8_t *data, size_t len)
+{
+	uint8_t hdr[STAGING_HDR_SIZE];
+	unsigned int key = arch_irq_lock();
+	struct staging_buf *sbuf = &staging_bufs[arch_curr_cpu()->id];
+	uint32_t head = (uint32_t)atomic_get(&sbuf->head);
+	uint32_t used = head - (uint32_t)atomic_get(&sbuf->tail);
+
+	if ((STAGING_BUF_SIZE - used) < (STAGING_HDR_SIZE + len)) {
+		atomic_inc(&sbuf->dropped);
+		arch_irq_unlock(key);
+		k_sem_give(&flush_sem);
+		return;
+	}
+
+	sys_put_le16(len, hdr);
+	staging_copy_in(sbuf, head, hdr, sizeof(hdr));
+	staging_copy_in(sbuf, head + sizeof(hdr), data, len);
+	used += sizeof(hdr) + len;
+
+	/* Atomic operation acts as a barrier, the event is fully written before it is
+	 * visible to the flush thread.
+	 */
+	(void)atomic_set(&sbuf->head, head + sizeof(hdr) + len);
+	arch_irq_unlock(key);
+
+	if (used > (STAGING_BUF_SIZE / 2)) {
+		k_sem_give(&flush_sem);
+	}
+}
+
+static bool staging_flush(struct staging_buf *sbuf)
+{
+	static uint8_t event_data[CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN];
+	uint32_t tail = (uint32_t)atomic_get(&sbuf->tail);
+	uint32_t head = (uint32_t)atomic_get(&sbuf->head);
+
+	while (tail != head) {
+		uint8_t hdr[STAGING_HDR_SIZE];
+		uint16_t len;
+
+		staging_copy_out(sbuf, tail, hdr, sizeof(hdr));
+		len = sys_get_le16(hdr);
+		__ASSERT_NO_MSG(len <= sizeof(event_data));
+		staging_copy_out(sbuf, tail + sizeof(hdr), event_data, len);
+
+		if (nrf_profiler_transport_data_write(event_data, len) != len) {
+			/* Transport is full, retry on the next flush. */
+			return false;
+		}
+
+		tail += sizeof(hdr) + len;
+		(void)atomic_set(&sbuf->tail, tail);
+	}
+
+	return true;
+}
+
+static void dropped_events_report(struct staging_buf *sbuf)
+{
+	struct log_event_buf buf;
+	atomic_val_t dropped = atomic_set(&sbuf->dropped, 0);
+	size_t data_len;
+
+	if (dropped == 0) {
+		return;
+	}
+
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint32(&buf, (uint32_t)dropped);
+	buf.payload_start[0] = (uint8_t)dropped_events_event_id;
+	data_len = buf.payload - buf.payload_start;
+
+	if (nrf_profiler_transport_data_write(buf.payload_start, data_len) != data_len) {
+		/* Report the events on the next flush. */
+		(void)atomic_add(&sbuf->dropped, dropped);
+	}
+}
+
+static void staging_flush_all(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(staging_bufs); i++) {
+		if (staging_flush(&staging_bufs[i])) {
+			dropped_events_report(&staging_bufs[i]);
+		}
+	}
+}
+
+static void nrf_profiler_flush_thread_fn(void)
+{
+	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
+		(void)k_sem_take(&flush_sem, K_MSEC(CONFIG_NRF_PROFILER_NORDIC_FLUSH_INTERVAL_MS));
+		staging_flush_all();
+	}
+
+	/* Flush events logged before the nrf_profiler was terminated. */
+	staging_flush_all();
 	k_sem_give(&nrf_profiler_sem);
 }
+#endif /* CONFIG_NRF_PROFILER_NORDIC_STAGING */
 
 int nrf_profiler_init(void)
 {
@@ -221,31 +409,13 @@ int nrf_profiler_init(void)
 		atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
 	}
 
-	int ret;
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-		"Nordic nrf_profiler data",
-		buffer_data,
-		CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-		"Nordic nrf_profiler info",
-		buffer_info,
-		CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigDownBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		"Nordic nrf_profiler command",
-		buffer_commands,
-		CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
+	int ret = nrf_profiler_transport_init();
+
+	if (ret) {
+		atomic_set(&nrf_profiler_state, STATE_DISABLED);
+		k_sched_unlock();
+		return ret;
+	}
 
 	protocol_thread_id =  k_thread_create(&nrf_profiler_nordic_thread,
 			nrf_profiler_nordic_stack,
@@ -254,9 +424,27 @@ int nrf_profiler_init(void)
 			NULL, NULL, NULL,
 			CONFIG_NRF_PROFILER_NORDIC_THREAD_PRIORITY, 0, K_NO_WAIT);
 
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+	k_thread_create(&nrf_profiler_flush_thread,
+			nrf_profiler_flush_stack,
+			K_THREAD_STACK_SIZEOF(nrf_profiler_flush_stack),
+			(k_thread_entry_t)nrf_profiler_flush_thread_fn,
+			NULL, NULL, NULL,
+			CONFIG_NRF_PROFILER_NORDIC_FLUSH_THREAD_PRIORITY, 0, K_NO_WAIT);
+
+	/* Registering dropped events event */
+	static const char * const dropped_events_arg_names[] = {"count"};
+	static const enum nrf_profiler_arg dropped_events_arg_types[] = {NRF_PROFILER_ARG_U32};
+
+	dropped_events_event_id = nrf_profiler_register_event_type(
+					"_nrf_profiler_dropped_events_",
+					dropped_events_arg_names, dropped_events_arg_types,
+					ARRAY_SIZE(dropped_events_arg_types));
+#else
 	/* Registering fatal error event */
 	fatal_error_event_id = nrf_profiler_register_event_type("_nrf_profiler_fatal_error_event_",
 							    NULL, NULL, 0);
+#endif
 
 	k_sched_unlock();
 	return 0;
@@ -271,6 +459,11 @@ void nrf_profiler_term(void)
 
 	k_wakeup(protocol_thread_id);
 	k_sem_take(&nrf_profiler_sem, K_FOREVER);
+
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+	k_sem_give(&flush_sem);
+	k_sem_take(&nrf_profiler_sem, K_FOREVER);
+#endif
 }
 
 const char *nrf_profiler_get_event_descr(size_t nrf_profiler_event_id)
@@ -319,7 +512,7 @@ uint16_t nrf_profiler_register_event_type(const char *name, const char * const *
 	/* Memory barrier to make sure that data is visible
 	 * before being accessed
 	 */
-	__DMB();
+	barrier_dmem_fence_full();
 	nrf_profiler_num_events++;
 	k_sched_unlock();
 
@@ -394,17 +587,47 @@ void nrf_profiler_log_encode_string(struct log_event_buf *buf, const char *strin
 void nrf_profiler_log_add_mem_address(struct log_event_buf *buf,
 				  const void *mem_address)
 {
-	nrf_profiler_log_encode_uint32(buf, (uint32_t)mem_address);
+	nrf_profiler_log_encode_uint32(buf, (uint32_t)(uintptr_t)mem_address);
 }
 
-static bool nrf_profiler_RTT_send(struct log_event_buf *buf, uint8_t type_id)
+void nrf_profiler_log_send_raw(uint16_t event_type_id, const uint8_t *payload, size_t len)
+{
+	struct log_event_buf buf;
+	/* Event type ID and timestamp precede the payload. */
+	uint8_t *data = buf.payload_start + sizeof(uint8_t) + sizeof(uint32_t);
+
+	__ASSERT_NO_MSG(data - buf.payload_start + len <= CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN);
+
+	/* Skip fetching the timestamp if the event would be dropped anyway. */
+	if (atomic_get(&nrf_profiler_state) != STATE_ACTIVE) {
+		return;
+	}
+
+	sys_put_le32(k_cycle_get_32(), &buf.payload_start[sizeof(uint8_t)]);
+	memcpy(data, payload, len);
+	buf.payload = data + len;
+
+	nrf_profiler_log_send(&buf, event_type_id);
+}
+
+#ifdef CONFIG_NRF_PROFILER_NORDIC_STAGING
+void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
+{
+	__ASSERT_NO_MSG(event_type_id <= UINT8_MAX);
+
+	if (atomic_get(&nrf_profiler_state) == STATE_ACTIVE) {
+		buf->payload_start[0] = event_type_id & UINT8_MAX;
+		staging_put(buf->payload_start, buf->payload - buf->payload_start);
+	}
+}
+#else
+static bool nrf_profiler_data_send(struct log_event_buf *buf, uint8_t type_id)
 {
 	buf->payload_start[0] = type_id;
 	size_t data_len = buf->payload - buf->payload_start;
 
-	size_t num_bytes_send = SEGGER_RTT_WriteNoLock(
-			CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-			buf->payload_start, data_len);
+	size_t num_bytes_send = nrf_profiler_transport_data_write(buf->payload_start, data_len);
+
 	return (num_bytes_send == data_len);
 }
 
@@ -415,7 +638,7 @@ static void nrf_profiler_fatal_error(void)
 	nrf_profiler_log_start(&buf);
 	while (true) {
 		/* Sending Fatal Error event */
-		if (nrf_profiler_RTT_send(&buf, (uint8_t)fatal_error_event_id)) {
+		if (nrf_profiler_data_send(&buf, (uint8_t)fatal_error_event_id)) {
 			break;
 		}
 	}
@@ -431,9 +654,10 @@ void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
 
 		k_spinlock_key_t key = k_spin_lock(&lock);
 
-		if (!nrf_profiler_RTT_send(buf, type_id)) {
+		if (!nrf_profiler_data_send(buf, type_id)) {
 			nrf_profiler_fatal_error();
 		}
 		k_spin_unlock(&lock, key);
 	}
 }
+#endif /* CONFIG_NRF_PROFILER_NORDIC_STAGING */
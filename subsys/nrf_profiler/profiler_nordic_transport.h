@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PROFILER_NORDIC_TRANSPORT_H_
+#define _PROFILER_NORDIC_TRANSPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Transport used by the Nordic nrf_profiler to exchange data with the host.
+ * Exactly one transport implementation is built, selected with Kconfig.
+ */
+
+/** @brief Initialize the transport.
+ *
+ * @retval 0 If the operation was successful.
+ * @return Negative error code otherwise.
+ */
+int nrf_profiler_transport_init(void);
+
+/** @brief Write event data.
+ *
+ * The data is either written entirely or not at all.
+ *
+ * @param data Event data.
+ * @param len Length of the event data.
+ *
+ * @return Number of bytes written.
+ */
+size_t nrf_profiler_transport_data_write(const uint8_t *data, size_t len);
+
+/** @brief Start writing a new copy of the event descriptions and system configuration.
+ *
+ * Information written before is replaced if the transport stores it.
+ */
+void nrf_profiler_transport_info_start(void);
+
+/** @brief Write event descriptions or system configuration.
+ *
+ * @param data Information data.
+ * @param len Length of the information data.
+ *
+ * @return Number of bytes written.
+ */
+size_t nrf_profiler_transport_info_write(const char *data, size_t len);
+
+/** @brief Read commands sent by the host.
+ *
+ * Available only if the transport selects CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_COMMANDS.
+ *
+ * @param data Buffer for the commands.
+ * @param len Size of the buffer.
+ *
+ * @return Number of bytes read.
+ */
+size_t nrf_profiler_transport_command_read(uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PROFILER_NORDIC_TRANSPORT_H_ */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+
+#include "cmdline.h"
+#include "soc.h"
+
+#include "profiler_nordic_transport.h"
+#include "profiler_nordic_transport_file_bottom.h"
+
+#define DATA_FILE_SUFFIX ".bin"
+#define INFO_FILE_SUFFIX ".info"
+#define FILE_PATH_MAX_LEN 256
+
+static const char *file_path = CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE_PATH;
+static int data_fd = -1;
+static int info_fd = -1;
+
+static int file_open(const char *suffix)
+{
+	char path[FILE_PATH_MAX_LEN];
+	int len = snprintf(path, sizeof(path), "%s%s", file_path, suffix);
+	int fd;
+
+	if ((len < 0) || ((size_t)len >= sizeof(path))) {
+		return -ENAMETOOLONG;
+	}
+
+	fd = nrf_profiler_file_open(path);
+	if (fd < 0) {
+		printk("nrf_profiler: cannot open %s\n", path);
+		return -EIO;
+	}
+
+	return fd;
+}
+
+int nrf_profiler_transport_init(void)
+{
+	data_fd = file_open(DATA_FILE_SUFFIX);
+	if (data_fd < 0) {
+		return data_fd;
+	}
+
+	info_fd = file_open(INFO_FILE_SUFFIX);
+	if (info_fd < 0) {
+		(void)nrf_profiler_file_close(data_fd);
+		data_fd = -1;
+		return info_fd;
+	}
+
+	return 0;
+}
+
+static size_t file_write(int fd, const void *data, size_t len)
+{
+	long ret = nrf_profiler_file_write(fd, data, len);
+
+	return (ret < 0) ? 0 : (size_t)ret;
+}
+
+size_t nrf_profiler_transport_data_write(const uint8_t *data, size_t len)
+{
+	return file_write(data_fd, data, len);
+}
+
+void nrf_profiler_transport_info_start(void)
+{
+	(void)nrf_profiler_file_truncate(info_fd);
+}
+
+size_t nrf_profiler_transport_info_write(const char *data, size_t len)
+{
+	return file_write(info_fd, data, len);
+}
+
+static void nrf_profiler_file_options(void)
+{
+	static struct args_struct_t options[] = {
+		{
+			.option = "nrf_profiler_file",
+			.name = "path",
+			.type = 's',
+			.dest = (void *)&file_path,
+			.descript = "Path of the nRF Profiler files without the extension. Event data "
+				    "is written to <path>" DATA_FILE_SUFFIX " and event descriptions "
+				    "to <path>" INFO_FILE_SUFFIX ". By default \""
+				    CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE_PATH "\"",
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(nrf_profiler_file_options, PRE_BOOT_1, 1);
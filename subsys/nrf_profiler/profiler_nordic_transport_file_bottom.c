@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "profiler_nordic_transport_file_bottom.h"
+
+int nrf_profiler_file_open(const char *path)
+{
+	return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+int nrf_profiler_file_close(int fd)
+{
+	return close(fd);
+}
+
+int nrf_profiler_file_truncate(int fd)
+{
+	if (ftruncate(fd, 0) != 0) {
+		return -1;
+	}
+
+	return (lseek(fd, 0, SEEK_SET) == 0) ? 0 : -1;
+}
+
+long nrf_profiler_file_write(int fd, const void *data, size_t len)
+{
+	return write(fd, data, len);
+}
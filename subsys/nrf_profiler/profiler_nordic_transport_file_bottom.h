@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _PROFILER_NORDIC_TRANSPORT_FILE_BOTTOM_H_
+#define _PROFILER_NORDIC_TRANSPORT_FILE_BOTTOM_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Host side of the file transport. The functions are built with the host C library,
+ * so only plain C types are used in the interface.
+ */
+
+/** @brief Create or truncate a host file and open it for writing.
+ *
+ * @param path Path to the file.
+ *
+ * @return File descriptor, negative value on error.
+ */
+int nrf_profiler_file_open(const char *path);
+
+/** @brief Close a host file.
+ *
+ * @param fd File descriptor.
+ *
+ * @return 0 on success, negative value on error.
+ */
+int nrf_profiler_file_close(int fd);
+
+/** @brief Remove the content of a host file.
+ *
+ * @param fd File descriptor.
+ *
+ * @return 0 on success, negative value on error.
+ */
+int nrf_profiler_file_truncate(int fd);
+
+/** @brief Write data to a host file.
+ *
+ * @param fd File descriptor.
+ * @param data Data to write.
+ * @param len Length of the data.
+ *
+ * @return Number of bytes written, negative value on error.
+ */
+long nrf_profiler_file_write(int fd, const void *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PROFILER_NORDIC_TRANSPORT_FILE_BOTTOM_H_ */
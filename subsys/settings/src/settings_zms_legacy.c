@@ -117,6 +117,7 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 	char name[SETTINGS_FULL_NAME_LEN];
 	ssize_t rc1, rc2;
 	uint32_t name_id = ZMS_NAMECNT_ID;
+	const char *subtree = (arg != NULL) ? arg->subtree : NULL;
 
 #if CONFIG_SETTINGS_ZMS_NAME_CACHE
 	uint32_t cached = 0;
@@ -142,6 +143,22 @@ static int settings_zms_load(struct settings_store *cs, const struct settings_lo
 		 * setting's value.
 		 */
 		rc1 = zms_read(&cf->cf_zms, name_id, &name, sizeof(name));
+
+		if ((rc1 > 0) && subtree) {
+			name[rc1] = '\0';
+
+			/* Items outside of the requested subtree are not passed to
+			 * the handlers, so skip the lookup of their value.
+			 */
+			if (!settings_name_steq(name, subtree, NULL)) {
+#if CONFIG_SETTINGS_ZMS_NAME_CACHE
+				settings_zms_cache_add(cf, name, name_id);
+				cached++;
+#endif
+				continue;
+			}
+		}
+
 		/* get the length of data and verify that it exists */
 		rc2 = zms_get_data_length(&cf->cf_zms, name_id + ZMS_NAME_ID_OFFSET);
 
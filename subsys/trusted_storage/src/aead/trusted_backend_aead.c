@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <zephyr/kernel.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/logging/log.h>
 #include <mbedtls/platform_util.h>
@@ -35,6 +36,8 @@ LOG_MODULE_REGISTER(internal_trusted_aead, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
 
 #define INVALID_UID 0U
 
+#define KEY_CACHE_SIZE CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_SIZE
+
 /** Header of stored object. Supplied as additional data when encrypting. */
 typedef struct stored_object_header {
 	psa_storage_create_flags_t create_flags;
@@ -47,6 +50,76 @@ typedef struct stored_object {
 	uint8_t data[AEAD_MAX_BUF_SIZE];
 } stored_object;
 
+#if KEY_CACHE_SIZE > 0
+typedef struct key_cache_entry {
+	psa_storage_uid_t uid;
+	uint32_t last_used;
+	uint8_t key[AEAD_KEY_SIZE];
+} key_cache_entry;
+
+static key_cache_entry key_cache[KEY_CACHE_SIZE];
+static uint32_t key_cache_use_cnt;
+static K_MUTEX_DEFINE(key_cache_mutex);
+
+static psa_status_t get_key(const psa_storage_uid_t uid, uint8_t *key_buf)
+{
+	psa_status_t status;
+	key_cache_entry *entry = &key_cache[0];
+
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].uid == uid) {
+			memcpy(key_buf, key_cache[i].key, AEAD_KEY_SIZE);
+			key_cache[i].last_used = ++key_cache_use_cnt;
+			k_mutex_unlock(&key_cache_mutex);
+
+			return PSA_SUCCESS;
+		}
+
+		/* Unused entries have the lowest last_used value. */
+		if (key_cache[i].last_used < entry->last_used) {
+			entry = &key_cache[i];
+		}
+	}
+
+	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	if (status == PSA_SUCCESS) {
+		memcpy(entry->key, key_buf, AEAD_KEY_SIZE);
+		entry->uid = uid;
+		entry->last_used = ++key_cache_use_cnt;
+	}
+
+	k_mutex_unlock(&key_cache_mutex);
+
+	return status;
+}
+
+static void key_cache_remove(const psa_storage_uid_t uid)
+{
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].uid == uid) {
+			mbedtls_platform_zeroize(&key_cache[i], sizeof(key_cache[i]));
+			break;
+		}
+	}
+
+	k_mutex_unlock(&key_cache_mutex);
+}
+#else
+static psa_status_t get_key(const psa_storage_uid_t uid, uint8_t *key_buf)
+{
+	return trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+}
+
+static void key_cache_remove(const psa_storage_uid_t uid)
+{
+	ARG_UNUSED(uid);
+}
+#endif /* KEY_CACHE_SIZE > 0 */
+
 psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
 			      struct psa_storage_info_t *p_info)
 {
@@ -92,17 +165,19 @@ psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t
 		return PSA_ERROR_INVALID_ARGUMENT;
 	}
 
-	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	/* Retrieve object from storage. Done before getting the key to not derive the key
+	 * for objects that do not exist.
+	 */
+	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
+				    &out_length);
 	if (status != PSA_SUCCESS) {
-		return status;
+		goto clean_up;
 	}
 
-	/* Retrieve object from storage */
-	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
-				    &out_length);
+	/* Get AEAD key */
+	status = get_key(uid, key_buf);
 	if (status != PSA_SUCCESS) {
-		return status;
+		goto clean_up;
 	}
 
 	status = trusted_storage_aead_decrypt(
@@ -173,7 +248,7 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 	}
 
 	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	status = get_key(uid, key_buf);
 	if (status != PSA_SUCCESS) {
 		goto cleanup_objects;
 	}
@@ -238,6 +313,8 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
 		return PSA_ERROR_NOT_PERMITTED;
 	}
 
+	key_cache_remove(uid);
+
 	return storage_remove_object(uid, prefix);
 }
 
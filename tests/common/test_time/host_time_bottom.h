@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _HOST_TIME_BOTTOM_H_
+#define _HOST_TIME_BOTTOM_H_
+
+#include <stdint.h>
+
+/** @brief Get the monotonic host time.
+ *
+ * @return Host time in nanoseconds.
+ */
+uint64_t host_time_ns_get(void);
+
+#endif /* _HOST_TIME_BOTTOM_H_ */
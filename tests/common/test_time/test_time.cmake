@@ -0,0 +1,14 @@
+#
+# Copyright (c) 2025 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+# Adds test_time.h to the application. On POSIX architectures, the host time
+# is read from the native simulator runner.
+
+target_include_directories(app PRIVATE ${CMAKE_CURRENT_LIST_DIR})
+
+if(CONFIG_ARCH_POSIX)
+  target_sources(native_simulator INTERFACE ${CMAKE_CURRENT_LIST_DIR}/host_time_bottom.c)
+endif()
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _TEST_TIME_H_
+#define _TEST_TIME_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef CONFIG_ARCH_POSIX
+#include "host_time_bottom.h"
+#endif
+
+/** @brief Get the time for measuring the duration of a test operation.
+ *
+ * On POSIX architectures, the simulated time does not advance while the CPU
+ * is busy, so the host time is used instead.
+ *
+ * @return Time in nanoseconds.
+ */
+static inline uint64_t test_time_ns_get(void)
+{
+#ifdef CONFIG_ARCH_POSIX
+	return host_time_ns_get();
+#else
+	return k_cyc_to_ns_floor64(k_cycle_get_64());
+#endif
+}
+
+#endif /* _TEST_TIME_H_ */
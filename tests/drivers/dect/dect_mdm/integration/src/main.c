@@ -44,6 +44,7 @@ extern void test_dect_ft_cluster_associate_child_with_global_address(void);
 extern void test_dect_ft_cluster_associate_child_with_global_address_2(void);
 extern void test_dect_ft_sink_global_address_change(void);
 extern void test_dect_ft_sckt_packet_rx_tx(void);
+extern void test_dect_ft_sckt_packet_rx_burst(void);
 extern void test_dect_ft_local_multicast_tx(void);
 extern void test_dect_ft_network_remove(void);
 extern void test_dect_ft_sink_down(void);
@@ -111,6 +112,7 @@ static test_result_t test_results[] = {
 	{"test_dect_ft_cluster_associate_child_with_global_address_2", false},
 	{"test_dect_ft_sink_global_address_change", false},
 	{"test_dect_ft_sckt_packet_rx_tx", false},
+	{"test_dect_ft_sckt_packet_rx_burst", false},
 	{"test_dect_ft_local_multicast_tx", false},
 	{"test_dect_ft_network_remove", false},
 	{"test_dect_ft_sink_down", false},
@@ -191,18 +193,19 @@ int main(void)
 	RUN_TEST_AND_TRACK(test_dect_ft_cluster_associate_child_with_global_address_2, 39);
 	RUN_TEST_AND_TRACK(test_dect_ft_sink_global_address_change, 40);
 	RUN_TEST_AND_TRACK(test_dect_ft_sckt_packet_rx_tx, 41);
-	RUN_TEST_AND_TRACK(test_dect_ft_local_multicast_tx, 42);
-	RUN_TEST_AND_TRACK(test_dect_ft_network_remove, 43);
-	RUN_TEST_AND_TRACK(test_dect_ft_sink_down, 44);
-	RUN_TEST_AND_TRACK(test_dect_ft_conn_mgr_connect, 45);
-	RUN_TEST_AND_TRACK(test_dect_ft_conn_mgr_disconnect, 46);
+	RUN_TEST_AND_TRACK(test_dect_ft_sckt_packet_rx_burst, 42);
+	RUN_TEST_AND_TRACK(test_dect_ft_local_multicast_tx, 43);
+	RUN_TEST_AND_TRACK(test_dect_ft_network_remove, 44);
+	RUN_TEST_AND_TRACK(test_dect_ft_sink_down, 45);
+	RUN_TEST_AND_TRACK(test_dect_ft_conn_mgr_connect, 46);
+	RUN_TEST_AND_TRACK(test_dect_ft_conn_mgr_disconnect, 47);
 	/* Rerun sink_down so L2 removes FT global from DECT iface
 	 * (NET_EVENT_IF_DOWN → prefix removed);
 	 * then PT conn_mgr_connect sees no stale global.
 	 */
-	RUN_TEST_AND_TRACK(test_dect_ft_sink_down, 47);
-	RUN_TEST_AND_TRACK(test_dect_pt_conn_mgr_connect, 48);
-	RUN_TEST_AND_TRACK(test_dect_pt_conn_mgr_disconnect, 49);
+	RUN_TEST_AND_TRACK(test_dect_ft_sink_down, 48);
+	RUN_TEST_AND_TRACK(test_dect_pt_conn_mgr_connect, 49);
+	RUN_TEST_AND_TRACK(test_dect_pt_conn_mgr_disconnect, 50);
 	/* TODO more tests & coverity */
 
 	/* Capture Unity statistics before UNITY_END() */
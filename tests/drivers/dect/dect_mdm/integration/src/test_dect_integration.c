@@ -28,6 +28,7 @@
 #include "unity.h"
 #include "mock_nrf_modem_dect_mac.h"
 #include "test_dect_utils.h"
+#include "dect_mdm_rx.h"
 
 /* Real DECT API includes for integration testing */
 #include <zephyr/net/net_if.h>
@@ -4038,11 +4039,93 @@ void test_dect_ft_sckt_packet_rx_tx(void)
 
 	zsock_close(sockfd);
 }
+
+/**
+ * @brief Test burst of RX frames from associated child via AF_PACKET SOCK_DGRAM
+ *
+ * Runs after test_dect_ft_sckt_packet_rx_tx. Injects a burst of frames from the mock
+ * (dlc_data_rx_ntf) faster than the RX thread is scheduled, verifies that all of them
+ * are received in order and that the driver RX statistics report no drops.
+ */
+void test_dect_ft_sckt_packet_rx_burst(void)
+{
+	struct sockaddr_ll bind_addr = {0};
+	struct dect_mdm_rx_stats stats;
+	int sockfd;
+	int ret;
+	const uint32_t child_long_rd_id = 0xCAFEBABE;
+	const int burst_count = 8;
+	char rx_buf[DECT_MTU];
+	uint8_t payload[16];
+
+	TEST_ASSERT_NOT_NULL_MESSAGE(test_iface, "DECT test iface should be set");
+	TEST_ASSERT_NOT_NULL_MESSAGE(mock_ntf_callbacks.dlc_data_rx_ntf,
+				     "dlc_data_rx_ntf callback should be registered");
+
+	sockfd = zsock_socket(AF_PACKET, SOCK_DGRAM, htons(ETH_P_ALL));
+	TEST_ASSERT_TRUE_MESSAGE(sockfd >= 0, "AF_PACKET SOCK_DGRAM socket should be created");
+
+	bind_addr.sll_family = AF_PACKET;
+	bind_addr.sll_ifindex = net_if_get_by_iface(test_iface);
+
+	ret = zsock_bind(sockfd, (struct sockaddr *)&bind_addr, sizeof(struct sockaddr_ll));
+	TEST_ASSERT_EQUAL_MESSAGE(0, ret, "Bind to DECT iface should succeed");
+
+	struct timeval tv = {.tv_sec = 0, .tv_usec = 300 * 1000};
+
+	ret = zsock_setsockopt(sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	TEST_ASSERT_EQUAL_MESSAGE(0, ret, "setsockopt SO_RCVTIMEO should succeed");
+
+	dect_mdm_rx_stats_reset();
+
+	/* Inject without yielding so that the RX thread finds the whole burst pending */
+	for (int i = 0; i < burst_count; i++) {
+		memset(payload, i, sizeof(payload));
+
+		struct nrf_modem_dect_dlc_data_rx_ntf_cb_params rx_params = {
+			.flow_id = 0,
+			.long_rd_id = child_long_rd_id,
+			.data = payload,
+			.data_len = sizeof(payload),
+		};
+
+		mock_ntf_callbacks.dlc_data_rx_ntf(&rx_params);
+	}
+
+	k_sleep(K_MSEC(200));
+
+	for (int i = 0; i < burst_count; i++) {
+		ret = zsock_recvfrom(sockfd, rx_buf, sizeof(rx_buf), 0, NULL, NULL);
+		TEST_ASSERT_EQUAL_MESSAGE((int)sizeof(payload), ret,
+					  "recvfrom should return each injected frame");
+		TEST_ASSERT_EACH_EQUAL_UINT8_MESSAGE(i, rx_buf, sizeof(payload),
+						     "Frames should be received in order");
+	}
+
+	dect_mdm_rx_stats_get(&stats);
+	LOG_INF("RX burst: delivered %u, queue depth max %u, batch max %u", stats.delivered,
+		stats.queue_depth_max, stats.batch_max);
+
+	TEST_ASSERT_EQUAL_MESSAGE(burst_count, stats.delivered,
+				  "All burst frames should be delivered to the stack");
+	TEST_ASSERT_EQUAL_MESSAGE(0, stats.dropped_no_mem, "No RX event pool drops expected");
+	TEST_ASSERT_EQUAL_MESSAGE(0, stats.dropped_queue_full, "No RX queue drops expected");
+	TEST_ASSERT_EQUAL_MESSAGE(0, stats.dropped_stack, "No IP stack drops expected");
+	TEST_ASSERT_TRUE_MESSAGE(stats.batch_max > 1,
+				 "Pending frames should be handled in batches");
+
+	zsock_close(sockfd);
+}
 #else
 void test_dect_ft_sckt_packet_rx_tx(void)
 {
 	TEST_IGNORE_MESSAGE("CONFIG_NET_SOCKETS_PACKET_DGRAM not enabled");
 }
+
+void test_dect_ft_sckt_packet_rx_burst(void)
+{
+	TEST_IGNORE_MESSAGE("CONFIG_NET_SOCKETS_PACKET_DGRAM not enabled");
+}
 #endif
 
 /**
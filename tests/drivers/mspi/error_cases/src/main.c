@@ -37,7 +37,7 @@ static const struct mspi_cfg default_hw_cfg = {
 	.re_init          = true,
 };
 
-uint8_t memc_write_buffer[256];
+uint8_t memc_write_buffer[256] __aligned(4);
 
 static struct mspi_xfer_packet packet1[] = {
 	{
@@ -57,6 +57,7 @@ static struct mspi_xfer default_xfer = {
 	.cmd_length       = 1,
 	.addr_length      = 3,
 	.priority         = 1,
+	.timeout          = CONFIG_MSPI_COMPLETION_TIMEOUT_TOLERANCE,
 	.packets          = (struct mspi_xfer_packet *)&packet1,
 	.num_packet       = sizeof(packet1) / sizeof(struct mspi_xfer_packet),
 };
@@ -534,7 +535,7 @@ ZTEST(mspi_error_cases, test_22a_mspi_xfer_async_true)
 
 	xfer.async = true;
 
-	check_mspi_transceive(&xfer, -ENOTSUP);
+	check_mspi_transceive(&xfer, IS_ENABLED(CONFIG_MSPI_HPF_ASYNC) ? 0 : -ENOTSUP);
 }
 
 ZTEST(mspi_error_cases, test_22a_mspi_xfer_async_false)
@@ -683,4 +684,72 @@ ZTEST(mspi_error_cases, test_34a_mspi_xfer_packet_num_bytes_max)
 	check_mspi_transceive(&xfer, -EINVAL);
 }
 
+#if defined(CONFIG_MSPI_HPF_ASYNC)
+#define ASYNC_PACKET_CNT  6
+#define ASYNC_PACKET_SIZE 32
+
+static K_SEM_DEFINE(xfer_complete_sem, 0, ASYNC_PACKET_CNT);
+static struct mspi_callback_context xfer_complete_ctx;
+static uint32_t xfer_complete_idx[ASYNC_PACKET_CNT];
+static size_t xfer_complete_cnt;
+
+static void xfer_complete_cb(struct mspi_callback_context *ctx, ...)
+{
+	zassert_equal(ctx->mspi_evt.evt_type, MSPI_BUS_XFER_COMPLETE, "Unexpected event");
+	zassert_equal(ctx->mspi_evt.evt_data.status, 0, "Unexpected packet status");
+
+	if (xfer_complete_cnt < ARRAY_SIZE(xfer_complete_idx)) {
+		xfer_complete_idx[xfer_complete_cnt] = ctx->mspi_evt.evt_data.packet_idx;
+	}
+	xfer_complete_cnt++;
+
+	k_sem_give(&xfer_complete_sem);
+}
+
+ZTEST(mspi_error_cases, test_35a_mspi_xfer_async_complete_cb)
+{
+	struct mspi_xfer_packet packets[ASYNC_PACKET_CNT];
+	struct mspi_xfer xfer = default_xfer;
+
+	BUILD_ASSERT(ASYNC_PACKET_CNT * ASYNC_PACKET_SIZE <= sizeof(memc_write_buffer));
+
+	/* More packets than can be queued at once, so that the pipeline is refilled. */
+	for (size_t i = 0; i < ARRAY_SIZE(packets); i++) {
+		packets[i] = packet1[0];
+		packets[i].num_bytes = ASYNC_PACKET_SIZE;
+		packets[i].data_buf = &memc_write_buffer[i * ASYNC_PACKET_SIZE];
+		packets[i].cb_mask = MSPI_BUS_XFER_COMPLETE_CB;
+	}
+
+	xfer.async = true;
+	xfer.packets = packets;
+	xfer.num_packet = ARRAY_SIZE(packets);
+
+	xfer_complete_cnt = 0;
+	k_sem_reset(&xfer_complete_sem);
+
+	ret = mspi_register_callback(mspi_bus, &dev_id[0], MSPI_BUS_XFER_COMPLETE,
+				     xfer_complete_cb, &xfer_complete_ctx);
+	zassert_equal(ret, 0, "Got unexpected %d instead of 0", ret);
+
+	check_mspi_transceive(&xfer, 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(packets); i++) {
+		ret = k_sem_take(&xfer_complete_sem, K_MSEC(CONFIG_MSPI_COMPLETION_TIMEOUT_TOLERANCE));
+		zassert_equal(ret, 0, "Packet %zu not completed", i);
+	}
+
+	zassert_equal(xfer_complete_cnt, ARRAY_SIZE(packets), "Unexpected completion count");
+	for (size_t i = 0; i < ARRAY_SIZE(packets); i++) {
+		zassert_equal(xfer_complete_idx[i], i, "Packets completed out of order");
+	}
+
+	ret = mspi_register_callback(mspi_bus, &dev_id[0], MSPI_BUS_XFER_COMPLETE, NULL, NULL);
+	zassert_equal(ret, 0, "Got unexpected %d instead of 0", ret);
+
+	/* The bus is released after the last packet is completed. */
+	check_mspi_transceive(&default_xfer, 0);
+}
+#endif
+
 ZTEST_SUITE(mspi_error_cases, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#define TEST_EVENT_NAME "test_event"
+#define IN_FLIGHT_MAX CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_SAMPLING_IN_FLIGHT_MAX
+#define RECORDS_MAX 32
+#define REGISTERED_EVENTS_MAX 8
+
+/* Time for which the Application Event Manager processes submitted events. */
+#define PROCESSING_TIMEOUT K_MSEC(10)
+/* Length of the rate limit window. */
+#define RATE_WINDOW K_MSEC(1000)
+
+struct test_event {
+	struct app_event_header header;
+};
+
+APP_EVENT_TYPE_DECLARE(test_event);
+
+static void profile_test_event(struct log_event_buf *buf, const struct app_event_header *aeh)
+{
+}
+
+APP_EVENT_INFO_DEFINE(test_event, ENCODE(), ENCODE(), profile_test_event);
+
+APP_EVENT_TYPE_DEFINE(test_event, NULL, &test_event_info, APP_EVENT_FLAGS_CREATE());
+
+struct record {
+	uint16_t type_id;
+	uint8_t event_id;
+	uint32_t mem_address;
+};
+
+static struct record records[RECORDS_MAX];
+static size_t record_cnt;
+
+static const char *registered_names[REGISTERED_EVENTS_MAX];
+static uint16_t registered_cnt;
+
+/** Mocks ******************************************/
+
+int __wrap_nrf_profiler_init(void)
+{
+	return 0;
+}
+
+uint16_t __wrap_nrf_profiler_register_event_type(const char *name, const char * const *args,
+						 const enum nrf_profiler_arg *arg_types,
+						 uint8_t arg_cnt)
+{
+	zassert_true(registered_cnt < ARRAY_SIZE(registered_names), "Too many event types");
+
+	registered_names[registered_cnt] = name;
+	atomic_set_bit(_nrf_profiler_event_enabled_bm.flags, registered_cnt);
+
+	return registered_cnt++;
+}
+
+void __wrap_nrf_profiler_log_send_raw(uint16_t event_type_id, const uint8_t *payload,
+				      size_t len)
+{
+	zassert_equal(len, sizeof(uint8_t) + sizeof(uint32_t), "Invalid compact record");
+	zassert_true(record_cnt < ARRAY_SIZE(records), "Too many records");
+
+	records[record_cnt].type_id = event_type_id;
+	records[record_cnt].event_id = payload[0];
+	records[record_cnt].mem_address = sys_get_le32(&payload[sizeof(uint8_t)]);
+	record_cnt++;
+}
+
+void __wrap_nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
+{
+	zassert_unreachable("Compact records are expected");
+}
+
+/** End of mocks ***********************************/
+
+static uint16_t registered_id_get(const char *name)
+{
+	for (uint16_t i = 0; i < registered_cnt; i++) {
+		if (!strcmp(registered_names[i], name)) {
+			return i;
+		}
+	}
+
+	zassert_unreachable("Event type %s not registered", name);
+
+	return UINT16_MAX;
+}
+
+static const void *event_submit(void)
+{
+	struct test_event *event = new_test_event();
+	const void *mem_address = &event->header;
+
+	APP_EVENT_SUBMIT(event);
+
+	return mem_address;
+}
+
+/* Submits an event and waits until it is processed. */
+static const void *event_submit_processed(void)
+{
+	const void *mem_address = event_submit();
+
+	k_sleep(PROCESSING_TIMEOUT);
+
+	return mem_address;
+}
+
+static void record_check(size_t idx, const char *record_name, const void *mem_address)
+{
+	zassert_true(idx < record_cnt, "Missing record %zu", idx);
+	zassert_equal(records[idx].type_id, registered_id_get(record_name),
+		      "Invalid record type %zu", idx);
+	zassert_equal(records[idx].event_id, registered_id_get(TEST_EVENT_NAME),
+		      "Invalid event type %zu", idx);
+	/* The tracer logs 32 bits of the event address. */
+	zassert_equal(records[idx].mem_address, (uint32_t)(uintptr_t)mem_address,
+		      "Invalid event %zu", idx);
+}
+
+/* Checks the records of an event that was submitted and processed. */
+static void event_records_check(size_t idx, const void *mem_address)
+{
+	record_check(idx, "event_submit_compact", mem_address);
+	record_check(idx + 1, "event_processing_start_compact", mem_address);
+	record_check(idx + 2, "event_processing_end_compact", mem_address);
+}
+
+static void *setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 0, 0));
+	record_cnt = 0;
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_sampling_set_unknown)
+{
+	zassert_equal(app_event_manager_profiler_tracer_sampling_set("unknown_event", 2, 0),
+		      -ENOENT);
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_no_sampling)
+{
+	const void *mem_address[3];
+
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		mem_address[i] = event_submit_processed();
+	}
+
+	zassert_equal(record_cnt, 3 * ARRAY_SIZE(mem_address));
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		event_records_check(3 * i, mem_address[i]);
+	}
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_sample_every)
+{
+	const void *mem_address[7];
+
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 3, 0));
+
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		mem_address[i] = event_submit_processed();
+	}
+
+	/* Only the third and the sixth event are profiled. */
+	zassert_equal(record_cnt, 6);
+	event_records_check(0, mem_address[2]);
+	event_records_check(3, mem_address[5]);
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_rate_limit)
+{
+	const void *mem_address[5];
+
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 1, 2));
+
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		mem_address[i] = event_submit_processed();
+	}
+
+	zassert_equal(record_cnt, 6);
+	event_records_check(0, mem_address[0]);
+	event_records_check(3, mem_address[1]);
+
+	/* The limit applies again in the next window. */
+	k_sleep(RATE_WINDOW);
+
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		mem_address[i] = event_submit_processed();
+	}
+
+	zassert_equal(record_cnt, 12);
+	event_records_check(6, mem_address[0]);
+	event_records_check(9, mem_address[1]);
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_in_flight_full)
+{
+	const void *mem_address[IN_FLIGHT_MAX + 2];
+	const void *next_mem_address;
+
+	/* The rate limit makes the sampling active, so every event is remembered. */
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 1, 100));
+
+	/* Submit more events than can be remembered before any of them is processed. */
+	k_sched_lock();
+	for (size_t i = 0; i < ARRAY_SIZE(mem_address); i++) {
+		mem_address[i] = event_submit();
+	}
+	k_sched_unlock();
+	k_sleep(PROCESSING_TIMEOUT);
+
+	/* Only the remembered events are profiled. */
+	zassert_equal(record_cnt, 3 * IN_FLIGHT_MAX);
+	for (size_t i = 0; i < IN_FLIGHT_MAX; i++) {
+		record_check(i, "event_submit_compact", mem_address[i]);
+		record_check(IN_FLIGHT_MAX + 2 * i, "event_processing_start_compact",
+			     mem_address[i]);
+		record_check(IN_FLIGHT_MAX + 2 * i + 1, "event_processing_end_compact",
+			     mem_address[i]);
+	}
+
+	/* Processed events are forgotten and make space for new ones. */
+	next_mem_address = event_submit_processed();
+	zassert_equal(record_cnt, 3 * IN_FLIGHT_MAX + 3);
+	event_records_check(3 * IN_FLIGHT_MAX, next_mem_address);
+}
+
+ZTEST(aem_profiler_tracer_sampling, test_sampling_set_in_flight)
+{
+	const void *mem_address;
+
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 1, 100));
+
+	k_sched_lock();
+	mem_address = event_submit();
+	/* Reconfiguring the sampling forgets the event waiting for processing. */
+	zassert_ok(app_event_manager_profiler_tracer_sampling_set(TEST_EVENT_NAME, 1, 200));
+	k_sched_unlock();
+	k_sleep(PROCESSING_TIMEOUT);
+
+	zassert_equal(record_cnt, 1);
+	record_check(0, "event_submit_compact", mem_address);
+}
+
+ZTEST_SUITE(aem_profiler_tracer_sampling, NULL, setup, before, NULL, NULL);
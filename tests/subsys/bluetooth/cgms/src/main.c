@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "cgms_internal.h"
+
+LOG_MODULE_REGISTER(cgms, CONFIG_BT_CGMS_LOG_LEVEL);
+
+#define RECORD_CNT		CONFIG_BT_CGMS_MAX_MEASUREMENT_RECORD
+#define PENDING_RECORD_CNT	CONFIG_BT_CGMS_RACP_MAX_PENDING_RECORDS
+
+#define RACP_OPCODE_REPORT_RECS			1
+#define RACP_OPCODE_RESPONSE_CODE		6
+#define RACP_OPERATOR_ALL			1
+#define RACP_RESPONSE_SUCCESS			1
+#define RACP_RESPONSE_PROCEDURE_NOT_DONE	8
+
+/* Time to wait for the report procedure to queue a record or a response. */
+#define TX_TIMEOUT		K_SECONDS(1)
+/* Time for which the report procedure must not queue another record. */
+#define TX_IDLE_TIMEOUT		K_MSEC(100)
+
+struct record_tx {
+	bt_gatt_complete_func_t func;
+	void *user_data;
+	uint16_t time_offset;
+};
+
+K_MSGQ_DEFINE(record_tx_msgq, sizeof(struct record_tx), PENDING_RECORD_CNT, 4);
+K_MSGQ_DEFINE(response_msgq, CGMS_RACP_MAX_LENGTH, 2, 1);
+
+static atomic_t connected;
+static uint16_t next_time_offset;
+
+/** Mocks ******************************************/
+
+int cgms_racp_send_response(struct bt_conn *peer, struct net_buf_simple *rsp)
+{
+	uint8_t data[CGMS_RACP_MAX_LENGTH] = {0};
+
+	memcpy(data, rsp->data, MIN(rsp->len, sizeof(data)));
+	zassert_ok(k_msgq_put(&response_msgq, data, K_NO_WAIT), "Response not verified");
+
+	return 0;
+}
+
+/* Records queued in the host are reported as sent only when the test completes them.
+ * Records queued before a disconnection are never reported as sent.
+ */
+int cgms_racp_send_record(struct bt_conn *peer, const struct cgms_meas *entry,
+			  bt_gatt_complete_func_t func, void *user_data)
+{
+	struct record_tx tx = {
+		.func = func,
+		.user_data = user_data,
+		.time_offset = entry->time_offset,
+	};
+
+	if (!atomic_get(&connected)) {
+		return -ENOTCONN;
+	}
+
+	zassert_ok(k_msgq_put(&record_tx_msgq, &tx, K_NO_WAIT), "Too many records queued");
+
+	return 0;
+}
+
+/** End of mocks ***********************************/
+
+/* Fills the record store with new records and returns the time offset of the first one. */
+static uint16_t records_add(void)
+{
+	uint16_t first_time_offset = next_time_offset;
+
+	for (size_t i = 0; i < RECORD_CNT; i++) {
+		struct cgms_meas meas = {
+			.glucose_concentration = i,
+			.time_offset = next_time_offset++,
+		};
+
+		zassert_ok(cgms_racp_meas_add(meas), "Cannot add record");
+	}
+
+	return first_time_offset;
+}
+
+static void report_all_request(void)
+{
+	const uint8_t req[] = {RACP_OPCODE_REPORT_RECS, RACP_OPERATOR_ALL};
+
+	zassert_true(cgms_racp_recv_request(NULL, req, sizeof(req)) > 0, "Request not queued");
+}
+
+static void report_response_check(uint8_t response_code)
+{
+	uint8_t rsp[CGMS_RACP_MAX_LENGTH];
+
+	zassert_ok(k_msgq_get(&response_msgq, rsp, TX_TIMEOUT), "No response");
+	zassert_equal(rsp[0], RACP_OPCODE_RESPONSE_CODE, "Invalid response opcode");
+	zassert_equal(rsp[2], RACP_OPCODE_REPORT_RECS, "Invalid request opcode");
+	zassert_equal(rsp[3], response_code, "Invalid response code");
+}
+
+/* Receives the queued records, allowing at most PENDING_RECORD_CNT of them to be queued. */
+static size_t records_queued_get(struct record_tx *tx, uint16_t time_offset, size_t cnt)
+{
+	struct record_tx extra_tx;
+
+	cnt = MIN(cnt, PENDING_RECORD_CNT);
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_ok(k_msgq_get(&record_tx_msgq, &tx[i], TX_TIMEOUT), "Record not queued");
+		zassert_equal(tx[i].time_offset, time_offset + i, "Invalid record");
+	}
+
+	/* No record is queued until one of the queued records is sent. */
+	zassert_equal(k_msgq_get(&record_tx_msgq, &extra_tx, TX_IDLE_TIMEOUT), -EAGAIN,
+		      "Too many records queued");
+
+	return cnt;
+}
+
+static void records_sent(struct record_tx *tx, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		tx[i].func(NULL, tx[i].user_data);
+	}
+}
+
+static void *setup(void)
+{
+	cgms_racp_init();
+
+	return NULL;
+}
+
+static void before(void *f)
+{
+	ARG_UNUSED(f);
+
+	atomic_set(&connected, true);
+	k_msgq_purge(&record_tx_msgq);
+	k_msgq_purge(&response_msgq);
+}
+
+ZTEST(cgms_racp_ts, test_report_all)
+{
+	struct record_tx tx[PENDING_RECORD_CNT];
+	uint16_t time_offset = records_add();
+	size_t reported = 0;
+
+	report_all_request();
+
+	while (reported < RECORD_CNT) {
+		size_t cnt = records_queued_get(tx, time_offset + reported, RECORD_CNT - reported);
+
+		records_sent(tx, cnt);
+		reported += cnt;
+	}
+
+	report_response_check(RACP_RESPONSE_SUCCESS);
+}
+
+ZTEST(cgms_racp_ts, test_report_disconnect)
+{
+	struct record_tx tx[PENDING_RECORD_CNT];
+	uint16_t time_offset = records_add();
+	size_t reported = 0;
+
+	report_all_request();
+	(void)records_queued_get(tx, time_offset, RECORD_CNT);
+
+	/* Peer disconnects, only the first queued record is reported as sent. */
+	atomic_set(&connected, false);
+	records_sent(tx, 1);
+	report_response_check(RACP_RESPONSE_PROCEDURE_NOT_DONE);
+
+	/* Next report queues the same number of records as the first one. */
+	atomic_set(&connected, true);
+	report_all_request();
+
+	while (reported < RECORD_CNT) {
+		size_t cnt = records_queued_get(tx, time_offset + reported, RECORD_CNT - reported);
+
+		records_sent(tx, cnt);
+		reported += cnt;
+	}
+
+	report_response_check(RACP_RESPONSE_SUCCESS);
+}
+
+ZTEST(cgms_racp_ts, test_report_stale_completion)
+{
+	struct record_tx stale_tx[PENDING_RECORD_CNT];
+	struct record_tx tx[PENDING_RECORD_CNT];
+	struct record_tx extra_tx;
+	uint16_t time_offset = records_add();
+	size_t stale_cnt;
+	size_t reported = 0;
+
+	report_all_request();
+	stale_cnt = records_queued_get(stale_tx, time_offset, RECORD_CNT);
+
+	/* Peer disconnects, only the first queued record is reported as sent. */
+	atomic_set(&connected, false);
+	records_sent(stale_tx, 1);
+	report_response_check(RACP_RESPONSE_PROCEDURE_NOT_DONE);
+
+	atomic_set(&connected, true);
+	report_all_request();
+	(void)records_queued_get(tx, time_offset, RECORD_CNT);
+
+	/* Records queued by the previous report must not let more records be queued. */
+	records_sent(&stale_tx[1], stale_cnt - 1);
+	zassert_equal(k_msgq_get(&record_tx_msgq, &extra_tx, TX_IDLE_TIMEOUT), -EAGAIN,
+		      "Record queued for a stale completion");
+
+	while (true) {
+		size_t cnt = MIN(RECORD_CNT - reported, PENDING_RECORD_CNT);
+
+		records_sent(tx, cnt);
+		reported += cnt;
+		if (reported == RECORD_CNT) {
+			break;
+		}
+
+		(void)records_queued_get(tx, time_offset + reported, RECORD_CNT - reported);
+	}
+
+	report_response_check(RACP_RESPONSE_SUCCESS);
+}
+
+ZTEST_SUITE(cgms_racp_ts, NULL, setup, before, NULL, NULL);
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <math.h>
+#include <zephyr/sys/util.h>
 
 #include <bluetooth/cs_de.h>
 
@@ -125,6 +126,164 @@ void test_cs_de_calc_with_ideal_iq_data(void)
 	}
 }
 
+/* Maximum number of propagation paths in a multipath test case. */
+#define MULTIPATH_MAX_PATHS (3)
+
+struct multipath_case {
+	struct {
+		float distance;
+		float amplitude;
+	} paths[MULTIPATH_MAX_PATHS];
+	uint8_t n_paths;
+	/* Estimates calculated with the implementation that scaled the IFFT and took the
+	 * square root of every bin, for the default NFFT size of 512.
+	 */
+	float ifft;
+	float phase_slope;
+};
+
+static const struct multipath_case multipath_cases[] = {
+	{{{3.0f, 100.0f}, {7.5f, 60.0f}}, 2, 2.71017f, 4.52494f},
+	{{{12.3f, 100.0f}, {14.1f, 80.0f}}, 2, 12.58894f, 13.06678f},
+	{{{25.0f, 40.0f}, {31.2f, 100.0f}}, 2, 28.12607f, 29.92298f},
+	{{{5.7f, 100.0f}, {9.9f, 50.0f}, {18.4f, 70.0f}}, 3, 5.30614f, 10.38603f},
+	{{{42.0f, 100.0f}, {44.0f, 90.0f}, {60.0f, 30.0f}}, 3, 42.15831f, 43.93766f},
+	{{{1.2f, 70.0f}, {2.4f, 100.0f}, {3.9f, 40.0f}}, 3, 1.75660f, 2.21945f},
+	{{{10.0f, 80.0f}, {30.0f, 100.0f}}, 2, 9.67503f, 21.50039f},
+	{{{8.0f, 60.0f}, {20.0f, 100.0f}}, 2, 13.90131f, 16.05180f},
+	{{{15.0f, 50.0f}, {17.0f, 100.0f}, {40.0f, 60.0f}}, 3, 14.93107f, 22.46885f},
+};
+
+/* Generate IQ data for a channel with multiple propagation paths. */
+static void generate_multipath_iq_data(const struct multipath_case *test_case,
+				       cs_de_iq_tones_t *iq_tones)
+{
+	for (int i = 0; i < NUM_CHANNELS; i++) {
+		float i_sum = 0.0f;
+		float q_sum = 0.0f;
+
+		for (uint8_t p = 0; p < test_case->n_paths; p++) {
+			float rotation_per_channel = 2 * PI * CHANNEL_SPACING_HZ *
+						     test_case->paths[p].distance /
+						     SPEED_OF_LIGHT_M_PER_S;
+
+			i_sum += test_case->paths[p].amplitude * cosf(-rotation_per_channel * i);
+			q_sum += test_case->paths[p].amplitude * sinf(-rotation_per_channel * i);
+		}
+
+		iq_tones->i_local[i] = i_sum;
+		iq_tones->q_local[i] = q_sum;
+		iq_tones->i_remote[i] = i_sum;
+		iq_tones->q_remote[i] = q_sum;
+	}
+}
+
+/* Fill all antenna paths of the report, each one with a different multipath test case. */
+static void multipath_report_init(cs_de_report_t *p_report, size_t first_case)
+{
+	p_report->n_ap = CONFIG_BT_CS_DE_MAX_NUM_ANTENNA_PATHS;
+	p_report->rtt_accumulated_half_ns = 0;
+	p_report->rtt_count = 0;
+
+	for (uint8_t ap = 0; ap < p_report->n_ap; ap++) {
+		size_t i = (first_case + ap) % ARRAY_SIZE(multipath_cases);
+
+		p_report->tone_quality[ap] = CS_DE_TONE_QUALITY_OK;
+		generate_multipath_iq_data(&multipath_cases[i], &p_report->iq_tones[ap]);
+	}
+}
+
+static void multipath_report_check(const cs_de_report_t *p_report, size_t first_case)
+{
+	for (uint8_t ap = 0; ap < p_report->n_ap; ap++) {
+		size_t i = (first_case + ap) % ARRAY_SIZE(multipath_cases);
+
+		TEST_ASSERT_FLOAT_WITHIN(0.01f,
+			multipath_cases[i].ifft,
+			p_report->distance_estimates[ap].ifft);
+		TEST_ASSERT_FLOAT_WITHIN(0.01f,
+			multipath_cases[i].phase_slope,
+			p_report->distance_estimates[ap].phase_slope);
+	}
+}
+
+void test_cs_de_calc_with_multipath_iq_data(void)
+{
+	if (CONFIG_BT_CS_DE_NFFT_SIZE != 512) {
+		TEST_IGNORE_MESSAGE("Reference estimates are for the NFFT size of 512");
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(multipath_cases); i++) {
+		cs_de_report_t test_report;
+
+		multipath_report_init(&test_report, i);
+
+		TEST_ASSERT_EQUAL(CS_DE_QUALITY_OK, cs_de_calc(&test_report));
+		multipath_report_check(&test_report, i);
+	}
+}
+
+void test_cs_de_calc_with_workspace(void)
+{
+	static cs_de_workspace_t workspace;
+
+	if (CONFIG_BT_CS_DE_NFFT_SIZE != 512) {
+		TEST_IGNORE_MESSAGE("Reference estimates are for the NFFT size of 512");
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(multipath_cases); i++) {
+		cs_de_report_t test_report;
+
+		multipath_report_init(&test_report, i);
+
+		/* Fill the workspace with garbage to verify that it does not need clearing. */
+		memset(&workspace, 0x5a, sizeof(workspace));
+
+		TEST_ASSERT_EQUAL(CS_DE_QUALITY_OK,
+				  cs_de_calc_with_workspace(&test_report, &workspace));
+		multipath_report_check(&test_report, i);
+	}
+}
+
+void test_cs_de_ifft_output(void)
+{
+	static float iq_tones_comb[2 * CONFIG_BT_CS_DE_NFFT_SIZE];
+	static float iq_tones_ref[2 * NUM_CHANNELS];
+	static float ifft_mag_ref[CONFIG_BT_CS_DE_NFFT_SIZE];
+	const float distance = 12.3f;
+	cs_de_iq_tones_t iq_tones;
+	float ifft_mag_ref_max = 0.0f;
+
+	generate_ideal_iq_data(distance, &iq_tones);
+	memset(iq_tones_comb, 0, sizeof(iq_tones_comb));
+	cs_de_combined_iq_calculate(&iq_tones, iq_tones_comb);
+	memcpy(iq_tones_ref, iq_tones_comb, sizeof(iq_tones_ref));
+
+	/* Reference IFFT magnitude, scaled by 1/CONFIG_BT_CS_DE_NFFT_SIZE. */
+	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
+		double re = 0.0;
+		double im = 0.0;
+
+		for (uint32_t k = 0; k < NUM_CHANNELS; k++) {
+			double angle = 2.0 * (double)PI * k * n / CONFIG_BT_CS_DE_NFFT_SIZE;
+
+			re += iq_tones_ref[2 * k] * cos(angle) - iq_tones_ref[2 * k + 1] * sin(angle);
+			im += iq_tones_ref[2 * k] * sin(angle) + iq_tones_ref[2 * k + 1] * cos(angle);
+		}
+
+		ifft_mag_ref[n] = (float)(sqrt(re * re + im * im) / CONFIG_BT_CS_DE_NFFT_SIZE);
+		ifft_mag_ref_max = MAX(ifft_mag_ref_max, ifft_mag_ref[n]);
+	}
+
+	TEST_ASSERT_FLOAT_WITHIN(0.01f, distance, cs_de_ifft(iq_tones_comb));
+
+	/* The input is overwritten with the IFFT magnitude. */
+	for (uint32_t n = 0; n < CONFIG_BT_CS_DE_NFFT_SIZE; n++) {
+		TEST_ASSERT_FLOAT_WITHIN(ifft_mag_ref_max * 1e-4f, ifft_mag_ref[n],
+					 iq_tones_comb[n]);
+	}
+}
+
 /* Main test entry point */
 int main(void)
 {
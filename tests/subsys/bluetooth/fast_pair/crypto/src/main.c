@@ -453,6 +453,106 @@ ZTEST(suite_crypto, test_bloom_filter)
 			  "Invalid resulting filter.");
 }
 
+ZTEST(suite_crypto, test_bloom_filter_cached)
+{
+	FP_CRYPTO_ACCOUNT_KEY_FILTER_CTX_DEFINE(ctx, 2);
+
+	static const uint16_t salt = 0xC7C8;
+
+	static const struct fp_account_key account_key_list[] = {
+		{ .key = {0x11, 0x11, 0x22, 0x22, 0x33, 0x33, 0x44, 0x44, 0x55, 0x55, 0x66, 0x66,
+			  0x77, 0x77, 0x88, 0x88} },
+		{ .key = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0x00, 0xAA, 0xBB,
+			  0xCC, 0xDD, 0xEE, 0xFF} },
+		{ .key = {0x11, 0x11, 0x22, 0x22, 0x33, 0x33, 0x44, 0x44, 0x55, 0x55, 0x66, 0x66,
+			  0x77, 0x77, 0x88, 0x88} }
+		};
+
+	static const uint8_t battery_info[] = {0b00110011, 0b01000000, 0b01000000, 0b01000000};
+
+	static const uint8_t first_bloom_filter[] = {0x02, 0x0C, 0x80, 0x2A};
+	static const uint8_t first_bloom_filter_with_battery_info[] = {0x01, 0x01, 0x46, 0x0A};
+	static const uint8_t second_bloom_filter[] = {0x84, 0x4A, 0x62, 0x20, 0x8B};
+	static const uint8_t second_bloom_filter_with_battery_info[] = {0x46, 0x15, 0x24, 0xD0,
+									0x08};
+	static const uint8_t third_bloom_filter[] = {0x80, 0x40, 0x20, 0x0E, 0x03, 0x2A};
+
+	/* Lists used by test_bloom_filter: the first one has a single key and the second one
+	 * appends a key to it.
+	 */
+	const struct fp_account_key *first_list = &account_key_list[1];
+	const struct fp_account_key *second_list = &account_key_list[1];
+	uint8_t result_buf[8];
+
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, first_list, 1, salt,
+						       NULL),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, first_bloom_filter, sizeof(first_bloom_filter),
+			  "Invalid resulting filter.");
+
+	/* Repeated computation uses the cached hash. */
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, first_list, 1, salt,
+						       NULL),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, first_bloom_filter, sizeof(first_bloom_filter),
+			  "Invalid resulting filter.");
+	zassert_equal(ctx.entry_cnt, 1, "Invalid number of cached entries.");
+
+	/* Key list change. */
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, second_list, 2, salt,
+						       NULL),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, second_bloom_filter, sizeof(second_bloom_filter),
+			  "Invalid resulting filter.");
+	zassert_equal(ctx.entry_cnt, 2, "Invalid number of cached entries.");
+
+	/* Key order change. */
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, &account_key_list[0], 2,
+						       salt, NULL),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, second_bloom_filter, sizeof(second_bloom_filter),
+			  "Invalid resulting filter.");
+
+	/* Battery info change. */
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, second_list, 2, salt,
+						       battery_info),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, second_bloom_filter_with_battery_info,
+			  sizeof(second_bloom_filter_with_battery_info),
+			  "Invalid resulting filter.");
+
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, first_list, 1, salt,
+						       battery_info),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, first_bloom_filter_with_battery_info,
+			  sizeof(first_bloom_filter_with_battery_info),
+			  "Invalid resulting filter.");
+
+	/* Salt change. */
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, first_list, 1,
+						       salt + 1, battery_info),
+		   "Error during filter computing");
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, first_list, 1, salt,
+						       battery_info),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, first_bloom_filter_with_battery_info,
+			  sizeof(first_bloom_filter_with_battery_info),
+			  "Invalid resulting filter.");
+
+	/* More keys than the context can cache. */
+	zassert_equal(fp_crypto_account_key_filter_size(ARRAY_SIZE(account_key_list)),
+		      sizeof(third_bloom_filter), "Invalid size of expected result.");
+	zassert_ok(fp_crypto_account_key_filter_cached(&ctx, result_buf, account_key_list,
+						       ARRAY_SIZE(account_key_list), salt, NULL),
+		   "Error during filter computing");
+	zassert_mem_equal(result_buf, third_bloom_filter, sizeof(third_bloom_filter),
+			  "Invalid resulting filter.");
+	zassert_equal(ctx.entry_cnt, 1, "Cached entries modified.");
+
+	fp_crypto_account_key_filter_ctx_reset(&ctx);
+	zassert_equal(ctx.entry_cnt, 0, "Cached entries not dropped.");
+}
+
 ZTEST(suite_crypto, test_additional_data_packet)
 {
 	static const uint8_t input_data[] = {0x53, 0x6F, 0x6D, 0x65, 0x6F, 0x6E, 0x65, 0x27, 0x73,
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "fp_crypto.h"
+#include "fp_common.h"
+
+#include "test_time.h"
+
+#define ACCOUNT_KEY_CNT		8
+#define ITERATION_CNT		1000
+/* Account Key Filter size for ACCOUNT_KEY_CNT + 1 keys, rounded up. */
+#define FILTER_SIZE_MAX		16
+
+FP_CRYPTO_ACCOUNT_KEY_FILTER_CTX_DEFINE(filter_ctx, ACCOUNT_KEY_CNT + 1);
+
+static struct fp_account_key account_keys[ACCOUNT_KEY_CNT + 1];
+static uint8_t battery_info[FP_CRYPTO_BATTERY_INFO_LEN] = {0x33, 0x40, 0x40, 0x40};
+static uint8_t filter[FILTER_SIZE_MAX];
+static uint8_t filter_ref[FILTER_SIZE_MAX];
+
+static void filter_ref_compute(size_t n, uint16_t salt)
+{
+	zassert_ok(fp_crypto_account_key_filter(filter_ref, account_keys, n, salt, battery_info),
+		   "Failed to compute reference filter");
+}
+
+static void filter_cached_check(size_t n, uint16_t salt)
+{
+	zassert_ok(fp_crypto_account_key_filter_cached(&filter_ctx, filter, account_keys, n, salt,
+						       battery_info),
+		   "Failed to compute cached filter");
+	zassert_mem_equal(filter, filter_ref, fp_crypto_account_key_filter_size(n),
+			  "Invalid cached filter");
+}
+
+static void before(void *f)
+{
+	ARG_UNUSED(f);
+
+	zassert_true(fp_crypto_account_key_filter_size(ARRAY_SIZE(account_keys)) <= sizeof(filter),
+		     "Filter buffer too small");
+
+	for (size_t i = 0; i < ARRAY_SIZE(account_keys); i++) {
+		memset(account_keys[i].key, i + 1, sizeof(account_keys[i].key));
+	}
+	battery_info[1] = 0x40;
+
+	fp_crypto_account_key_filter_ctx_reset(&filter_ctx);
+}
+
+ZTEST(suite_fp_crypto_benchmark, test_account_key_filter)
+{
+	uint64_t uncached_ns = 0;
+	uint64_t unchanged_ns = 0;
+	uint64_t battery_ns = 0;
+	uint64_t key_added_ns = 0;
+	uint64_t salt_ns = 0;
+	uint64_t start;
+
+	for (size_t i = 0; i < ITERATION_CNT; i++) {
+		uint16_t salt = i;
+
+		/* Account Key Filter rebuild without the cache. */
+		start = test_time_ns_get();
+		filter_ref_compute(ACCOUNT_KEY_CNT, salt);
+		uncached_ns += test_time_ns_get() - start;
+
+		/* New Salt. */
+		start = test_time_ns_get();
+		filter_cached_check(ACCOUNT_KEY_CNT, salt);
+		salt_ns += test_time_ns_get() - start;
+
+		/* Unchanged inputs. */
+		start = test_time_ns_get();
+		filter_cached_check(ACCOUNT_KEY_CNT, salt);
+		unchanged_ns += test_time_ns_get() - start;
+
+		/* Battery level change. */
+		battery_info[1] ^= 0x01;
+		filter_ref_compute(ACCOUNT_KEY_CNT, salt);
+
+		start = test_time_ns_get();
+		filter_cached_check(ACCOUNT_KEY_CNT, salt);
+		battery_ns += test_time_ns_get() - start;
+
+		/* New Account Key written. */
+		filter_ref_compute(ACCOUNT_KEY_CNT + 1, salt);
+
+		start = test_time_ns_get();
+		filter_cached_check(ACCOUNT_KEY_CNT + 1, salt);
+		key_added_ns += test_time_ns_get() - start;
+	}
+
+	TC_PRINT("Account Keys: %d, iterations: %d\n", ACCOUNT_KEY_CNT, ITERATION_CNT);
+	TC_PRINT("Filter without cache: %llu ns\n", uncached_ns / ITERATION_CNT);
+	TC_PRINT("Cached filter, Salt changed: %llu ns\n", salt_ns / ITERATION_CNT);
+	TC_PRINT("Cached filter, battery info changed: %llu ns\n", battery_ns / ITERATION_CNT);
+	TC_PRINT("Cached filter, Account Key added: %llu ns\n", key_added_ns / ITERATION_CNT);
+	TC_PRINT("Cached filter, inputs unchanged: %llu ns\n", unchanged_ns / ITERATION_CNT);
+}
+
+ZTEST_SUITE(suite_fp_crypto_benchmark, NULL, NULL, before, NULL, NULL);
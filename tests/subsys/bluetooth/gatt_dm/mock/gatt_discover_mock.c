@@ -12,20 +12,31 @@
 #include <zephyr/sys/util.h>
 
 
-/* Settings of the discover mock */
-static struct bt_discover_mock {
-	const struct bt_gatt_attr *attr;
-	size_t len;
+/* Maximum number of discovery procedures simulated at the same time */
+#define DISCOVER_MOCK_REQ_MAX 2
+
+/* A single simulated discovery procedure */
+struct bt_discover_mock {
 	struct bt_conn *conn;
 	struct bt_gatt_discover_params *params;
 	struct k_work_delayable work;
+};
+
+/* Settings of the discover mock */
+static struct {
+	const struct bt_gatt_attr *attr;
+	size_t len;
+	struct bt_discover_mock req[DISCOVER_MOCK_REQ_MAX];
 } discover_mock_data;
 
 static void bt_gatt_discover_work(struct k_work *work);
 
 void bt_gatt_discover_mock_setup(const struct bt_gatt_attr *attr, size_t len)
 {
-	k_work_init_delayable(&discover_mock_data.work, bt_gatt_discover_work);
+	for (size_t i = 0; i < ARRAY_SIZE(discover_mock_data.req); i++) {
+		k_work_init_delayable(&discover_mock_data.req[i].work, bt_gatt_discover_work);
+		discover_mock_data.req[i].params = NULL;
+	}
 	discover_mock_data.attr = attr;
 	discover_mock_data.len  = len;
 }
@@ -125,10 +136,26 @@ static void bt_gatt_discover_work(struct k_work *work)
 int bt_gatt_discover(struct bt_conn *conn,
 		     struct bt_gatt_discover_params *params)
 {
+	struct bt_discover_mock *mock_data = NULL;
+
 	printk("Running %s mock\n", __func__);
-	discover_mock_data.conn = conn;
-	discover_mock_data.params = params;
 
-	k_work_schedule(&discover_mock_data.work, K_MSEC(5));
+	/* Every discovery procedure uses its own parameters structure. */
+	for (size_t i = 0; i < ARRAY_SIZE(discover_mock_data.req); i++) {
+		if (discover_mock_data.req[i].params == params) {
+			mock_data = &discover_mock_data.req[i];
+			break;
+		}
+		if (!mock_data && !discover_mock_data.req[i].params) {
+			mock_data = &discover_mock_data.req[i];
+		}
+	}
+
+	zassert_not_null(mock_data, "Too many simultaneous discovery procedures");
+
+	mock_data->conn = conn;
+	mock_data->params = params;
+
+	k_work_schedule(&mock_data->work, K_MSEC(5));
 	return 0;
 }
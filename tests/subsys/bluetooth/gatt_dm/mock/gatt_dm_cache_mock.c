@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/settings/settings.h>
+
+#include "gatt_dm_cache_mock.h"
+
+/* Maximum number of settings entries stored at the same time */
+#define ENTRY_CNT_MAX 4
+#define ENTRY_NAME_LEN_MAX 96
+#define ENTRY_VALUE_LEN_MAX 1024
+
+/* A single settings entry */
+struct settings_entry {
+	char name[ENTRY_NAME_LEN_MAX];
+	uint8_t value[ENTRY_VALUE_LEN_MAX];
+	size_t len;
+};
+
+/* A single settings entry being read */
+struct settings_entry_read {
+	const struct settings_entry *entry;
+	size_t offset;
+};
+
+/* Settings of the cache mocks */
+static struct {
+	bt_addr_le_t peer;
+	bool bonded;
+	bool has_db_hash;
+	uint8_t db_hash[GATT_DM_CACHE_MOCK_DB_HASH_LEN];
+	struct bt_conn *read_conn;
+	struct bt_gatt_read_params *read_params;
+	struct k_work_delayable read_work;
+	struct bt_conn_auth_info_cb *auth_info_cb;
+	struct settings_entry entries[ENTRY_CNT_MAX];
+} cache_mock_data;
+
+static const bt_addr_le_t default_peer = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06},
+};
+
+static void db_hash_read_work(struct k_work *work)
+{
+	struct bt_gatt_read_params *params = cache_mock_data.read_params;
+
+	cache_mock_data.read_params = NULL;
+
+	if (cache_mock_data.has_db_hash) {
+		(void)params->func(cache_mock_data.read_conn, 0, params, cache_mock_data.db_hash,
+				   sizeof(cache_mock_data.db_hash));
+	} else {
+		(void)params->func(cache_mock_data.read_conn, BT_ATT_ERR_ATTRIBUTE_NOT_FOUND,
+				   params, NULL, 0);
+	}
+}
+
+void gatt_dm_cache_mock_reset(void)
+{
+	static const uint8_t db_hash[GATT_DM_CACHE_MOCK_DB_HASH_LEN] = {
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+		0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+	};
+
+	k_work_init_delayable(&cache_mock_data.read_work, db_hash_read_work);
+	cache_mock_data.read_params = NULL;
+	memset(cache_mock_data.entries, 0, sizeof(cache_mock_data.entries));
+	gatt_dm_cache_mock_peer_set(&default_peer, false);
+	gatt_dm_cache_mock_db_hash_set(db_hash);
+}
+
+void gatt_dm_cache_mock_peer_set(const bt_addr_le_t *addr, bool bonded)
+{
+	bt_addr_le_copy(&cache_mock_data.peer, addr);
+	cache_mock_data.bonded = bonded;
+}
+
+void gatt_dm_cache_mock_db_hash_set(const uint8_t *db_hash)
+{
+	cache_mock_data.has_db_hash = (db_hash != NULL);
+	if (db_hash) {
+		memcpy(cache_mock_data.db_hash, db_hash, sizeof(cache_mock_data.db_hash));
+	}
+}
+
+size_t gatt_dm_cache_mock_entry_cnt(void)
+{
+	size_t cnt = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock_data.entries); i++) {
+		if (cache_mock_data.entries[i].name[0] != '\0') {
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
+
+void gatt_dm_cache_mock_bond_delete(void)
+{
+	zassert_not_null(cache_mock_data.auth_info_cb, "Callbacks not registered");
+	zassert_not_null(cache_mock_data.auth_info_cb->bond_deleted, "Callback not set");
+
+	cache_mock_data.bonded = false;
+	cache_mock_data.auth_info_cb->bond_deleted(BT_ID_DEFAULT, &cache_mock_data.peer);
+}
+
+/* Mocked version of the bt_gatt_read, used only to read the GATT Database Hash */
+int bt_gatt_read(struct bt_conn *conn, struct bt_gatt_read_params *params)
+{
+	zassert_equal(0, params->handle_count, "Unexpected read by handle");
+	zassert_true(!bt_uuid_cmp(params->by_uuid.uuid, BT_UUID_GATT_DB_HASH),
+		     "Unexpected read by UUID");
+	zassert_is_null(cache_mock_data.read_params, "Too many simultaneous reads");
+
+	cache_mock_data.read_conn = conn;
+	cache_mock_data.read_params = params;
+	k_work_schedule(&cache_mock_data.read_work, K_MSEC(5));
+
+	return 0;
+}
+
+int __wrap_bt_conn_get_info(const struct bt_conn *conn, struct bt_conn_info *info)
+{
+	memset(info, 0, sizeof(*info));
+	info->type = BT_CONN_TYPE_LE;
+	info->id = BT_ID_DEFAULT;
+	info->le.dst = &cache_mock_data.peer;
+
+	return 0;
+}
+
+bool __wrap_bt_le_bond_exists(uint8_t id, const bt_addr_le_t *addr)
+{
+	return cache_mock_data.bonded && (id == BT_ID_DEFAULT) &&
+	       bt_addr_le_eq(addr, &cache_mock_data.peer);
+}
+
+int __wrap_bt_conn_auth_info_cb_register(struct bt_conn_auth_info_cb *cb)
+{
+	cache_mock_data.auth_info_cb = cb;
+
+	return 0;
+}
+
+static struct settings_entry *entry_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock_data.entries); i++) {
+		struct settings_entry *entry = &cache_mock_data.entries[i];
+
+		if ((entry->name[0] != '\0') && !strcmp(entry->name, name)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+int __wrap_settings_save_one(const char *name, const void *value, size_t val_len)
+{
+	struct settings_entry *entry = entry_find(name);
+
+	zassert_true(strlen(name) < ENTRY_NAME_LEN_MAX, "Too long name: %s", name);
+	zassert_true(val_len <= ENTRY_VALUE_LEN_MAX, "Too long value: %zu", val_len);
+
+	for (size_t i = 0; !entry && (i < ARRAY_SIZE(cache_mock_data.entries)); i++) {
+		if (cache_mock_data.entries[i].name[0] == '\0') {
+			entry = &cache_mock_data.entries[i];
+		}
+	}
+	zassert_not_null(entry, "Too many settings entries");
+
+	strcpy(entry->name, name);
+	memcpy(entry->value, value, val_len);
+	entry->len = val_len;
+
+	return 0;
+}
+
+int __wrap_settings_delete(const char *name)
+{
+	struct settings_entry *entry = entry_find(name);
+
+	if (entry) {
+		memset(entry, 0, sizeof(*entry));
+	}
+
+	return 0;
+}
+
+static ssize_t entry_read(void *cb_arg, void *data, size_t len)
+{
+	struct settings_entry_read *read = cb_arg;
+
+	len = MIN(len, read->entry->len - read->offset);
+	memcpy(data, &read->entry->value[read->offset], len);
+	read->offset += len;
+
+	return len;
+}
+
+int __wrap_settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb,
+					void *param)
+{
+	size_t subtree_len = strlen(subtree);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_mock_data.entries); i++) {
+		const struct settings_entry *entry = &cache_mock_data.entries[i];
+		struct settings_entry_read read = {
+			.entry = entry,
+		};
+		const char *key;
+
+		if ((entry->name[0] == '\0') || strncmp(entry->name, subtree, subtree_len)) {
+			continue;
+		}
+
+		if (entry->name[subtree_len] == '\0') {
+			key = NULL;
+		} else if (entry->name[subtree_len] == '/') {
+			key = &entry->name[subtree_len + 1];
+		} else {
+			continue;
+		}
+
+		if (cb(key, entry->len, entry_read, &read, param)) {
+			break;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_GATT_DM_CACHE_MOCK_H_
+#define BT_GATT_DM_CACHE_MOCK_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <zephyr/bluetooth/addr.h>
+
+/**
+ * @file
+ * @defgroup bt_gatt_dm_cache_mock API
+ * @{
+ * @brief The API used to setup the mocks used by the discovery cache
+ *
+ * The mocks replace the connection information, the bond check, the GATT
+ * Database Hash read and the settings storage.
+ */
+
+/** @brief Length of the GATT Database Hash. */
+#define GATT_DM_CACHE_MOCK_DB_HASH_LEN 16
+
+/**
+ * @brief Reset the mocks
+ *
+ * Removes all stored settings entries and selects a peer that is not
+ * bonded, with a readable GATT Database Hash.
+ */
+void gatt_dm_cache_mock_reset(void);
+
+/**
+ * @brief Select the peer of the connection
+ *
+ * @param addr   Peer address.
+ * @param bonded True if the peer is bonded.
+ */
+void gatt_dm_cache_mock_peer_set(const bt_addr_le_t *addr, bool bonded);
+
+/**
+ * @brief Set the GATT Database Hash of the peer
+ *
+ * @param db_hash The hash or NULL if the peer does not expose it.
+ */
+void gatt_dm_cache_mock_db_hash_set(const uint8_t *db_hash);
+
+/**
+ * @brief Get the number of stored settings entries
+ *
+ * @return Number of entries.
+ */
+size_t gatt_dm_cache_mock_entry_cnt(void);
+
+/**
+ * @brief Delete the bond of the selected peer
+ *
+ * Calls the bond deleted callback of the registered authentication
+ * information callbacks.
+ */
+void gatt_dm_cache_mock_bond_delete(void);
+
+/** @} */
+#endif /* BT_GATT_DM_CACHE_MOCK_H_ */
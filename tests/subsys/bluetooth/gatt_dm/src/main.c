@@ -10,6 +10,9 @@
 #include <zephyr/bluetooth/uuid.h>
 #include <bluetooth/gatt_dm.h>
 #include "../mock/gatt_discover_mock.h"
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+#include "../mock/gatt_dm_cache_mock.h"
+#endif
 
 /* Timeout for the discovery in ms */
 #define SERVICE_DISCOVERY_TIMEOUT 2000
@@ -19,6 +22,7 @@
 
 static char dummy_conn;
 K_SEM_DEFINE(discovery_finished, 0, 1);
+K_SEM_DEFINE(concurrent_finished, 0, 2);
 
 
 const struct bt_gatt_attr discover_sim[] = {
@@ -92,6 +96,7 @@ void test_before(void *fixture)
 	ARG_UNUSED(fixture);
 
 	k_sem_reset(&discovery_finished);
+	k_sem_reset(&concurrent_finished);
 	bt_gatt_discover_mock_setup(discover_sim, ARRAY_SIZE(discover_sim));
 }
 
@@ -476,3 +481,307 @@ ZTEST(gatt_tests, test_gatt_many_serv_by_uuid)
 	zassert_equal(0, bt_gatt_dm_attr_cnt(dm), "Parameter count after clearing: %d",
 		      bt_gatt_dm_attr_cnt(dm));
 }
+
+static void test_cb_concurrent_completed(struct bt_gatt_dm *dm, void *context)
+{
+	printk("%s\n", __func__);
+	*(struct bt_gatt_dm **)context = dm;
+	k_sem_give(&concurrent_finished);
+}
+
+static struct bt_gatt_dm_cb test_concurrent_cb = {
+	.completed         = test_cb_concurrent_completed,
+	.service_not_found = test_cb_service_not_found,
+	.error_found       = test_cb_error_found
+};
+
+ZTEST(gatt_tests, test_gatt_concurrent_conn)
+{
+	static char dummy_conn_2;
+	struct bt_gatt_dm *dm_hrs = NULL;
+	struct bt_gatt_dm *dm_dis = NULL;
+	struct bt_gatt_dm *dm_busy;
+	const struct bt_gatt_service_val *serv_val;
+	int err;
+
+	if (CONFIG_BT_GATT_DM_MAX_INSTANCES < 2) {
+		ztest_test_skip();
+	}
+
+	err = bt_gatt_dm_start((struct bt_conn *)&dummy_conn, BT_UUID_HRS,
+			       &test_concurrent_cb, &dm_hrs);
+	zassert_false(err, "bt_gatt_dm_start finished with error: %d", err);
+
+	/* Only one procedure per connection. */
+	err = bt_gatt_dm_start((struct bt_conn *)&dummy_conn, BT_UUID_DIS,
+			       &test_concurrent_cb, &dm_busy);
+	zassert_equal(-EALREADY, err, "Unexpected error: %d", err);
+
+	err = bt_gatt_dm_start((struct bt_conn *)&dummy_conn_2, BT_UUID_DIS,
+			       &test_concurrent_cb, &dm_dis);
+	zassert_false(err, "bt_gatt_dm_start finished with error: %d", err);
+
+	for (size_t i = 0; i < 2; i++) {
+		err = k_sem_take(&concurrent_finished, K_MSEC(SERVICE_DISCOVERY_TIMEOUT));
+		zassert_equal(0, err, "It seems that no callback function was called: %d", err);
+	}
+
+	zassert_not_null(dm_hrs, "Device Manager pointer not set");
+	zassert_not_null(dm_dis, "Device Manager pointer not set");
+	zassert_not_equal(dm_hrs, dm_dis, "Discovery instances are shared");
+
+	zassert_equal_ptr(&dummy_conn, bt_gatt_dm_conn_get(dm_hrs), "Unexpected connection");
+	serv_val = bt_gatt_dm_attr_service_val(bt_gatt_dm_service_get(dm_hrs));
+	zassert_true(!bt_uuid_cmp(BT_UUID_HRS, serv_val->uuid), "Invalid service detected");
+	zassert_equal(2, bt_gatt_dm_attr_cnt(dm_hrs),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm_hrs));
+
+	zassert_equal_ptr(&dummy_conn_2, bt_gatt_dm_conn_get(dm_dis), "Unexpected connection");
+	serv_val = bt_gatt_dm_attr_service_val(bt_gatt_dm_service_get(dm_dis));
+	zassert_true(!bt_uuid_cmp(BT_UUID_DIS, serv_val->uuid), "Invalid service detected");
+	zassert_equal(5, bt_gatt_dm_attr_cnt(dm_dis),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm_dis));
+
+	/* ------------------------------------------------------ */
+	/* Clean up */
+	bt_gatt_dm_data_release(dm_hrs);
+	bt_gatt_dm_data_release(dm_dis);
+}
+
+#if defined(CONFIG_BT_GATT_DM_CACHE)
+/* The HIDS attributes in discover_sim */
+#define HIDS_ATTR_CNT 11
+
+/* The HIDS after the peer GATT database changed */
+static const struct bt_gatt_attr discover_sim_changed[] = {
+	BT_GATT_DISCOVER_MOCK_SERV(1, BT_UUID_HIDS, 3),
+	BT_GATT_DISCOVER_MOCK_CHRC(2, BT_UUID_HIDS_INFO, BT_GATT_CHRC_READ),
+	BT_GATT_DISCOVER_MOCK_DESC(3, BT_UUID_HIDS_INFO),
+};
+
+static const uint8_t db_hash_changed[GATT_DM_CACHE_MOCK_DB_HASH_LEN] = {
+	0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+	0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf,
+};
+
+static const bt_addr_le_t peer_1 = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x11, 0x12, 0x13, 0x14, 0x15, 0xd6},
+};
+
+static const bt_addr_le_t peer_2 = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x21, 0x22, 0x23, 0x24, 0x25, 0xd6},
+};
+
+static struct bt_gatt_dm_cache_stats cache_stats_start;
+
+static void cache_test_before(void *fixture)
+{
+	test_before(fixture);
+	gatt_dm_cache_mock_reset();
+	gatt_dm_cache_mock_peer_set(&peer_1, true);
+	bt_gatt_dm_cache_stats_get(&cache_stats_start);
+}
+
+static void cache_test_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Other test suites run without the cache. */
+	gatt_dm_cache_mock_reset();
+}
+
+static void cache_stats_check(uint32_t hits, uint32_t misses)
+{
+	struct bt_gatt_dm_cache_stats stats;
+
+	bt_gatt_dm_cache_stats_get(&stats);
+	zassert_equal(hits, stats.hits - cache_stats_start.hits,
+		      "Unexpected number of cache hits: %u", stats.hits - cache_stats_start.hits);
+	zassert_equal(misses, stats.misses - cache_stats_start.misses,
+		      "Unexpected number of cache misses: %u",
+		      stats.misses - cache_stats_start.misses);
+}
+
+/* Checks that the discovered attributes match the simulated ones. */
+static void attrs_check(struct bt_gatt_dm *dm, const struct bt_gatt_attr *sim, size_t cnt)
+{
+	const struct bt_gatt_dm_attr *attr;
+
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(cnt, bt_gatt_dm_attr_cnt(dm),
+		      "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+
+	attr = bt_gatt_dm_service_get(dm);
+	for (size_t i = 0; i < cnt; i++) {
+		zassert_not_null(attr, "Attr index: %zu", i);
+		zassert_equal(sim[i].handle, attr->handle, "Unexpected handle: %u", attr->handle);
+		zassert_true(!bt_uuid_cmp(sim[i].uuid, attr->uuid), "Unexpected UUID");
+
+		if (!bt_uuid_cmp(BT_UUID_GATT_PRIMARY, attr->uuid)) {
+			const struct bt_gatt_service_val *exp_val = sim[i].user_data;
+			const struct bt_gatt_service_val *serv_val =
+				bt_gatt_dm_attr_service_val(attr);
+
+			zassert_not_null(serv_val, "Unexpected NULL service value");
+			zassert_true(!bt_uuid_cmp(exp_val->uuid, serv_val->uuid),
+				     "Unexpected service UUID");
+			zassert_equal(exp_val->end_handle, serv_val->end_handle,
+				      "Unexpected end handle");
+		} else if (!bt_uuid_cmp(BT_UUID_GATT_CHRC, attr->uuid)) {
+			const struct bt_gatt_chrc *exp_val = sim[i].user_data;
+			const struct bt_gatt_chrc *chrc_val = bt_gatt_dm_attr_chrc_val(attr);
+
+			zassert_not_null(chrc_val, "Unexpected NULL characteristic value");
+			zassert_true(!bt_uuid_cmp(exp_val->uuid, chrc_val->uuid),
+				     "Unexpected characteristic UUID");
+			zassert_equal(exp_val->properties, chrc_val->properties,
+				      "Unexpected characteristic properties");
+			zassert_equal(exp_val->value_handle, chrc_val->value_handle,
+				      "Unexpected value handle");
+		}
+
+		attr = bt_gatt_dm_attr_next(dm, attr);
+	}
+	zassert_is_null(attr, "Unexpected attribute detected");
+}
+
+ZTEST_SUITE(gatt_cache_tests, NULL, NULL, cache_test_before, cache_test_after, NULL);
+
+ZTEST(gatt_cache_tests, test_cache_miss)
+{
+	struct bt_gatt_dm *dm = run_dm(BT_UUID_HIDS);
+
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	cache_stats_check(0, 1);
+	zassert_equal(1, gatt_dm_cache_mock_entry_cnt(), "Discovery result not stored");
+
+	bt_gatt_dm_data_release(dm);
+}
+
+ZTEST(gatt_cache_tests, test_cache_hit)
+{
+	struct bt_gatt_dm *dm = run_dm(BT_UUID_HIDS);
+
+	bt_gatt_dm_data_release(dm);
+
+	/* Unchanged GATT Database Hash, the cached result is restored
+	 * even though the discovery would find a different service.
+	 */
+	bt_gatt_discover_mock_setup(discover_sim_changed, ARRAY_SIZE(discover_sim_changed));
+	dm = run_dm(BT_UUID_HIDS);
+
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	cache_stats_check(1, 1);
+	zassert_equal(1, gatt_dm_cache_mock_entry_cnt(), "Unexpected number of cache entries");
+
+	bt_gatt_dm_data_release(dm);
+
+	/* Other service is not found in the cache. */
+	bt_gatt_discover_mock_setup(discover_sim, ARRAY_SIZE(discover_sim));
+	dm = run_dm(BT_UUID_DIS);
+
+	zassert_not_null(dm, "Device Manager pointer not set");
+	zassert_equal(5, bt_gatt_dm_attr_cnt(dm), "Unexpected number of attributes detected: %d",
+		      bt_gatt_dm_attr_cnt(dm));
+	cache_stats_check(1, 2);
+	zassert_equal(2, gatt_dm_cache_mock_entry_cnt(), "Unexpected number of cache entries");
+
+	bt_gatt_dm_data_release(dm);
+}
+
+ZTEST(gatt_cache_tests, test_cache_db_hash_changed)
+{
+	struct bt_gatt_dm *dm = run_dm(BT_UUID_HIDS);
+
+	bt_gatt_dm_data_release(dm);
+
+	bt_gatt_discover_mock_setup(discover_sim_changed, ARRAY_SIZE(discover_sim_changed));
+	gatt_dm_cache_mock_db_hash_set(db_hash_changed);
+	dm = run_dm(BT_UUID_HIDS);
+
+	attrs_check(dm, discover_sim_changed, ARRAY_SIZE(discover_sim_changed));
+	cache_stats_check(0, 2);
+	bt_gatt_dm_data_release(dm);
+
+	/* The cache entry is replaced with the new result. */
+	dm = run_dm(BT_UUID_HIDS);
+
+	attrs_check(dm, discover_sim_changed, ARRAY_SIZE(discover_sim_changed));
+	cache_stats_check(1, 2);
+	zassert_equal(1, gatt_dm_cache_mock_entry_cnt(), "Unexpected number of cache entries");
+
+	bt_gatt_dm_data_release(dm);
+}
+
+ZTEST(gatt_cache_tests, test_cache_no_db_hash)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_db_hash_set(NULL);
+
+	dm = run_dm(BT_UUID_HIDS);
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	bt_gatt_dm_data_release(dm);
+
+	dm = run_dm(BT_UUID_HIDS);
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	bt_gatt_dm_data_release(dm);
+
+	cache_stats_check(0, 2);
+	zassert_equal(0, gatt_dm_cache_mock_entry_cnt(), "Result stored without the hash");
+}
+
+ZTEST(gatt_cache_tests, test_cache_not_bonded)
+{
+	struct bt_gatt_dm *dm;
+
+	gatt_dm_cache_mock_peer_set(&peer_1, false);
+
+	dm = run_dm(BT_UUID_HIDS);
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	bt_gatt_dm_data_release(dm);
+
+	cache_stats_check(0, 0);
+	zassert_equal(0, gatt_dm_cache_mock_entry_cnt(), "Result of not bonded peer stored");
+}
+
+ZTEST(gatt_cache_tests, test_cache_bond_deleted)
+{
+	struct bt_gatt_dm *dm;
+
+	dm = run_dm(BT_UUID_HIDS);
+	bt_gatt_dm_data_release(dm);
+	dm = run_dm(BT_UUID_DIS);
+	bt_gatt_dm_data_release(dm);
+
+	gatt_dm_cache_mock_peer_set(&peer_2, true);
+	dm = run_dm(BT_UUID_HIDS);
+	bt_gatt_dm_data_release(dm);
+
+	cache_stats_check(0, 3);
+	zassert_equal(3, gatt_dm_cache_mock_entry_cnt(), "Unexpected number of cache entries");
+
+	/* Only the entries of the peer are removed. */
+	gatt_dm_cache_mock_peer_set(&peer_1, true);
+	gatt_dm_cache_mock_bond_delete();
+	zassert_equal(1, gatt_dm_cache_mock_entry_cnt(), "Cache entries not removed");
+
+	/* Peer bonded again, the discovery is not served from the old entries. */
+	gatt_dm_cache_mock_peer_set(&peer_1, true);
+	dm = run_dm(BT_UUID_HIDS);
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	bt_gatt_dm_data_release(dm);
+	cache_stats_check(0, 4);
+
+	gatt_dm_cache_mock_peer_set(&peer_2, true);
+	dm = run_dm(BT_UUID_HIDS);
+	attrs_check(dm, discover_sim, HIDS_ATTR_CNT);
+	bt_gatt_dm_data_release(dm);
+	cache_stats_check(1, 4);
+}
+#endif /* CONFIG_BT_GATT_DM_CACHE */
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <bluetooth/scan.h>
+
+/* 16-bit UUID values used by the tests */
+#define UUID16_VAL_MATCH 0x180D
+#define UUID16_VAL_OTHER 0x180F
+
+/* 32-bit UUID value used by the tests */
+#define UUID32_VAL_MATCH 0x12345678
+
+/* UUID derived from the Bluetooth Base UUID */
+#define UUID128_BASE_ENCODE(val) BT_UUID_128_ENCODE(val, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB)
+
+/* Vendor UUIDs, not derived from the Bluetooth Base UUID */
+#define UUID128_VENDOR_ENCODE BT_UUID_128_ENCODE(0x0000180D, 0x1212, 0xEFDE, 0x1523, 0x785FEABCD123)
+#define UUID128_VENDOR_OTHER_ENCODE \
+	BT_UUID_128_ENCODE(0x00001524, 0x1212, 0xEFDE, 0x1523, 0x785FEABCD123)
+
+/* Length of an AD structure with the given data length, including the type */
+#define AD_LEN(data_len) ((data_len) + 1)
+
+/* Result of a single advertising report */
+static struct {
+	uint32_t match_cnt;
+	uint32_t no_match_cnt;
+	struct bt_scan_filter_match status;
+} report_result;
+
+static struct bt_le_scan_cb *scan_cb;
+
+static const bt_addr_le_t default_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = {0x11, 0x22, 0x33, 0x44, 0x55, 0xC6},
+};
+
+/* Addresses chosen so that some of them share the bloom filter bits of the others. */
+static const bt_addr_le_t addrs[] = {
+	{ .type = BT_ADDR_LE_RANDOM, .a.val = {0x01, 0x02, 0x03, 0x04, 0x05, 0xC6} },
+	{ .type = BT_ADDR_LE_RANDOM, .a.val = {0x21, 0x22, 0x03, 0x04, 0x05, 0xC6} },
+	{ .type = BT_ADDR_LE_RANDOM, .a.val = {0x02, 0x01, 0x13, 0x14, 0x15, 0xC6} },
+	{ .type = BT_ADDR_LE_PUBLIC, .a.val = {0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00} },
+	{ .type = BT_ADDR_LE_PUBLIC, .a.val = {0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF} },
+	{ .type = BT_ADDR_LE_RANDOM, .a.val = {0xE7, 0x5A, 0x99, 0x88, 0x77, 0x46} },
+	{ .type = BT_ADDR_LE_RANDOM, .a.val = {0x3C, 0xA3, 0x10, 0x20, 0x30, 0xF0} },
+	{ .type = BT_ADDR_LE_PUBLIC, .a.val = {0x10, 0x08, 0x45, 0x56, 0x67, 0x78} },
+};
+
+BUILD_ASSERT(ARRAY_SIZE(addrs) == CONFIG_BT_SCAN_ADDRESS_CNT);
+
+/* Capture the scan callbacks of the scan library. */
+int __wrap_bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+
+	return 0;
+}
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	report_result.match_cnt++;
+	report_result.status = *filter_match;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	report_result.no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb_data, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static bool report(const bt_addr_le_t *addr, const uint8_t *ad, size_t ad_len)
+{
+	struct bt_le_scan_recv_info info = {
+		.addr = addr,
+		.sid = 0,
+		.rssi = -50,
+		.tx_power = 0,
+		.adv_type = BT_GAP_ADV_TYPE_ADV_NONCONN_IND,
+		.adv_props = 0,
+		.interval = 0,
+		.primary_phy = BT_GAP_LE_PHY_1M,
+		.secondary_phy = 0,
+	};
+	struct net_buf_simple buf;
+
+	net_buf_simple_init_with_data(&buf, (void *)ad, ad_len);
+	memset(&report_result, 0, sizeof(report_result));
+
+	scan_cb->recv(&info, &buf);
+
+	zassert_equal(report_result.match_cnt + report_result.no_match_cnt, 1,
+		      "Report not notified exactly once");
+
+	return report_result.match_cnt > 0;
+}
+
+static bool report_ad(const uint8_t *ad, size_t ad_len)
+{
+	return report(&default_addr, ad, ad_len);
+}
+
+static void uuid_filter_set(const struct bt_uuid *uuid)
+{
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, uuid), "Adding filter failed");
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false), "Enabling filter failed");
+}
+
+static void uuid_match_check(const struct bt_uuid *uuid)
+{
+	zassert_equal(report_result.status.uuid.count, 1, "Unexpected UUID match count");
+	zassert_equal(bt_uuid_cmp(report_result.status.uuid.uuid[0], uuid), 0,
+		      "Unexpected UUID matched");
+}
+
+ZTEST(scan_filters, test_uuid16_filter)
+{
+	const struct bt_uuid *uuid = BT_UUID_DECLARE_16(UUID16_VAL_MATCH);
+	const uint8_t ad16[] = {
+		AD_LEN(4), BT_DATA_UUID16_SOME,
+		BT_BYTES_LIST_LE16(UUID16_VAL_OTHER), BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad16_other[] = {
+		AD_LEN(2), BT_DATA_UUID16_ALL, BT_BYTES_LIST_LE16(UUID16_VAL_OTHER)
+	};
+	const uint8_t ad32[] = {
+		AD_LEN(4), BT_DATA_UUID32_ALL, BT_BYTES_LIST_LE32(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad128[] = {
+		AD_LEN(16), BT_DATA_UUID128_ALL, UUID128_BASE_ENCODE(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad128_vendor[] = {
+		AD_LEN(16), BT_DATA_UUID128_ALL, UUID128_VENDOR_ENCODE
+	};
+
+	uuid_filter_set(uuid);
+
+	zassert_true(report_ad(ad16, sizeof(ad16)), "16-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_false(report_ad(ad16_other, sizeof(ad16_other)), "Other UUID matched");
+
+	/* Advertised UUIDs are compared in their 128-bit form. */
+	zassert_true(report_ad(ad32, sizeof(ad32)), "32-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_true(report_ad(ad128, sizeof(ad128)), "128-bit UUID not matched");
+	uuid_match_check(uuid);
+
+	/* Same value, but not derived from the Base UUID. */
+	zassert_false(report_ad(ad128_vendor, sizeof(ad128_vendor)), "Vendor UUID matched");
+}
+
+ZTEST(scan_filters, test_uuid32_filter)
+{
+	const struct bt_uuid *uuid = BT_UUID_DECLARE_32(UUID32_VAL_MATCH);
+	const uint8_t ad32[] = {
+		AD_LEN(8), BT_DATA_UUID32_SOME,
+		BT_BYTES_LIST_LE32(UUID16_VAL_OTHER), BT_BYTES_LIST_LE32(UUID32_VAL_MATCH)
+	};
+	const uint8_t ad16[] = {
+		AD_LEN(2), BT_DATA_UUID16_ALL, BT_BYTES_LIST_LE16(UUID32_VAL_MATCH & 0xFFFF)
+	};
+	const uint8_t ad128[] = {
+		AD_LEN(16), BT_DATA_UUID128_SOME, UUID128_BASE_ENCODE(UUID32_VAL_MATCH)
+	};
+
+	uuid_filter_set(uuid);
+
+	zassert_true(report_ad(ad32, sizeof(ad32)), "32-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_true(report_ad(ad128, sizeof(ad128)), "128-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_false(report_ad(ad16, sizeof(ad16)), "Truncated value matched");
+}
+
+ZTEST(scan_filters, test_uuid32_filter_16bit_value)
+{
+	const struct bt_uuid *uuid = BT_UUID_DECLARE_32(UUID16_VAL_MATCH);
+	const uint8_t ad16[] = {
+		AD_LEN(2), BT_DATA_UUID16_ALL, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+
+	uuid_filter_set(uuid);
+
+	zassert_true(report_ad(ad16, sizeof(ad16)), "16-bit UUID not matched");
+	uuid_match_check(uuid);
+}
+
+ZTEST(scan_filters, test_uuid128_filter)
+{
+	const struct bt_uuid *uuid = BT_UUID_DECLARE_128(UUID128_VENDOR_ENCODE);
+	const uint8_t ad128[] = {
+		AD_LEN(32), BT_DATA_UUID128_SOME,
+		UUID128_VENDOR_OTHER_ENCODE, UUID128_VENDOR_ENCODE
+	};
+	const uint8_t ad128_other[] = {
+		AD_LEN(16), BT_DATA_UUID128_ALL, UUID128_VENDOR_OTHER_ENCODE
+	};
+	const uint8_t ad16[] = {
+		AD_LEN(2), BT_DATA_UUID16_ALL, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad32[] = {
+		AD_LEN(4), BT_DATA_UUID32_ALL, BT_BYTES_LIST_LE32(UUID16_VAL_MATCH)
+	};
+
+	uuid_filter_set(uuid);
+
+	zassert_true(report_ad(ad128, sizeof(ad128)), "128-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_false(report_ad(ad128_other, sizeof(ad128_other)), "Other UUID matched");
+
+	/* The value of the vendor UUID is only matched with the Base UUID. */
+	zassert_false(report_ad(ad16, sizeof(ad16)), "16-bit UUID matched");
+	zassert_false(report_ad(ad32, sizeof(ad32)), "32-bit UUID matched");
+}
+
+ZTEST(scan_filters, test_uuid128_filter_base)
+{
+	const struct bt_uuid *uuid = BT_UUID_DECLARE_128(UUID128_BASE_ENCODE(UUID16_VAL_MATCH));
+	const uint8_t ad16[] = {
+		AD_LEN(2), BT_DATA_UUID16_ALL, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad32[] = {
+		AD_LEN(4), BT_DATA_UUID32_ALL, BT_BYTES_LIST_LE32(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad128[] = {
+		AD_LEN(16), BT_DATA_UUID128_ALL, UUID128_BASE_ENCODE(UUID16_VAL_MATCH)
+	};
+
+	uuid_filter_set(uuid);
+
+	zassert_true(report_ad(ad16, sizeof(ad16)), "16-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_true(report_ad(ad32, sizeof(ad32)), "32-bit UUID not matched");
+	uuid_match_check(uuid);
+	zassert_true(report_ad(ad128, sizeof(ad128)), "128-bit UUID not matched");
+	uuid_match_check(uuid);
+}
+
+ZTEST(scan_filters, test_uuid_truncated)
+{
+	/* UUID lists that are not a multiple of the UUID size */
+	const uint8_t ad16[] = {
+		AD_LEN(3), BT_DATA_UUID16_SOME, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH), 0x0F
+	};
+	const uint8_t ad32[] = {
+		AD_LEN(6), BT_DATA_UUID32_SOME,
+		BT_BYTES_LIST_LE32(UUID16_VAL_MATCH), BT_BYTES_LIST_LE16(UUID16_VAL_OTHER)
+	};
+	const uint8_t ad128[] = {
+		AD_LEN(15), BT_DATA_UUID128_SOME, UUID128_BASE_ENCODE(UUID16_VAL_MATCH)
+	};
+	/* AD structure longer than the advertising data */
+	const uint8_t ad16_cut[] = {
+		AD_LEN(4), BT_DATA_UUID16_SOME, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+
+	uuid_filter_set(BT_UUID_DECLARE_16(UUID16_VAL_MATCH));
+
+	zassert_false(report_ad(ad16, sizeof(ad16)), "Malformed 16-bit UUID list matched");
+	zassert_false(report_ad(ad32, sizeof(ad32)), "Malformed 32-bit UUID list matched");
+	/* The last octet of the 128-bit UUID is not part of the AD structure. */
+	zassert_false(report_ad(ad128, sizeof(ad128) - 1), "Malformed 128-bit UUID matched");
+	zassert_false(report_ad(ad16_cut, sizeof(ad16_cut)), "Truncated AD structure matched");
+}
+
+ZTEST(scan_filters, test_uuid_all_mode)
+{
+	const uint8_t ad_both[] = {
+		AD_LEN(4), BT_DATA_UUID16_SOME,
+		BT_BYTES_LIST_LE16(UUID16_VAL_OTHER), BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+	const uint8_t ad_one[] = {
+		AD_LEN(2), BT_DATA_UUID16_SOME, BT_BYTES_LIST_LE16(UUID16_VAL_MATCH)
+	};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID,
+				      BT_UUID_DECLARE_16(UUID16_VAL_MATCH)));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID,
+				      BT_UUID_DECLARE_32(UUID16_VAL_OTHER)));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, true));
+
+	zassert_true(report_ad(ad_both, sizeof(ad_both)), "UUIDs not matched");
+	zassert_equal(report_result.status.uuid.count, 2, "Unexpected UUID match count");
+	zassert_false(report_ad(ad_one, sizeof(ad_one)), "Single UUID matched");
+}
+
+static void addr_filter_enable(void)
+{
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false), "Enabling filter failed");
+}
+
+static bool report_addr(const bt_addr_le_t *addr)
+{
+	bool match = report(addr, NULL, 0);
+
+	if (match) {
+		zassert_true(report_result.status.addr.match, "Address match not reported");
+		zassert_equal(bt_addr_le_cmp(report_result.status.addr.addr, addr), 0,
+			      "Unexpected address matched");
+	}
+
+	return match;
+}
+
+ZTEST(scan_filters, test_addr_filter)
+{
+	/* Shares the bloom filter bits of the first address, but is not in the list. */
+	const bt_addr_le_t addr_same_bits = {
+		.type = BT_ADDR_LE_RANDOM,
+		.a.val = {0x01, 0x02, 0x00, 0x00, 0x00, 0xC0},
+	};
+	bt_addr_le_t addr_other_type;
+
+	addr_filter_enable();
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[i]),
+			   "Adding filter failed");
+	}
+
+	zassert_equal(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &default_addr), -ENOMEM,
+		      "Filter added over the limit");
+
+	/* No address in the list is rejected by the bloom filter. */
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_true(report_addr(&addrs[i]), "Address %zu not matched", i);
+	}
+
+	bt_addr_le_copy(&addr_other_type, &addrs[0]);
+	addr_other_type.type = BT_ADDR_LE_PUBLIC;
+
+	zassert_false(report_addr(&addr_same_bits), "Address not in the list matched");
+	zassert_false(report_addr(&addr_other_type), "Address of other type matched");
+	zassert_false(report_addr(&default_addr), "Address not in the list matched");
+}
+
+ZTEST(scan_filters, test_addr_filter_remove_all)
+{
+	struct bt_filter_status status;
+
+	addr_filter_enable();
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[i]),
+			   "Adding filter failed");
+	}
+
+	bt_scan_filter_remove_all();
+
+	zassert_ok(bt_scan_filter_status_get(&status));
+	zassert_equal(status.addr.cnt, 0, "Address filters not removed");
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_false(report_addr(&addrs[i]), "Removed address %zu matched", i);
+	}
+
+	/* The bloom filter is built again from the new addresses. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addrs[4]),
+		   "Adding filter failed");
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &default_addr),
+		   "Adding filter failed");
+
+	zassert_true(report_addr(&addrs[4]), "Address not matched");
+	zassert_true(report_addr(&default_addr), "Address not matched");
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		if (i != 4) {
+			zassert_false(report_addr(&addrs[i]), "Removed address %zu matched", i);
+		}
+	}
+
+	/* All address filters can be used again. */
+	for (size_t i = 0; i < ARRAY_SIZE(addrs) - 2; i++) {
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR,
+					      &addrs[(i < 4) ? i : (i + 1)]),
+			   "Adding filter failed");
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_equal(report_addr(&addrs[i]), (i != ARRAY_SIZE(addrs) - 1),
+			      "Unexpected result for address %zu", i);
+	}
+}
+
+static void *scan_filters_setup(void)
+{
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb_data);
+
+	zassert_not_null(scan_cb, "Scan callbacks not registered");
+
+	return NULL;
+}
+
+static void scan_filters_before(void *fixture)
+{
+	bt_scan_filter_remove_all();
+	bt_scan_filter_disable();
+}
+
+ZTEST_SUITE(scan_filters, NULL, scan_filters_setup, scan_filters_before, NULL, NULL);
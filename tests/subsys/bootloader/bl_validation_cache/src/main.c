@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/util.h>
+#include <psa/crypto.h>
+#include <pm_config.h>
+#include <bl_validation.h>
+#include <bl_crypto.h>
+#include <bl_storage.h>
+#include <hw_unique_key.h>
+#include <nrfx_nvmc.h>
+#include <../subsys/bootloader/bl_validation/bl_validation_cache.h>
+
+#include "test_time.h"
+
+/* The bootloader accesses the firmware through 32-bit addresses. */
+BUILD_ASSERT(sizeof(void *) == sizeof(uint32_t));
+
+#define SLOT_SIZE		PM_S0_SIZE
+#define FW_SIZE			KB(128)
+#define FW_VERSION		5
+#define COUNTER_VERSION		3
+#define RESET_VECTOR_OFFSET	0x100
+#define KEY_CNT			2
+/* Index of the provisioned public key hash that matches the signing key. */
+#define SIGNING_KEY_IDX		1
+#define BOOT_CNT		10
+
+/* Same layout as struct fw_validation_info in bl_validation.c. */
+struct __packed validation_info {
+	uint32_t magic[MAGIC_LEN_WORDS];
+	uint32_t address;
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+	uint8_t public_key[CONFIG_SB_PUBLIC_KEY_LEN];
+	uint8_t signature[CONFIG_SB_SIGNATURE_LEN];
+};
+
+/* Key returned by the Hardware Unique Key derivation. */
+static const uint8_t derived_key[BL_VALIDATION_CACHE_KEY_LEN] = {
+	0x6b, 0x2e, 0x39, 0x8f, 0x10, 0xd4, 0x57, 0xa2, 0x3c, 0x91, 0x04, 0xee, 0x5a, 0x7d, 0xc3, 0x28,
+	0x81, 0x4f, 0xb6, 0x0d, 0x62, 0x19, 0xfa, 0x37, 0xc0, 0x5e, 0x93, 0x2b, 0x74, 0xe8, 0x0a, 0xd1,
+};
+
+/* Private key used to sign the test image with ECDSA secp256r1. */
+static const uint8_t signing_key[] = {
+	0x2a, 0x9e, 0x41, 0x73, 0x0c, 0xb5, 0x68, 0xd3, 0x17, 0x5f, 0xa0, 0x3e, 0x92, 0xc4, 0x06, 0x7b,
+	0xe1, 0x24, 0x8d, 0x59, 0x3a, 0xf7, 0x10, 0xcb, 0x46, 0x85, 0x2f, 0xd0, 0x6e, 0x13, 0xb9, 0x54,
+};
+
+/* Firmware slot, emulating the flash. */
+static uint8_t slot[SLOT_SIZE] __aligned(4);
+static const struct validation_info *vinfo;
+
+static psa_key_id_t signing_key_id;
+static uint8_t signing_public_key[CONFIG_SB_PUBLIC_KEY_LEN];
+
+static uint8_t key_hashes[KEY_CNT][SB_PUBLIC_KEY_HASH_LEN];
+static bool key_invalidated[KEY_CNT];
+static counter_t monotonic_counter;
+static int huk_err;
+
+static uint32_t verify_cnt;
+static uint32_t record_write_cnt;
+static uint32_t record_write_addr;
+
+int bl_crypto_init(void)
+{
+	return 0;
+}
+
+int bl_root_of_trust_verify_hash(const uint8_t *public_key, const uint8_t *public_key_hash,
+				 const uint8_t *signature, const uint8_t *firmware_hash)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	uint8_t key[1 + CONFIG_SB_PUBLIC_KEY_LEN];
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+	psa_key_id_t key_id;
+	psa_status_t status;
+
+	zassert_ok(bl_sha256_hash(public_key, CONFIG_SB_PUBLIC_KEY_LEN, hash));
+	if (memcmp(hash, public_key_hash, SB_PUBLIC_KEY_HASH_LEN) != 0) {
+		return -EHASHINV;
+	}
+
+	verify_cnt++;
+
+	/* Same as in the bootloader, the signature is over the hash of the firmware hash. */
+	zassert_ok(bl_sha256_hash(firmware_hash, CONFIG_SB_HASH_LEN, hash));
+
+	key[0] = 0x04;
+	memcpy(&key[1], public_key, CONFIG_SB_PUBLIC_KEY_LEN);
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_PUBLIC_KEY(PSA_ECC_FAMILY_SECP_R1));
+	psa_set_key_bits(&attr, 256);
+	psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_VERIFY_HASH);
+	psa_set_key_algorithm(&attr, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+
+	status = psa_import_key(&attr, key, sizeof(key), &key_id);
+	zassert_equal(status, PSA_SUCCESS, "Public key import failed: %d", status);
+
+	status = psa_verify_hash(key_id, PSA_ALG_ECDSA(PSA_ALG_SHA_256), hash, sizeof(hash),
+				 signature, CONFIG_SB_SIGNATURE_LEN);
+	psa_destroy_key(key_id);
+
+	return (status == PSA_SUCCESS) ? 0 : -ESIGINV;
+}
+
+int bl_root_of_trust_verify(const uint8_t *public_key, const uint8_t *public_key_hash,
+			    const uint8_t *signature, const uint8_t *firmware,
+			    const uint32_t firmware_len)
+{
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+
+	zassert_ok(bl_sha256_hash(firmware, firmware_len, hash));
+
+	return bl_root_of_trust_verify_hash(public_key, public_key_hash, signature, hash);
+}
+
+int bl_root_of_trust_verify_external(const uint8_t *public_key, const uint8_t *public_key_hash,
+				     const uint8_t *signature, const uint8_t *firmware,
+				     const uint32_t firmware_len)
+{
+	return bl_root_of_trust_verify(public_key, public_key_hash, signature, firmware,
+				       firmware_len);
+}
+
+void bl_root_of_trust_housekeeping(void)
+{
+}
+
+uint32_t num_public_keys_read(void)
+{
+	return KEY_CNT;
+}
+
+int verify_public_keys(void)
+{
+	return 0;
+}
+
+int public_key_data_read(uint32_t key_idx, uint8_t *p_buf)
+{
+	zassert_true(key_idx < KEY_CNT, "Invalid key index %u", key_idx);
+
+	if (key_invalidated[key_idx]) {
+		return -EINVAL;
+	}
+
+	memcpy(p_buf, key_hashes[key_idx], SB_PUBLIC_KEY_HASH_LEN);
+
+	return SB_PUBLIC_KEY_HASH_LEN;
+}
+
+void invalidate_public_key(uint32_t key_idx)
+{
+	zassert_true(key_idx < KEY_CNT, "Invalid key index %u", key_idx);
+
+	key_invalidated[key_idx] = true;
+}
+
+int num_monotonic_counter_slots(uint16_t counter_desc, uint16_t *counter_slots)
+{
+	*counter_slots = 1;
+
+	return 0;
+}
+
+int get_monotonic_counter(uint16_t counter_desc, counter_t *counter_value)
+{
+	*counter_value = monotonic_counter;
+
+	return 0;
+}
+
+int set_monotonic_counter(uint16_t counter_desc, counter_t new_counter)
+{
+	monotonic_counter = new_counter;
+
+	return 0;
+}
+
+int hw_unique_key_derive_key(enum hw_unique_key_slot key_slot,
+	const uint8_t *context, size_t context_size,
+	uint8_t const *label, size_t label_size,
+	uint8_t *output, uint32_t output_size)
+{
+	if (huk_err) {
+		return huk_err;
+	}
+
+	zassert_equal(output_size, sizeof(derived_key), "Invalid key size");
+	memcpy(output, derived_key, sizeof(derived_key));
+
+	return HW_UNIQUE_KEY_SUCCESS;
+}
+
+void nrfx_nvmc_words_write(uint32_t addr, const void *src, uint32_t num_words)
+{
+	uint8_t *dst = (uint8_t *)addr;
+	const uint8_t *data = src;
+
+	record_write_cnt++;
+	record_write_addr = addr;
+
+	/* Writing can only clear bits. */
+	for (size_t i = 0; i < num_words * sizeof(uint32_t); i++) {
+		dst[i] &= data[i];
+	}
+}
+
+static void sha256(const uint8_t *data, size_t len, uint8_t *hash)
+{
+	zassert_ok(bl_sha256_hash(data, len, hash), "Hashing failed");
+}
+
+/* Build a signed image of fw_size bytes at the start of the slot. The rest
+ * of the slot is erased.
+ */
+static void image_build(uint32_t fw_size)
+{
+	const uint32_t fw_info_magic[] = {FIRMWARE_INFO_MAGIC};
+	const uint32_t validation_info_magic[] = {VALIDATION_INFO_MAGIC};
+	struct fw_info *info = (struct fw_info *)&slot[CONFIG_FW_INFO_OFFSET];
+	struct validation_info *new_vinfo = (struct validation_info *)&slot[fw_size];
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+	size_t signature_len;
+	psa_status_t status;
+
+	zassert_true(fw_size + sizeof(*new_vinfo) <= sizeof(slot), "Image too large");
+
+	memset(slot, 0xff, sizeof(slot));
+
+	for (uint32_t i = 0; i < fw_size; i += sizeof(uint32_t)) {
+		*(uint32_t *)&slot[i] = i * 2654435761U;
+	}
+
+	/* Vector table: initial stack pointer followed by the reset vector. */
+	((uint32_t *)slot)[0] = (uint32_t)slot + fw_size;
+	((uint32_t *)slot)[1] = (uint32_t)slot + RESET_VECTOR_OFFSET;
+
+	memset(info, 0, sizeof(*info));
+	memcpy(info->magic, fw_info_magic, sizeof(info->magic));
+	info->total_size = sizeof(*info);
+	info->size = fw_size;
+	info->version = FW_VERSION;
+	info->address = (uint32_t)slot;
+	info->boot_address = (uint32_t)slot;
+	info->valid = CONFIG_FW_INFO_VALID_VAL;
+
+	memcpy(new_vinfo->magic, validation_info_magic, sizeof(new_vinfo->magic));
+	new_vinfo->address = (uint32_t)slot;
+	sha256(slot, fw_size, new_vinfo->hash);
+	memcpy(new_vinfo->public_key, signing_public_key, sizeof(new_vinfo->public_key));
+
+	sha256(new_vinfo->hash, sizeof(new_vinfo->hash), hash);
+	status = psa_sign_hash(signing_key_id, PSA_ALG_ECDSA(PSA_ALG_SHA_256), hash, sizeof(hash),
+			       new_vinfo->signature, sizeof(new_vinfo->signature), &signature_len);
+	zassert_equal(status, PSA_SUCCESS, "Signing failed: %d", status);
+	zassert_equal(signature_len, sizeof(new_vinfo->signature), "Invalid signature length");
+
+	vinfo = new_vinfo;
+}
+
+/* The record is expected in the erased space directly after the validation info. */
+static const struct bl_validation_record *record_get(void)
+{
+	return (const struct bl_validation_record *)ROUND_UP((uintptr_t)(vinfo + 1), 4);
+}
+
+static void binding_get(struct bl_validation_binding *binding)
+{
+	const struct fw_info *info = (const struct fw_info *)&slot[CONFIG_FW_INFO_OFFSET];
+
+	binding->fw_address = (uint32_t)slot;
+	binding->fw_size = info->size;
+	binding->counter = monotonic_counter >> 1;
+	sha256(slot, info->size, binding->hash);
+}
+
+static bool boot(void)
+{
+	return bl_validate_firmware_local((uint32_t)slot,
+					  (const struct fw_info *)&slot[CONFIG_FW_INFO_OFFSET]);
+}
+
+static uint64_t boot_time_ns(void)
+{
+	uint64_t start = test_time_ns_get();
+
+	zassert_true(boot(), "Boot failed");
+
+	return test_time_ns_get() - start;
+}
+
+static void *setup(void)
+{
+	psa_key_attributes_t attr = PSA_KEY_ATTRIBUTES_INIT;
+	uint8_t key[1 + CONFIG_SB_PUBLIC_KEY_LEN];
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+	size_t key_len;
+	psa_status_t status;
+
+	status = psa_crypto_init();
+	zassert_equal(status, PSA_SUCCESS, "PSA init failed: %d", status);
+
+	psa_set_key_type(&attr, PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_FAMILY_SECP_R1));
+	psa_set_key_bits(&attr, 256);
+	psa_set_key_usage_flags(&attr, PSA_KEY_USAGE_SIGN_HASH | PSA_KEY_USAGE_VERIFY_HASH);
+	psa_set_key_algorithm(&attr, PSA_ALG_ECDSA(PSA_ALG_SHA_256));
+
+	status = psa_import_key(&attr, signing_key, sizeof(signing_key), &signing_key_id);
+	zassert_equal(status, PSA_SUCCESS, "Key import failed: %d", status);
+
+	status = psa_export_public_key(signing_key_id, key, sizeof(key), &key_len);
+	zassert_equal(status, PSA_SUCCESS, "Public key export failed: %d", status);
+	zassert_equal(key_len, sizeof(key), "Invalid public key length");
+	memcpy(signing_public_key, &key[1], sizeof(signing_public_key));
+
+	/* The first provisioned key does not match the signing key. */
+	sha256(signing_public_key, sizeof(signing_public_key), hash);
+	memcpy(key_hashes[SIGNING_KEY_IDX], hash, SB_PUBLIC_KEY_HASH_LEN);
+	memcpy(key_hashes[0], hash, SB_PUBLIC_KEY_HASH_LEN);
+	key_hashes[0][0] ^= 0x01;
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(key_invalidated, 0, sizeof(key_invalidated));
+	monotonic_counter = COUNTER_VERSION << 1;
+	huk_err = 0;
+
+	image_build(FW_SIZE);
+
+	verify_cnt = 0;
+	record_write_cnt = 0;
+	record_write_addr = 0;
+}
+
+ZTEST(bl_validation_cache, test_record_placement)
+{
+	const struct bl_validation_record *record = record_get();
+	struct bl_validation_binding binding;
+	struct bl_validation_record expected;
+
+	zassert_true(bl_validation_record_is_erased(record), "Record location not erased");
+
+	zassert_true(boot(), "Boot failed");
+	zassert_equal(verify_cnt, 1, "Signature not verified");
+	zassert_equal(record_write_cnt, 1, "Record not written");
+	zassert_equal(record_write_addr, (uint32_t)record,
+		      "Record not written after the validation info");
+
+	binding_get(&binding);
+	zassert_ok(bl_validation_record_create(derived_key, &binding, &expected));
+	zassert_mem_equal(record, &expected, sizeof(expected), "Invalid record");
+}
+
+ZTEST(bl_validation_cache, test_cached_boot)
+{
+	zassert_true(boot(), "First boot failed");
+	zassert_equal(verify_cnt, 1, "Signature not verified");
+
+	for (int i = 0; i < 3; i++) {
+		zassert_true(boot(), "Cached boot failed");
+	}
+
+	zassert_equal(verify_cnt, 1, "Signature verified on a cached boot");
+	zassert_equal(record_write_cnt, 1, "Record written more than once");
+}
+
+ZTEST(bl_validation_cache, test_public_key_revoked)
+{
+	zassert_true(boot(), "First boot failed");
+	zassert_true(key_invalidated[0], "Preceding key not invalidated");
+
+	invalidate_public_key(SIGNING_KEY_IDX);
+
+	zassert_false(boot(), "Firmware signed with a revoked key booted");
+}
+
+ZTEST(bl_validation_cache, test_monotonic_counter)
+{
+	const struct bl_validation_record *record = record_get();
+	struct bl_validation_record first;
+
+	zassert_true(boot(), "First boot failed");
+	memcpy(&first, record, sizeof(first));
+
+	/* The record is bound to the counter, so it must not be used once the counter changes. */
+	monotonic_counter = (COUNTER_VERSION + 1) << 1;
+
+	zassert_true(boot(), "Boot failed after the counter update");
+	zassert_equal(verify_cnt, 2, "Record used after the counter update");
+	zassert_equal(record_write_cnt, 1, "Record location written while not erased");
+	zassert_mem_equal(record, &first, sizeof(first), "Record modified");
+
+	monotonic_counter = COUNTER_VERSION << 1;
+
+	zassert_true(boot(), "Boot failed after the counter restore");
+	zassert_equal(verify_cnt, 2, "Record not used");
+}
+
+ZTEST(bl_validation_cache, test_image_modified)
+{
+	zassert_true(boot(), "First boot failed");
+
+	slot[FW_SIZE / 2] ^= 0x01;
+
+	zassert_false(boot(), "Modified image booted");
+	zassert_equal(verify_cnt, 2, "Signature not verified");
+}
+
+ZTEST(bl_validation_cache, test_no_record_space)
+{
+	image_build(SLOT_SIZE - sizeof(struct validation_info));
+
+	zassert_true(boot(), "First boot failed");
+	zassert_true(boot(), "Second boot failed");
+	zassert_equal(verify_cnt, 2, "Signature verification skipped");
+	zassert_equal(record_write_cnt, 0, "Record written outside of the slot");
+}
+
+ZTEST(bl_validation_cache, test_key_derivation_failed)
+{
+	huk_err = -HW_UNIQUE_KEY_ERR_DERIVE_FAILED;
+
+	zassert_true(boot(), "First boot failed");
+	zassert_true(boot(), "Second boot failed");
+	zassert_equal(verify_cnt, 2, "Signature verification skipped");
+	zassert_equal(record_write_cnt, 0, "Record written without a key");
+}
+
+ZTEST(bl_validation_cache, test_record_location_not_erased)
+{
+	memset((void *)record_get(), 0, sizeof(struct bl_validation_record));
+
+	zassert_true(boot(), "First boot failed");
+	zassert_true(boot(), "Second boot failed");
+	zassert_equal(verify_cnt, 2, "Signature verification skipped");
+	zassert_equal(record_write_cnt, 0, "Record written to a location that is not erased");
+}
+
+ZTEST(bl_validation_cache, test_record_forged)
+{
+	const struct bl_validation_record *record = record_get();
+	uint8_t other_key[BL_VALIDATION_CACHE_KEY_LEN];
+	struct bl_validation_binding binding;
+	struct bl_validation_record forged;
+
+	memcpy(other_key, derived_key, sizeof(other_key));
+	other_key[0] ^= 0x80;
+
+	binding_get(&binding);
+	zassert_ok(bl_validation_record_create(other_key, &binding, &forged));
+	memcpy((void *)record, &forged, sizeof(forged));
+
+	zassert_true(boot(), "Boot failed");
+	zassert_equal(verify_cnt, 1, "Record created with another key used");
+}
+
+ZTEST(bl_validation_cache, test_record_binding)
+{
+	struct bl_validation_binding binding;
+	struct bl_validation_binding modified;
+	struct bl_validation_record record;
+
+	binding_get(&binding);
+	zassert_ok(bl_validation_record_create(derived_key, &binding, &record));
+
+	modified = binding;
+	modified.hash[BL_VALIDATION_CACHE_HASH_LEN - 1] ^= 0x01;
+	zassert_false(bl_validation_record_check(derived_key, &modified, &record),
+		      "Record accepted for another hash");
+
+	modified = binding;
+	modified.counter++;
+	zassert_false(bl_validation_record_check(derived_key, &modified, &record),
+		      "Record accepted for another counter");
+
+	modified = binding;
+	modified.fw_address += sizeof(uint32_t);
+	zassert_false(bl_validation_record_check(derived_key, &modified, &record),
+		      "Record accepted for another address");
+
+	modified = binding;
+	modified.fw_size -= sizeof(uint32_t);
+	zassert_false(bl_validation_record_check(derived_key, &modified, &record),
+		      "Record accepted for another size");
+
+	zassert_true(bl_validation_record_check(derived_key, &binding, &record), "Record rejected");
+}
+
+ZTEST(bl_validation_cache, test_record_authentication)
+{
+	struct bl_validation_binding binding;
+	struct bl_validation_record record;
+	struct bl_validation_record modified;
+
+	binding_get(&binding);
+	zassert_ok(bl_validation_record_create(derived_key, &binding, &record));
+
+	modified = record;
+	modified.mac[0] ^= 0x01;
+	zassert_false(bl_validation_record_check(derived_key, &binding, &modified),
+		      "Record with modified MAC accepted");
+
+	modified = record;
+	modified.magic = ~modified.magic;
+	zassert_false(bl_validation_record_check(derived_key, &binding, &modified),
+		      "Record with invalid magic accepted");
+}
+
+ZTEST(bl_validation_cache, test_boot_time)
+{
+	uint64_t full_ns = 0;
+	uint64_t first_ns;
+	uint64_t cached_ns = 0;
+
+	/* Without a key the record is not used, and every boot is a full validation. */
+	huk_err = -HW_UNIQUE_KEY_ERR_DERIVE_FAILED;
+
+	for (int i = 0; i < BOOT_CNT; i++) {
+		full_ns += boot_time_ns();
+	}
+
+	zassert_equal(verify_cnt, BOOT_CNT, "Signature verification skipped");
+
+	huk_err = 0;
+
+	first_ns = boot_time_ns();
+	zassert_equal(record_write_cnt, 1, "Record not written");
+
+	for (int i = 0; i < BOOT_CNT; i++) {
+		cached_ns += boot_time_ns();
+	}
+
+	zassert_equal(verify_cnt, BOOT_CNT + 1, "Signature verified on a cached boot");
+
+	TC_PRINT("Image size: %u B\n", FW_SIZE);
+	TC_PRINT("Full validation: %llu ns\n", full_ns / BOOT_CNT);
+	TC_PRINT("First boot with validated record: %llu ns\n", first_ns);
+	TC_PRINT("Boot with validated record: %llu ns\n", cached_ns / BOOT_CNT);
+}
+
+ZTEST_SUITE(bl_validation_cache, NULL, setup, before, NULL, NULL);
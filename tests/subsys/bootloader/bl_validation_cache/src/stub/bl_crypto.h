@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BL_CRYPTO_H__
+#define BL_CRYPTO_H__
+
+/* Test replacement of the bootloader crypto header. The bl_sha256 API is
+ * implemented with PSA Crypto, which is available on native_sim. The other
+ * functions are implemented by the test.
+ */
+
+#include <errno.h>
+#include <zephyr/types.h>
+#include <psa/crypto.h>
+
+#define EHASHINV 101
+#define ESIGINV  102
+
+typedef psa_hash_operation_t bl_sha256_ctx_t;
+
+typedef int (*bl_root_of_trust_verify_t)(const uint8_t *public_key,
+					 const uint8_t *public_key_hash,
+					 const uint8_t *signature,
+					 const uint8_t *firmware,
+					 const uint32_t firmware_len);
+
+int bl_crypto_init(void);
+
+int bl_root_of_trust_verify(const uint8_t *public_key, const uint8_t *public_key_hash,
+			    const uint8_t *signature, const uint8_t *firmware,
+			    const uint32_t firmware_len);
+
+int bl_root_of_trust_verify_external(const uint8_t *public_key, const uint8_t *public_key_hash,
+				     const uint8_t *signature, const uint8_t *firmware,
+				     const uint32_t firmware_len);
+
+int bl_root_of_trust_verify_hash(const uint8_t *public_key, const uint8_t *public_key_hash,
+				 const uint8_t *signature, const uint8_t *firmware_hash);
+
+void bl_root_of_trust_housekeeping(void);
+
+static inline int bl_sha256_init(bl_sha256_ctx_t *ctx)
+{
+	*ctx = psa_hash_operation_init();
+
+	return (psa_hash_setup(ctx, PSA_ALG_SHA_256) == PSA_SUCCESS) ? 0 : -EIO;
+}
+
+static inline int bl_sha256_update(bl_sha256_ctx_t *ctx, const uint8_t *data, uint32_t data_len)
+{
+	return (psa_hash_update(ctx, data, data_len) == PSA_SUCCESS) ? 0 : -EIO;
+}
+
+static inline int bl_sha256_finalize(bl_sha256_ctx_t *ctx, uint8_t *output)
+{
+	size_t len;
+
+	return (psa_hash_finish(ctx, output, PSA_HASH_LENGTH(PSA_ALG_SHA_256), &len) ==
+		PSA_SUCCESS) ? 0 : -EIO;
+}
+
+static inline int bl_sha256_hash(const uint8_t *data, uint32_t data_len, uint8_t *hash)
+{
+	size_t len;
+
+	return (psa_hash_compute(PSA_ALG_SHA_256, data, data_len, hash,
+				 PSA_HASH_LENGTH(PSA_ALG_SHA_256), &len) == PSA_SUCCESS) ? 0 : -EIO;
+}
+
+#endif /* BL_CRYPTO_H__ */
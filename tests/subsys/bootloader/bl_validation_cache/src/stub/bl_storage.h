@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BL_STORAGE_H_
+#define BL_STORAGE_H_
+
+/* Test replacement of the bootloader storage header. The public key hashes
+ * and the monotonic counter are kept in RAM by the test.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/types.h>
+
+typedef uint16_t counter_t;
+
+#define EHASHFF 113
+
+#define SB_PUBLIC_KEY_HASH_LEN 16
+
+#define BL_MONOTONIC_COUNTERS_DESC_NSIB 0x1
+
+uint32_t num_public_keys_read(void);
+
+int verify_public_keys(void);
+
+int public_key_data_read(uint32_t key_idx, uint8_t *p_buf);
+
+void invalidate_public_key(uint32_t key_idx);
+
+int num_monotonic_counter_slots(uint16_t counter_desc, uint16_t *counter_slots);
+
+int get_monotonic_counter(uint16_t counter_desc, counter_t *counter_value);
+
+int set_monotonic_counter(uint16_t counter_desc, counter_t new_counter);
+
+#endif /* BL_STORAGE_H_ */
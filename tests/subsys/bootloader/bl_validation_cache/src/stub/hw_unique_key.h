@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef HW_UNIQUE_KEY_H_
+#define HW_UNIQUE_KEY_H_
+
+/* Test replacement of the Hardware Unique Key header. Key derivation is
+ * implemented by the test.
+ */
+
+#include <zephyr/types.h>
+
+#define HW_UNIQUE_KEY_ERR_DERIVE_FAILED (0x16504)
+
+#define HW_UNIQUE_KEY_SUCCESS (0x0)
+
+enum hw_unique_key_slot {
+	HUK_KEYSLOT_KDR  = 0,
+	HUK_KEYSLOT_MKEK = 2,
+};
+
+int hw_unique_key_derive_key(enum hw_unique_key_slot key_slot,
+	const uint8_t *context, size_t context_size,
+	uint8_t const *label, size_t label_size,
+	uint8_t *output, uint32_t output_size);
+
+#endif /* HW_UNIQUE_KEY_H_ */
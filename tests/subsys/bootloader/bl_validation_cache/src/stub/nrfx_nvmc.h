@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRFX_NVMC_H__
+#define NRFX_NVMC_H__
+
+/* Test replacement of the NVMC driver header. The flash is emulated in RAM
+ * by the test.
+ */
+
+#include <zephyr/types.h>
+
+void nrfx_nvmc_words_write(uint32_t addr, const void *src, uint32_t num_words);
+
+#endif /* NRFX_NVMC_H__ */
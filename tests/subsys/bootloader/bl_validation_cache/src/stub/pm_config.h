@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PM_CONFIG_H__
+#define PM_CONFIG_H__
+
+/* Test replacement of the Partition Manager configuration. Only the slot
+ * sizes are used.
+ */
+
+#define PM_S0_SIZE 0x40000
+#define PM_S1_SIZE 0x40000
+
+#endif /* PM_CONFIG_H__ */
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <app_event_manager.h>
+#include <caf/events/sensor_event.h>
+#include <caf/events/sensor_data_aggregator_event.h>
+#include <caf/sensor_data_aggregator.h>
+
+#include "test_time.h"
+
+#define MODULE test_throughput
+
+#define SENSOR_DESCR "bench_sensor"
+#define VALUES_IN_SAMPLE 3
+#define SAMPLES_IN_BUF 10
+#define SAMPLE_CNT 20000
+
+static atomic_t received_samples;
+static atomic_t received_batches;
+static atomic_t batch_errors;
+static int64_t prev_last_sample_time;
+static int32_t next_sample_idx;
+
+static void wait_for_samples(void)
+{
+	while (atomic_get(&received_samples) < SAMPLE_CNT) {
+		k_yield();
+	}
+}
+
+static void report(const char *name, uint64_t time_ns)
+{
+	uint64_t rate = (time_ns > 0) ? ((uint64_t)SAMPLE_CNT * NSEC_PER_SEC / time_ns) : 0;
+
+	TC_PRINT("%s: %u samples in %u batches, %llu ns, %llu samples/s\n", name,
+		 (unsigned int)atomic_get(&received_samples),
+		 (unsigned int)atomic_get(&received_batches), time_ns, rate);
+}
+
+static void *test_init(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	return NULL;
+}
+
+static void test_before(void *f)
+{
+	atomic_clear(&received_samples);
+	atomic_clear(&received_batches);
+	atomic_clear(&batch_errors);
+	prev_last_sample_time = k_uptime_get();
+	next_sample_idx = 0;
+}
+
+static bool batch_valid(const struct sensor_data_aggregator_event *event)
+{
+	if ((event->sample_cnt != SAMPLES_IN_BUF) ||
+	    (event->values_in_sample != VALUES_IN_SAMPLE)) {
+		return false;
+	}
+
+	/* Batches are sent in order and hold samples of the test only. */
+	if ((event->first_sample_time < prev_last_sample_time) ||
+	    (event->last_sample_time < event->first_sample_time) ||
+	    (event->last_sample_time > k_uptime_get())) {
+		return false;
+	}
+	prev_last_sample_time = event->last_sample_time;
+
+	/* No sample is lost, duplicated or reordered. */
+	for (size_t i = 0; i < event->sample_cnt; i++) {
+		const struct sensor_value *sample = &event->samples[i * VALUES_IN_SAMPLE];
+
+		if (sample[0].val1 != next_sample_idx) {
+			return false;
+		}
+		next_sample_idx++;
+	}
+
+	return true;
+}
+
+ZTEST(caf_sensor_aggregator_throughput, test_sensor_event)
+{
+	uint64_t start = test_time_ns_get();
+
+	for (size_t i = 0; i < SAMPLE_CNT; i++) {
+		size_t size = sizeof(struct sensor_value) * VALUES_IN_SAMPLE;
+		struct sensor_event *event = new_sensor_event(size);
+		struct sensor_value *data = sensor_event_get_data_ptr(event);
+
+		event->descr = SENSOR_DESCR;
+		for (size_t j = 0; j < VALUES_IN_SAMPLE; j++) {
+			data[j].val1 = i;
+			data[j].val2 = j;
+		}
+		APP_EVENT_SUBMIT(event);
+
+		/* Let the system workqueue process the events to limit the heap usage. */
+		if ((i % SAMPLES_IN_BUF) == (SAMPLES_IN_BUF - 1)) {
+			k_yield();
+		}
+	}
+
+	wait_for_samples();
+	report("sensor_event", test_time_ns_get() - start);
+
+	zassert_equal(atomic_get(&received_samples), SAMPLE_CNT, "Samples lost");
+	zassert_equal(atomic_get(&batch_errors), 0, "Invalid batches");
+}
+
+ZTEST(caf_sensor_aggregator_throughput, test_direct_write)
+{
+	uint64_t start = test_time_ns_get();
+
+	for (size_t i = 0; i < SAMPLE_CNT; i++) {
+		struct sensor_value *data;
+
+		while (!(data = sensor_data_aggregator_sample_claim(SENSOR_DESCR,
+								    VALUES_IN_SAMPLE))) {
+			/* All buffers are waiting for the consumer. */
+			k_yield();
+		}
+
+		for (size_t j = 0; j < VALUES_IN_SAMPLE; j++) {
+			data[j].val1 = i;
+			data[j].val2 = j;
+		}
+		sensor_data_aggregator_sample_commit(SENSOR_DESCR, k_uptime_get());
+	}
+
+	wait_for_samples();
+	report("direct write", test_time_ns_get() - start);
+
+	zassert_equal(atomic_get(&received_samples), SAMPLE_CNT, "Samples lost");
+	zassert_equal(atomic_get(&batch_errors), 0, "Invalid batches");
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_sensor_data_aggregator_event(aeh)) {
+		const struct sensor_data_aggregator_event *event =
+			cast_sensor_data_aggregator_event(aeh);
+		struct sensor_data_aggregator_release_buffer_event *release_evt =
+			new_sensor_data_aggregator_release_buffer_event();
+
+		if (!batch_valid(event)) {
+			atomic_inc(&batch_errors);
+		}
+
+		atomic_add(&received_samples, event->sample_cnt);
+		atomic_inc(&received_batches);
+
+		release_evt->samples = event->samples;
+		release_evt->sensor_descr = event->sensor_descr;
+		APP_EVENT_SUBMIT(release_evt);
+
+		return false;
+	}
+
+	zassert_unreachable("Event unhandled");
+
+	return false;
+}
+
+ZTEST_SUITE(caf_sensor_aggregator_throughput, NULL, test_init, test_before, NULL, NULL);
+
+APP_EVENT_LISTENER(MODULE, app_event_handler);
+APP_EVENT_SUBSCRIBE(MODULE, sensor_data_aggregator_event);
@@ -31,6 +31,16 @@ static const struct caf_sampled_channel accel_chan[] = {
 	},
 };
 
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+/* Not supported by the simulated sensor, reading the channel fails. */
+static const struct caf_sampled_channel faulty_chan[] = {
+	{
+		.chan = SENSOR_CHAN_GYRO_XYZ,
+		.data_cnt = 3,
+	},
+};
+#endif
+
 static const struct sm_sensor_config sensor_configs[] = {
 	{
 		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_1)),
@@ -56,4 +66,22 @@ static const struct sm_sensor_config sensor_configs[] = {
 		.sampling_period_ms = 33000,
 		.active_events_limit = 3,
 	},
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_4)),
+		.event_descr = "Simulated sensor 4",
+		.chans = accel_chan,
+		.chan_cnt = ARRAY_SIZE(accel_chan),
+		.sampling_period_ms = 20,
+		.active_events_limit = 3,
+	},
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_5)),
+		.event_descr = "Faulty sensor",
+		.chans = faulty_chan,
+		.chan_cnt = ARRAY_SIZE(faulty_chan),
+		.sampling_period_ms = 20,
+		.active_events_limit = 3,
+	},
+#endif
 };
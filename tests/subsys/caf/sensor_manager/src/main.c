@@ -16,6 +16,11 @@
 
 #include <caf/events/module_state_event.h>
 
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+#include <caf/events/sensor_data_aggregator_event.h>
+#include <caf/sensor_data_aggregator.h>
+#endif
+
 LOG_MODULE_REGISTER(MODULE);
 
 #define PRE_CHANGE_SAMPLING_PERIOD 20
@@ -29,6 +34,29 @@ int64_t first_event_uptime;
 uint8_t sensors_tested;
 uint8_t sensors_tested_mask;
 
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+#define DIRECT_SENSOR_DESCR "Simulated sensor 4"
+#define DIRECT_SAMPLING_PERIOD 20
+#define FAULTY_SENSOR_DESCR "Faulty sensor"
+#define VALUES_IN_SAMPLE 3
+#define SAMPLES_IN_BUF 10
+#define DIRECT_BATCH_CNT 5
+
+struct faulty_sensor_batch {
+	int64_t first_sample_time;
+	int64_t last_sample_time;
+	uint8_t sample_cnt;
+	int32_t val1[SAMPLES_IN_BUF];
+};
+
+static atomic_t direct_batches;
+static atomic_t direct_errors;
+static int64_t direct_last_sample_time;
+static atomic_t faulty_error_sample_cnt;
+static K_SEM_DEFINE(faulty_error_sem, 0, 1);
+K_MSGQ_DEFINE(faulty_batch_msgq, sizeof(struct faulty_sensor_batch), 4, 4);
+#endif
+
 static void test_start(enum test_id test_id)
 {
 	cur_test_id = test_id;
@@ -122,8 +150,197 @@ ZTEST(caf_sensor_manager_tests, test_multiple_sensors)
 	test_start(TEST_MULTIPLE_SENSORS);
 }
 
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+static void faulty_sensor_wait_error(void)
+{
+	/* Sensor manager stops sampling the sensor after the failed sample. */
+	zassert_ok(k_sem_take(&faulty_error_sem, K_SECONDS(1)), "Sensor error not reported");
+	k_sem_give(&faulty_error_sem);
+	k_msgq_purge(&faulty_batch_msgq);
+}
+
+static void faulty_sensor_flush(struct faulty_sensor_batch *batch)
+{
+	struct sensor_state_event *event = new_sensor_state_event();
+
+	event->descr = FAULTY_SENSOR_DESCR;
+	event->state = SENSOR_STATE_SLEEP;
+	APP_EVENT_SUBMIT(event);
+
+	zassert_ok(k_msgq_get(&faulty_batch_msgq, batch, K_SECONDS(1)), "Buffer not sent");
+}
+
+static void faulty_sensor_sample_write(int32_t val1, int64_t timestamp)
+{
+	struct sensor_value *data = sensor_data_aggregator_sample_claim(FAULTY_SENSOR_DESCR,
+									VALUES_IN_SAMPLE);
+
+	zassert_not_null(data, "Cannot claim sample");
+	for (size_t i = 0; i < VALUES_IN_SAMPLE; i++) {
+		data[i].val1 = val1;
+		data[i].val2 = i;
+	}
+	sensor_data_aggregator_sample_commit(FAULTY_SENSOR_DESCR, timestamp);
+}
+
+ZTEST(caf_sensor_manager_tests, test_aggregator_direct)
+{
+	atomic_val_t start_batches = atomic_get(&direct_batches);
+
+	for (size_t i = 0; i < (DIRECT_BATCH_CNT * SAMPLES_IN_BUF); i++) {
+		if ((atomic_get(&direct_batches) - start_batches) >= DIRECT_BATCH_CNT) {
+			break;
+		}
+		k_sleep(K_MSEC(DIRECT_SAMPLING_PERIOD));
+	}
+
+	zassert_true((atomic_get(&direct_batches) - start_batches) >= DIRECT_BATCH_CNT,
+		     "Samples not written to the aggregator");
+	zassert_equal(atomic_get(&direct_errors), 0, "Invalid samples written to the aggregator");
+}
+
+ZTEST(caf_sensor_manager_tests, test_aggregator_direct_fetch_error)
+{
+	struct faulty_sensor_batch batch;
+	struct sensor_value *data;
+
+	faulty_sensor_wait_error();
+
+	/* The sample claimed before the failed fetch is not stored. */
+	zassert_equal(atomic_get(&faulty_error_sample_cnt), 0, "Failed sample stored");
+
+	/* The claim is released, so the slot can be written again. */
+	data = sensor_data_aggregator_sample_claim(FAULTY_SENSOR_DESCR, VALUES_IN_SAMPLE);
+	zassert_not_null(data, "Cannot claim sample");
+	data[0].val1 = 1;
+	sensor_data_aggregator_sample_abort(FAULTY_SENSOR_DESCR);
+
+	zassert_equal_ptr(sensor_data_aggregator_sample_claim(FAULTY_SENSOR_DESCR,
+							      VALUES_IN_SAMPLE),
+			  data, "Aborted slot not reused");
+	data[0].val1 = 2;
+	sensor_data_aggregator_sample_commit(FAULTY_SENSOR_DESCR, 100);
+
+	faulty_sensor_flush(&batch);
+	zassert_equal(batch.sample_cnt, 1, "Invalid sample count");
+	zassert_equal(batch.val1[0], 2, "Aborted sample stored");
+	zassert_equal(batch.first_sample_time, 100, "Invalid first sample time");
+	zassert_equal(batch.last_sample_time, 100, "Invalid last sample time");
+}
+
+ZTEST(caf_sensor_manager_tests, test_aggregator_direct_state_change)
+{
+	struct faulty_sensor_batch batch;
+	struct sensor_value *data;
+
+	faulty_sensor_wait_error();
+
+	faulty_sensor_sample_write(1, 100);
+	faulty_sensor_sample_write(2, 200);
+
+	data = sensor_data_aggregator_sample_claim(FAULTY_SENSOR_DESCR, VALUES_IN_SAMPLE);
+	zassert_not_null(data, "Cannot claim sample");
+	data[0].val1 = 3;
+
+	/* Sensor state change sends the buffer while the sample is being written. */
+	faulty_sensor_flush(&batch);
+	zassert_equal(batch.sample_cnt, 2, "Invalid sample count");
+	zassert_equal(batch.val1[0], 1, "Invalid sample");
+	zassert_equal(batch.val1[1], 2, "Invalid sample");
+	zassert_equal(batch.first_sample_time, 100, "Invalid first sample time");
+	zassert_equal(batch.last_sample_time, 200, "Invalid last sample time");
+
+	/* The claimed sample is dropped. */
+	sensor_data_aggregator_sample_commit(FAULTY_SENSOR_DESCR, 300);
+
+	faulty_sensor_flush(&batch);
+	zassert_equal(batch.sample_cnt, 0, "Dropped sample stored");
+
+	/* Next sample is stored in the new buffer. */
+	faulty_sensor_sample_write(4, 400);
+
+	faulty_sensor_flush(&batch);
+	zassert_equal(batch.sample_cnt, 1, "Invalid sample count");
+	zassert_equal(batch.val1[0], 4, "Invalid sample");
+}
+
+static void direct_sensor_batch_check(const struct sensor_data_aggregator_event *event)
+{
+	int64_t span = event->last_sample_time - event->first_sample_time;
+	int64_t expected_span = (event->sample_cnt - 1) * DIRECT_SAMPLING_PERIOD;
+
+	/* Buffers are sent only when full, unless the sensor state changes. */
+	if (event->sample_cnt == 0) {
+		return;
+	}
+
+	if ((event->sample_cnt != SAMPLES_IN_BUF) ||
+	    (span < (expected_span - event->sample_cnt)) ||
+	    (span > (expected_span + event->sample_cnt))) {
+		atomic_inc(&direct_errors);
+	}
+
+	/* Consecutive buffers hold consecutive samples. */
+	if ((direct_last_sample_time != 0) &&
+	    ((event->first_sample_time - direct_last_sample_time < DIRECT_SAMPLING_PERIOD - 1) ||
+	     (event->first_sample_time - direct_last_sample_time > DIRECT_SAMPLING_PERIOD + 1))) {
+		atomic_inc(&direct_errors);
+	}
+	direct_last_sample_time = event->last_sample_time;
+
+	atomic_inc(&direct_batches);
+}
+
+static void faulty_sensor_batch_store(const struct sensor_data_aggregator_event *event)
+{
+	struct faulty_sensor_batch batch = {
+		.first_sample_time = event->first_sample_time,
+		.last_sample_time = event->last_sample_time,
+		.sample_cnt = event->sample_cnt,
+	};
+
+	if (event->sensor_state == SENSOR_STATE_ERROR) {
+		atomic_set(&faulty_error_sample_cnt, event->sample_cnt);
+		k_sem_give(&faulty_error_sem);
+		return;
+	}
+
+	/* Only buffers sent on state changes submitted by the test are verified. */
+	if (event->sensor_state != SENSOR_STATE_SLEEP) {
+		return;
+	}
+
+	for (size_t i = 0; i < MIN(event->sample_cnt, SAMPLES_IN_BUF); i++) {
+		batch.val1[i] = event->samples[i * event->values_in_sample].val1;
+	}
+
+	zassert_ok(k_msgq_put(&faulty_batch_msgq, &batch, K_NO_WAIT), "Buffer not verified");
+}
+#endif
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+	if (is_sensor_data_aggregator_event(aeh)) {
+		const struct sensor_data_aggregator_event *event =
+			cast_sensor_data_aggregator_event(aeh);
+		struct sensor_data_aggregator_release_buffer_event *release_evt =
+			new_sensor_data_aggregator_release_buffer_event();
+
+		if (!strcmp(event->sensor_descr, DIRECT_SENSOR_DESCR)) {
+			direct_sensor_batch_check(event);
+		} else if (!strcmp(event->sensor_descr, FAULTY_SENSOR_DESCR)) {
+			faulty_sensor_batch_store(event);
+		}
+
+		release_evt->samples = event->samples;
+		release_evt->sensor_descr = event->sensor_descr;
+		APP_EVENT_SUBMIT(release_evt);
+
+		return false;
+	}
+#endif
+
 	if (is_test_end_event(aeh)) {
 		struct test_end_event *ev = cast_test_end_event(aeh);
 
@@ -139,6 +356,14 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 		struct sensor_event *ev = cast_sensor_event(aeh);
 
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+		/* Samples written directly to the aggregator are not sent as sensor_event. */
+		if (!strcmp(ev->descr, DIRECT_SENSOR_DESCR)) {
+			atomic_inc(&direct_errors);
+			return false;
+		}
+#endif
+
 		switch (cur_test_id) {
 		case TEST_BASIC:
 			cur_test_id = TEST_IDLE;
@@ -240,3 +465,6 @@ APP_EVENT_LISTENER(test_main, app_event_handler);
 APP_EVENT_SUBSCRIBE(test_main, test_end_event);
 APP_EVENT_SUBSCRIBE(test_main, sensor_event);
 APP_EVENT_SUBSCRIBE(test_main, test_initialization_done_event);
+#if CONFIG_CAF_SENSOR_MANAGER_AGGREGATOR_DIRECT
+APP_EVENT_SUBSCRIBE(test_main, sensor_data_aggregator_event);
+#endif
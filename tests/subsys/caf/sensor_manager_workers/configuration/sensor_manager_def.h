@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <caf/sensor_manager.h>
+
+/* This configuration file is included only once from sensor_manager module and holds
+ * information about the sampled sensors.
+ */
+
+/* This structure enforces the header file is included only once in the build.
+ * Violating this requirement triggers a multiple definition error at link time.
+ */
+const struct {} sensor_manager_def_include_once;
+
+
+static const struct caf_sampled_channel emul_chan[] = {
+	{
+		.chan = SENSOR_CHAN_ACCEL_X,
+		.data_cnt = 1,
+	},
+};
+
+static const struct sm_sensor_config sensor_configs[] = {
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_fast)),
+		.event_descr = "Fast sensor",
+		.chans = emul_chan,
+		.chan_cnt = ARRAY_SIZE(emul_chan),
+		.sampling_period_ms = 10,
+		.active_events_limit = 3,
+	},
+	{
+		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_slow)),
+		.event_descr = "Slow sensor",
+		.chans = emul_chan,
+		.chan_cnt = ARRAY_SIZE(emul_chan),
+		.sampling_period_ms = 100,
+		.active_events_limit = 3,
+	},
+};
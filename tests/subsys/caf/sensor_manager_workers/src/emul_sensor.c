@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#define DT_DRV_COMPAT vnd_emul_sensor
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+
+struct emul_sensor_config {
+	uint32_t fetch_latency_ms;
+};
+
+struct emul_sensor_data {
+	int32_t sample_cnt;
+};
+
+static int emul_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan)
+{
+	const struct emul_sensor_config *config = dev->config;
+	struct emul_sensor_data *data = dev->data;
+
+	ARG_UNUSED(chan);
+
+	/* Simulate a blocking bus transfer. */
+	k_sleep(K_MSEC(config->fetch_latency_ms));
+	data->sample_cnt++;
+
+	return 0;
+}
+
+static int emul_sensor_channel_get(const struct device *dev, enum sensor_channel chan,
+				   struct sensor_value *val)
+{
+	struct emul_sensor_data *data = dev->data;
+
+	ARG_UNUSED(chan);
+
+	val->val1 = data->sample_cnt;
+	val->val2 = 0;
+
+	return 0;
+}
+
+static const struct sensor_driver_api emul_sensor_api = {
+	.sample_fetch = emul_sensor_sample_fetch,
+	.channel_get = emul_sensor_channel_get,
+};
+
+#define EMUL_SENSOR_DEFINE(inst)							\
+	static struct emul_sensor_data emul_sensor_data_##inst;				\
+											\
+	static const struct emul_sensor_config emul_sensor_config_##inst = {		\
+		.fetch_latency_ms = DT_INST_PROP(inst, fetch_latency_ms),		\
+	};										\
+											\
+	SENSOR_DEVICE_DT_INST_DEFINE(inst, NULL, NULL, &emul_sensor_data_##inst,	\
+				     &emul_sensor_config_##inst, POST_KERNEL,		\
+				     CONFIG_SENSOR_INIT_PRIORITY, &emul_sensor_api);
+
+DT_INST_FOREACH_STATUS_OKAY(EMUL_SENSOR_DEFINE)
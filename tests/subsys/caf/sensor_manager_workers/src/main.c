@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <app_event_manager.h>
+#include <caf/events/sensor_event.h>
+
+#define MODULE main
+
+#include <caf/events/module_state_event.h>
+
+#define FAST_SAMPLING_PERIOD 10
+#define SLOW_SAMPLING_PERIOD 100
+#define STARTUP_TIME_MS 250
+#define MEASURE_TIME_MS 2000
+#define JITTER_MAX_MS 2
+#define DROPS_MAX 1
+
+struct sampling_stats {
+	const char *descr;
+	int period;
+	uint32_t sample_cnt;
+	int64_t last_uptime;
+	int64_t max_jitter;
+};
+
+static struct sampling_stats stats[] = {
+	{
+		.descr = "Fast sensor",
+		.period = FAST_SAMPLING_PERIOD,
+	},
+	{
+		.descr = "Slow sensor",
+		.period = SLOW_SAMPLING_PERIOD,
+	},
+};
+
+static atomic_t measuring;
+
+
+static void stats_reset(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(stats); i++) {
+		stats[i].sample_cnt = 0;
+		stats[i].last_uptime = 0;
+		stats[i].max_jitter = 0;
+	}
+}
+
+static int stats_drops_get(const struct sampling_stats *s)
+{
+	return (MEASURE_TIME_MS / s->period) - s->sample_cnt;
+}
+
+static void measure(void)
+{
+	stats_reset();
+	atomic_set(&measuring, true);
+	k_sleep(K_MSEC(MEASURE_TIME_MS));
+	atomic_set(&measuring, false);
+	/* Let the system workqueue process the remaining events. */
+	k_sleep(K_MSEC(FAST_SAMPLING_PERIOD));
+
+	for (size_t i = 0; i < ARRAY_SIZE(stats); i++) {
+		TC_PRINT("%s: %u samples, %d dropped, max jitter %lld ms\n", stats[i].descr,
+			 stats[i].sample_cnt, stats_drops_get(&stats[i]),
+			 stats[i].max_jitter);
+	}
+}
+
+static void *test_init(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	module_set_state(MODULE_STATE_READY);
+	k_sleep(K_MSEC(STARTUP_TIME_MS));
+
+	return NULL;
+}
+
+ZTEST(caf_sensor_manager_workers, test_sampling_jitter)
+{
+	measure();
+
+	/* The fast sensor is not delayed by the slow sensor fetch only if the sensors are
+	 * sampled by separate workers.
+	 */
+	if (CONFIG_CAF_SENSOR_MANAGER_WORKER_CNT > 1) {
+		zassert_true(stats_drops_get(&stats[0]) <= DROPS_MAX, "Fast sensor samples dropped");
+		zassert_true(stats[0].max_jitter <= JITTER_MAX_MS, "Fast sensor jitter too big");
+	}
+
+	zassert_true(stats_drops_get(&stats[1]) <= DROPS_MAX, "Slow sensor samples dropped");
+	zassert_true(stats[1].max_jitter <= JITTER_MAX_MS, "Slow sensor jitter too big");
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_sensor_event(aeh)) {
+		const struct sensor_event *event = cast_sensor_event(aeh);
+		int64_t uptime = k_uptime_get();
+
+		if (!atomic_get(&measuring)) {
+			return false;
+		}
+
+		for (size_t i = 0; i < ARRAY_SIZE(stats); i++) {
+			struct sampling_stats *s = &stats[i];
+
+			if (strcmp(event->descr, s->descr)) {
+				continue;
+			}
+
+			if (s->sample_cnt > 0) {
+				int64_t jitter = llabs(uptime - s->last_uptime - s->period);
+
+				s->max_jitter = MAX(s->max_jitter, jitter);
+			}
+
+			s->last_uptime = uptime;
+			s->sample_cnt++;
+			return false;
+		}
+
+		zassert_unreachable("Unexpected sensor event");
+		return false;
+	}
+
+	zassert_unreachable("Wrong event type received");
+	return false;
+}
+
+ZTEST_SUITE(caf_sensor_manager_workers, NULL, test_init, NULL, NULL, NULL);
+
+APP_EVENT_LISTENER(test_main, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_main, sensor_event);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <debug/cpu_load.h>
+#include <tracing_user.h>
+
+#define BUSY_US 5000
+#define SLEEP_MS 5
+#define ISR_BUSY_US 2000
+#define ISR_PERIOD_MS 10
+#define NESTED_ISR_BUSY_US 100
+#define NESTED_THREAD_BUSY_US 800
+/* Wait until the sliding window contains only complete windows of the measured activity. */
+#define MEASURE_MS ((CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_COUNT + 1) * \
+		    CONFIG_NRF_CPU_LOAD_CONTEXT_WINDOW_MS + 50)
+/* Load is given in 0,001% units. */
+#define LOAD_PERCENT(x) ((x) * 1000)
+
+#define CTX_MAX (CONFIG_NRF_CPU_LOAD_CONTEXT_THREADS_MAX + CONFIG_NUM_IRQS + 2)
+
+static struct cpu_load_context ctx[CTX_MAX];
+static volatile bool busy_thread_run;
+
+static void busy_thread_fn(void *p1, void *p2, void *p3)
+{
+	while (busy_thread_run) {
+		k_busy_wait(BUSY_US);
+		k_sleep(K_MSEC(SLEEP_MS));
+	}
+}
+
+K_THREAD_STACK_DEFINE(busy_thread_stack, 1024);
+static struct k_thread busy_thread;
+
+static void busy_timer_handler(struct k_timer *timer)
+{
+	k_busy_wait(ISR_BUSY_US);
+}
+
+static K_TIMER_DEFINE(busy_timer, busy_timer_handler, NULL);
+
+static uint32_t load_get(const struct cpu_load_context *c, uint32_t window_cycles)
+{
+	return (uint32_t)(((uint64_t)c->cycles * 100000) / window_cycles);
+}
+
+static int contexts_get(uint32_t *window_cycles)
+{
+	int cnt = cpu_load_context_get(ctx, ARRAY_SIZE(ctx), window_cycles);
+
+	zassert_true(cnt > 0, "Unexpected result: %d", cnt);
+	zassert_true(*window_cycles > 0, "No complete window");
+
+	return cnt;
+}
+
+ZTEST(cpu_load_context, test_thread_load)
+{
+	uint32_t window_cycles;
+	bool found = false;
+	int cnt;
+
+	busy_thread_run = true;
+	k_thread_create(&busy_thread, busy_thread_stack,
+			K_THREAD_STACK_SIZEOF(busy_thread_stack), busy_thread_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	k_sleep(K_MSEC(MEASURE_MS));
+	cnt = contexts_get(&window_cycles);
+
+	busy_thread_run = false;
+	k_thread_join(&busy_thread, K_FOREVER);
+
+	for (int i = 0; i < cnt; i++) {
+		if ((ctx[i].type == CPU_LOAD_CONTEXT_THREAD) && (ctx[i].thread == &busy_thread)) {
+			uint32_t load = load_get(&ctx[i], window_cycles);
+
+			zassert_within(load, LOAD_PERCENT(50), LOAD_PERCENT(5),
+				       "Unexpected thread load: %u", load);
+			found = true;
+		}
+	}
+
+	zassert_true(found, "Busy thread not reported");
+}
+
+ZTEST(cpu_load_context, test_isr_load)
+{
+	uint32_t window_cycles;
+	uint32_t isr_load = 0;
+	int cnt;
+
+	k_timer_start(&busy_timer, K_MSEC(ISR_PERIOD_MS), K_MSEC(ISR_PERIOD_MS));
+	k_sleep(K_MSEC(MEASURE_MS));
+	cnt = contexts_get(&window_cycles);
+	k_timer_stop(&busy_timer);
+
+	/* The timer handler runs in the system timer interrupt. */
+	for (int i = 0; i < cnt; i++) {
+		if (ctx[i].type == CPU_LOAD_CONTEXT_ISR) {
+			isr_load += load_get(&ctx[i], window_cycles);
+		}
+	}
+
+	zassert_true(isr_load >= LOAD_PERCENT(15), "Unexpected ISR load: %u", isr_load);
+}
+
+ZTEST(cpu_load_context, test_total_cycles)
+{
+	uint32_t window_cycles;
+	uint32_t sum = 0;
+	int cnt;
+
+	k_sleep(K_MSEC(MEASURE_MS));
+	cnt = contexts_get(&window_cycles);
+
+	/* Every cycle of the sliding window is accounted to exactly one context. */
+	for (int i = 0; i < cnt; i++) {
+		sum += ctx[i].cycles;
+	}
+
+	zassert_equal(sum, window_cycles, "Cycles mismatch: %u != %u", sum, window_cycles);
+}
+
+ZTEST(cpu_load_context, test_nested_isr)
+{
+	int64_t end = k_uptime_get() + MEASURE_MS;
+	uint32_t window_cycles;
+	uint32_t thread_load = 0;
+	uint32_t isr_load = 0;
+	int cnt;
+
+	/* Emulate nested interrupts on an architecture that always reports nesting level 0,
+	 * like Cortex-M. The thread must get its context back after the outer interrupt exits.
+	 */
+	while (k_uptime_get() < end) {
+		unsigned int key = irq_lock();
+
+		sys_trace_isr_enter_user(0);
+		k_busy_wait(NESTED_ISR_BUSY_US);
+		sys_trace_isr_enter_user(0);
+		k_busy_wait(NESTED_ISR_BUSY_US);
+		sys_trace_isr_exit_user(0);
+		sys_trace_isr_exit_user(0);
+
+		irq_unlock(key);
+		k_busy_wait(NESTED_THREAD_BUSY_US);
+	}
+
+	cnt = contexts_get(&window_cycles);
+
+	for (int i = 0; i < cnt; i++) {
+		if ((ctx[i].type == CPU_LOAD_CONTEXT_THREAD) && (ctx[i].thread == k_current_get())) {
+			thread_load = load_get(&ctx[i], window_cycles);
+		} else if ((ctx[i].type == CPU_LOAD_CONTEXT_ISR) && (ctx[i].irq == -1)) {
+			/* The emulated interrupts are not identified. */
+			isr_load = load_get(&ctx[i], window_cycles);
+		}
+	}
+
+	zassert_within(thread_load, LOAD_PERCENT(80), LOAD_PERCENT(5),
+		       "Unexpected thread load: %u", thread_load);
+	zassert_within(isr_load, LOAD_PERCENT(20), LOAD_PERCENT(5),
+		       "Unexpected ISR load: %u", isr_load);
+}
+
+ZTEST_SUITE(cpu_load_context, NULL, NULL, NULL, NULL, NULL);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <zephyr/types.h>
 #include <zephyr/drivers/flash.h>
@@ -11,6 +12,10 @@
 #include <zephyr/ztest.h>
 #include <dfu/dfu_target_stream.h>
 
+#ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+#include <zephyr/settings/settings.h>
+#endif
+
 #define FLASH_BASE (64*1024)
 #define FLASH_AVAILABLE (16*1024)
 
@@ -18,6 +23,7 @@
 #define TEST_ID_2 "test_2"
 
 #define BUF_LEN 14000 /* Note, not page aligned */
+#define CHUNK_LEN 500 /* Note, not write block aligned */
 
 static const struct device *fdev = DEVICE_DT_GET(DT_CHOSEN(zephyr_flash_controller));
 static uint8_t sbuf[128];
@@ -101,7 +107,215 @@ ZTEST(dfu_target_stream_test, test_dfu_target_stream)
 	zassert_mem_equal(read_buf, write_buf, BUF_LEN, "Incorrect value");
 }
 
+ZTEST(dfu_target_stream_test, test_dfu_target_stream_chunked)
+{
+	int err;
+	size_t offset;
+	size_t buffered;
+	int64_t start_ticks;
+	int64_t elapsed_us;
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	for (size_t i = 0; i < BUF_LEN; i++) {
+		write_buf[i] = (uint8_t)i;
+	}
+
+	/* Write the data in chunks, as received from a download client. */
+	start_ticks = k_uptime_ticks();
+
+	for (size_t pos = 0; pos < BUF_LEN; pos += CHUNK_LEN) {
+		err = dfu_target_stream_write(&write_buf[pos], MIN(CHUNK_LEN, BUF_LEN - pos));
+		zassert_equal(err, 0, "Unexpected failure: %d", err);
+	}
+
+	err = dfu_target_stream_offset_get(&offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_bytes_buffered_get(&buffered);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* All data must be either written to flash or buffered, once the writes are drained. */
+	zassert_equal(offset + buffered, BUF_LEN, "Invalid offset");
+	zassert_true(buffered < sizeof(sbuf), "Invalid number of buffered bytes");
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start_ticks);
+	TC_PRINT("Wrote %u bytes in %lld us\n", BUF_LEN, (long long)elapsed_us);
+
+	err = flash_read(fdev, FLASH_BASE, read_buf, BUF_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_mem_equal(read_buf, write_buf, BUF_LEN, "Incorrect value");
+
+	memset(write_buf, 0xaa, sizeof(write_buf));
+}
+
+ZTEST(dfu_target_stream_test, test_dfu_target_stream_write_error)
+{
+	int err;
+	int done_err;
+	size_t pos;
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* The stream is too small to fit the data. */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE / 2, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	for (pos = 0; pos < BUF_LEN; pos += CHUNK_LEN) {
+		err = dfu_target_stream_write(&write_buf[pos], MIN(CHUNK_LEN, BUF_LEN - pos));
+		if (err != 0) {
+			break;
+		}
+	}
+
+#ifdef CONFIG_DFU_TARGET_STREAM_ASYNC
+	/* Flash writes are done in the background, wait until the failing one is processed. */
+	if (err == 0) {
+		size_t offset;
+
+		err = dfu_target_stream_offset_get(&offset);
+		zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+		err = dfu_target_stream_write(write_buf, CHUNK_LEN);
+	}
+
+	/* The first error is latched and reported by all subsequent writes. */
+	zassert_true(err < 0, "Unexpected success: %d", err);
+	zassert_equal(dfu_target_stream_write(write_buf, CHUNK_LEN), err,
+		      "Error not reported by the subsequent write");
+
+	done_err = dfu_target_stream_done(true);
+	zassert_equal(done_err, err, "Error not reported on done: %d", done_err);
+#else
+	zassert_true(err < 0, "Unexpected success: %d", err);
+	zassert_true(pos + CHUNK_LEN > FLASH_AVAILABLE / 2, "Unexpected failure: %d", err);
+
+	done_err = dfu_target_stream_done(false);
+	zassert_equal(done_err, 0, "Unexpected failure: %d", done_err);
+#endif
+
+	/* The error does not affect the next stream. */
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_reset();
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_write(write_buf, BUF_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+}
+
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
+static int stored_progress_cb(const char *key, size_t len, settings_read_cb read_cb,
+			      void *cb_arg, void *param)
+{
+	size_t *progress = param;
+
+	if (len != sizeof(*progress)) {
+		return -EINVAL;
+	}
+
+	return (read_cb(cb_arg, progress, len) == len) ? 0 : -EIO;
+}
+
+static size_t stored_progress_get(const char *id)
+{
+	char key[32];
+	size_t progress = 0;
+	int err;
+
+	snprintf(key, sizeof(key), "dfu/%s", id);
+
+	err = settings_load_subtree_direct(key, stored_progress_cb, &progress);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	return progress;
+}
+
+ZTEST(dfu_target_stream_test, test_dfu_target_stream_save_progress_throttled)
+{
+	const size_t interval = CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS_INTERVAL_BYTES;
+	int err;
+	size_t offset;
+
+	if (interval == 0) {
+		ztest_test_skip();
+		return;
+	}
+
+	zassert_true(interval + CHUNK_LEN <= BUF_LEN, "Progress interval is too large");
+
+	/* Reset state to avoid failure when initializing */
+	err = dfu_target_stream_done(true);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_reset();
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	/* Writes below the interval are not stored. */
+	err = dfu_target_stream_write(write_buf, CHUNK_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(stored_progress_get(TEST_ID_1), 0, "Progress stored too early");
+
+	/* Progress is stored once the interval is reached. */
+	err = dfu_target_stream_write(&write_buf[CHUNK_LEN], interval - CHUNK_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_offset_get(&offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(stored_progress_get(TEST_ID_1), offset, "Progress not stored");
+
+	/* The next record is not stored until another interval is reached. */
+	err = dfu_target_stream_write(&write_buf[interval], CHUNK_LEN);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(stored_progress_get(TEST_ID_1), offset, "Progress stored too early");
+
+	/* Unfinished stream always stores the progress. */
+	err = dfu_target_stream_done(false);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(stored_progress_get(TEST_ID_1), offset + CHUNK_LEN,
+		      "Progress not stored on done");
+
+	err = DFU_TARGET_STREAM_INIT(TEST_ID_1, fdev, sbuf, sizeof(sbuf),
+				     FLASH_BASE, FLASH_AVAILABLE, NULL);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_offset_get(&offset);
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+	zassert_equal(offset, interval + CHUNK_LEN, "Progress not restored");
+
+	err = dfu_target_stream_reset();
+	zassert_equal(err, 0, "Unexpected failure: %d", err);
+}
+
 ZTEST(dfu_target_stream_test, test_dfu_target_stream_save_progress)
 {
 	int err;
@@ -288,12 +502,27 @@ ZTEST(dfu_target_stream_test, test_dfu_target_stream_save_progress)
 	ztest_test_skip();
 }
 
+ZTEST(dfu_target_stream_test, test_dfu_target_stream_save_progress_throttled)
+{
+	ztest_test_skip();
+}
+
 #endif
 
 static void *setup(void)
 {
+	size_t offset;
+	int err;
+
 	__ASSERT_NO_MSG(device_is_ready(fdev));
 
+	/* Accessing the stream before it was initialized must not block. */
+	err = dfu_target_stream_offset_get(&offset);
+	__ASSERT(err == 0, "Unexpected failure: %d", err);
+
+	err = dfu_target_stream_bytes_buffered_get(&offset);
+	__ASSERT(err == 0, "Unexpected failure: %d", err);
+
 #ifdef CONFIG_DFU_TARGET_STREAM_SAVE_PROGRESS
 	/* Check that the FLASH_BASE macro is actually at the start of a page,
 	 * since this is important for the validity of the progress test.
@@ -89,6 +89,19 @@ static void app_store_cb(void)
 
 /** Mocks ******************************************/
 
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+static size_t flash_write_cnt;
+
+void __real_emds_flash_write_data(const struct emds_partition *partition, off_t data_off,
+				  void *data_chunk, size_t data_size);
+
+void __wrap_emds_flash_write_data(const struct emds_partition *partition, off_t data_off,
+				  void *data_chunk, size_t data_size)
+{
+	flash_write_cnt++;
+	__real_emds_flash_write_data(partition, data_off, data_chunk, data_size);
+}
+#endif
 
 /** End Mocks **************************************/
 
@@ -147,19 +160,24 @@ static void load_empty_flash(void)
 			  "Data has changed");
 }
 
-static void load_flash(int idx)
+static void load_flash_entries(int d_idx, int s_idx)
 {
 	memset(d_data, 0, sizeof(d_data));
 	memset(s_data, 0, sizeof(s_data));
 
 	zassert_equal(emds_load(), 0, "Load failed");
 
-	zassert_mem_equal(d_data, &expect_d_data[idx][0][0], sizeof(d_data),
+	zassert_mem_equal(d_data, &expect_d_data[d_idx][0][0], sizeof(d_data),
 			  "Data has changed");
-	zassert_mem_equal(s_data, &expect_s_data[idx][0], sizeof(s_data),
+	zassert_mem_equal(s_data, &expect_s_data[s_idx][0], sizeof(s_data),
 			  "Data has changed");
 }
 
+static void load_flash(int idx)
+{
+	load_flash_entries(idx, idx);
+}
+
 static void prepare(void)
 {
 	zassert_equal(emds_store(), -ECANCELED, "Prepare must be done before store");
@@ -171,12 +189,12 @@ static void prepare(void)
 	zassert_true(emds_is_ready(), "EMDS should be ready");
 }
 
-static void store(int idx)
+static void store_entries(int d_idx, int s_idx)
 {
 	zassert_true(emds_is_ready(), "Store should be ready to execute");
 
-	memcpy(d_data, &expect_d_data[idx][0][0], sizeof(d_data));
-	memcpy(s_data, &expect_s_data[idx][0], sizeof(s_data));
+	memcpy(d_data, &expect_d_data[d_idx][0][0], sizeof(d_data));
+	memcpy(s_data, &expect_s_data[s_idx][0], sizeof(s_data));
 
 #if defined(CONFIG_BT) && !defined(CONFIG_BT_LL_SW_SPLIT)
 	/* Disable bluetooth and mpsl scheduler if bluetooth is enabled. */
@@ -204,6 +222,11 @@ static void store(int idx)
 	zassert_true((store_time_us < estimate_store_time_us), "Store takes to long time");
 }
 
+static void store(int idx)
+{
+	store_entries(idx, idx);
+}
+
 static void clear(void)
 {
 	zassert_equal(emds_clear(), 0, "Clear failed");
@@ -313,6 +336,14 @@ ZTEST(no_store, test_no_store)
 	load_empty_flash();
 	prepare();
 	load_empty_flash();
+
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* The baseline written by the previous preparation is still valid. */
+	flash_write_cnt = 0;
+	prepare();
+	zassert_equal(flash_write_cnt, 0, "Valid baseline rewritten");
+	load_empty_flash();
+#endif
 }
 
 ZTEST(several_store, test_several_store)
@@ -321,9 +352,28 @@ ZTEST(several_store, test_several_store)
 	prepare();
 	store(2);
 	load_flash(2);
+
+	/* Only the dynamic entries change after the preparation. */
+	prepare();
+	store_entries(0, 2);
+	load_flash_entries(0, 2);
+
+	/* Only the static entry changes after the preparation. */
 	prepare();
 	store(0);
 	load_flash(0);
+
+	/* Nothing changes after the preparation. */
+	prepare();
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	flash_write_cnt = 0;
+#endif
+	store(0);
+#if defined(CONFIG_EMDS_INCREMENTAL_STORE)
+	/* Only the snapshot metadata is written. */
+	zassert_equal(flash_write_cnt, 1, "Unchanged chunks rewritten");
+#endif
+	load_flash(0);
 }
 
 ZTEST_SUITE(_setup, pragma_always, NULL, NULL, NULL, NULL);
@@ -624,4 +624,49 @@ ZTEST(emds_flash, test_write_speed)
 	microsecond_timer_cleanup();
 }
 
+/* Test checks comparing the stored data with a data chunk. */
+ZTEST(emds_flash, test_data_equal)
+{
+	int partition_index = sys_rand32_get() % PARTITIONS_NUM_MAX;
+	static uint8_t data_in[EMDS_FLASH_BLOCK_SIZE * 2];
+	static uint8_t data_cmp[EMDS_FLASH_BLOCK_SIZE * 2];
+	off_t data_off = EMDS_FLASH_BLOCK_SIZE;
+
+	for (int i = 0; i < sizeof(data_in); i++) {
+		data_in[i] = sys_rand32_get() % 256;
+	}
+
+	emds_flash_write_data(&partition[partition_index], data_off, data_in, sizeof(data_in));
+
+	memcpy(data_cmp, data_in, sizeof(data_cmp));
+	zassert_true(emds_flash_data_equal(&partition[partition_index], data_off, data_cmp,
+					   sizeof(data_cmp)),
+		     "Stored data not equal");
+	zassert_true(emds_flash_data_equal(&partition[partition_index],
+					   data_off + EMDS_FLASH_BLOCK_SIZE,
+					   &data_cmp[EMDS_FLASH_BLOCK_SIZE],
+					   EMDS_FLASH_BLOCK_SIZE),
+		     "Stored data not equal at offset");
+
+	data_cmp[sizeof(data_cmp) - 1] ^= 0x01;
+	zassert_false(emds_flash_data_equal(&partition[partition_index], data_off, data_cmp,
+					    sizeof(data_cmp)),
+		      "Changed data equal");
+	zassert_true(emds_flash_data_equal(&partition[partition_index], data_off, data_cmp,
+					   sizeof(data_cmp) - 1),
+		     "Unchanged part not equal");
+
+	if (!IS_ENABLED(CONFIG_SOC_FLASH_NRF_RRAM)) {
+		/* Flash must be erased before it can be rewritten. */
+		return;
+	}
+
+	/* Changed block rewritten in place, as done by incremental storing. */
+	emds_flash_write_data(&partition[partition_index], data_off + EMDS_FLASH_BLOCK_SIZE,
+			      &data_cmp[EMDS_FLASH_BLOCK_SIZE], EMDS_FLASH_BLOCK_SIZE);
+	zassert_true(emds_flash_data_equal(&partition[partition_index], data_off, data_cmp,
+					   sizeof(data_cmp)),
+		     "Rewritten data not equal");
+}
+
 ZTEST_SUITE(emds_flash, NULL, emds_flash_setup, NULL, emds_flash_partitions_erase, NULL);
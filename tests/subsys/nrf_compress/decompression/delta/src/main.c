@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <nrf_compress/implementation.h>
+
+#define SOURCE_SIZE 1000
+#define TARGET_SIZE_MAX 2000
+#define PATCH_SIZE_MAX 3000
+#define SMALL_INPUT_SIZE 7
+
+static uint8_t source[SOURCE_SIZE];
+static uint8_t target[TARGET_SIZE_MAX];
+static size_t target_size;
+static uint8_t patch[PATCH_SIZE_MAX];
+static size_t patch_size;
+static size_t source_pos;
+static uint8_t output_data[TARGET_SIZE_MAX];
+
+static int source_read(size_t offset, uint8_t *data, size_t len)
+{
+	if (offset + len > sizeof(source)) {
+		return -EINVAL;
+	}
+
+	memcpy(data, &source[offset], len);
+
+	return 0;
+}
+
+static delta_codec delta_inst = {
+	.source_read = source_read,
+	.source_size = SOURCE_SIZE,
+};
+
+static void patch_header_put(uint32_t source_size)
+{
+	sys_put_le32(NRF_COMPRESS_DELTA_MAGIC, &patch[0]);
+	patch[4] = NRF_COMPRESS_DELTA_VERSION;
+	patch[5] = 0;
+	patch[6] = 0;
+	patch[7] = 0;
+	sys_put_le32(source_size, &patch[8]);
+	/* Target size is filled in when the patch is complete. */
+	patch_size = NRF_COMPRESS_DELTA_HEADER_SIZE;
+	target_size = 0;
+	source_pos = 0;
+}
+
+/* Add a record copying diff_len source bytes, where every modify_every-th byte is changed,
+ * followed by extra_len new bytes.
+ */
+static void patch_record_put(uint32_t diff_len, uint32_t extra_len, int32_t seek,
+			     size_t modify_every)
+{
+	sys_put_le32(diff_len, &patch[patch_size]);
+	sys_put_le32(extra_len, &patch[patch_size + 4]);
+	sys_put_le32((uint32_t)seek, &patch[patch_size + 8]);
+	patch_size += NRF_COMPRESS_DELTA_RECORD_SIZE;
+
+	for (size_t i = 0; i < diff_len; i++) {
+		uint8_t diff = (modify_every != 0 && (i % modify_every) == 0) ? (uint8_t)i : 0;
+
+		patch[patch_size++] = diff;
+		target[target_size++] = source[source_pos++] + diff;
+	}
+
+	for (size_t i = 0; i < extra_len; i++) {
+		patch[patch_size++] = (uint8_t)(0xa5 ^ i);
+		target[target_size++] = (uint8_t)(0xa5 ^ i);
+	}
+
+	source_pos += seek;
+}
+
+static void patch_finish(void)
+{
+	sys_put_le32(target_size, &patch[12]);
+}
+
+static void patch_create(void)
+{
+	patch_header_put(SOURCE_SIZE);
+	patch_record_put(300, 20, 100, 17);
+	patch_record_put(400, 0, -700, 0);
+	patch_record_put(0, 3, 0, 0);
+	patch_record_put(50, 300, 0, 5);
+	patch_finish();
+}
+
+static int patch_apply(size_t input_chunk_size, size_t *output_len)
+{
+	int rc;
+	size_t pos = 0;
+	uint32_t offset;
+	uint8_t *output;
+	size_t output_size;
+	struct nrf_compress_implementation *implementation;
+
+	implementation = nrf_compress_implementation_find(NRF_COMPRESS_TYPE_DELTA);
+	zassert_not_null(implementation, "Expected implementation to not be NULL");
+
+	rc = implementation->init(&delta_inst, 0);
+	zassert_ok(rc, "Expected init to be successful");
+
+	*output_len = 0;
+
+	while (pos < patch_size) {
+		size_t chunk_size = implementation->decompress_bytes_needed(&delta_inst);
+		bool last = false;
+
+		chunk_size = MIN(chunk_size, input_chunk_size);
+
+		if ((pos + chunk_size) >= patch_size) {
+			chunk_size = patch_size - pos;
+			last = true;
+		}
+
+		rc = implementation->decompress(&delta_inst, &patch[pos], chunk_size, last,
+						&offset, &output, &output_size);
+		if (rc) {
+			break;
+		}
+
+		zassert_true(*output_len + output_size <= sizeof(output_data),
+			     "Too much output data");
+		memcpy(&output_data[*output_len], output, output_size);
+		*output_len += output_size;
+		pos += offset;
+	}
+
+	(void)implementation->deinit(&delta_inst);
+
+	return rc;
+}
+
+ZTEST(nrf_compress_decompression, test_valid_implementation)
+{
+	struct nrf_compress_implementation *implementation;
+
+	implementation = nrf_compress_implementation_find(NRF_COMPRESS_TYPE_DELTA);
+
+	zassert_not_null(implementation, "Expected implementation to not be NULL");
+	zassert_equal(implementation->id, NRF_COMPRESS_TYPE_DELTA,
+		      "Expected id element to have correct value");
+	zassert_equal(implementation->init(NULL, 0), -EINVAL,
+		      "Expected init without source to fail");
+}
+
+ZTEST(nrf_compress_decompression, test_valid_patch)
+{
+	size_t output_len;
+
+	patch_create();
+
+	zassert_ok(patch_apply(CONFIG_NRF_COMPRESS_CHUNK_SIZE, &output_len),
+		   "Expected patch to be applied");
+	zassert_equal(output_len, target_size, "Expected patched data size to match");
+	zassert_mem_equal(output_data, target, target_size, "Expected patched data to match");
+}
+
+ZTEST(nrf_compress_decompression, test_valid_patch_small_input)
+{
+	size_t output_len;
+
+	patch_create();
+
+	/* Record headers are split between calls. */
+	zassert_ok(patch_apply(SMALL_INPUT_SIZE, &output_len), "Expected patch to be applied");
+	zassert_equal(output_len, target_size, "Expected patched data size to match");
+	zassert_mem_equal(output_data, target, target_size, "Expected patched data to match");
+}
+
+ZTEST(nrf_compress_decompression, test_invalid_source_size)
+{
+	size_t output_len;
+
+	patch_header_put(SOURCE_SIZE + 1);
+	patch_record_put(10, 0, 0, 0);
+	patch_finish();
+
+	zassert_equal(patch_apply(CONFIG_NRF_COMPRESS_CHUNK_SIZE, &output_len), -EINVAL,
+		      "Expected patch for other source to be rejected");
+}
+
+ZTEST(nrf_compress_decompression, test_invalid_magic)
+{
+	size_t output_len;
+
+	patch_create();
+	patch[0] ^= 0xff;
+
+	zassert_equal(patch_apply(CONFIG_NRF_COMPRESS_CHUNK_SIZE, &output_len), -EINVAL,
+		      "Expected patch with invalid magic to be rejected");
+}
+
+ZTEST(nrf_compress_decompression, test_invalid_seek)
+{
+	size_t output_len;
+
+	patch_header_put(SOURCE_SIZE);
+	patch_record_put(10, 0, -20, 0);
+	patch_finish();
+
+	zassert_equal(patch_apply(CONFIG_NRF_COMPRESS_CHUNK_SIZE, &output_len), -EINVAL,
+		      "Expected seek before source start to be rejected");
+}
+
+ZTEST(nrf_compress_decompression, test_truncated_patch)
+{
+	size_t output_len;
+
+	patch_create();
+	patch_size -= 10;
+
+	zassert_equal(patch_apply(CONFIG_NRF_COMPRESS_CHUNK_SIZE, &output_len), -EINVAL,
+		      "Expected truncated patch to be rejected");
+}
+
+static void *setup(void)
+{
+	for (size_t i = 0; i < sizeof(source); i++) {
+		source[i] = (uint8_t)(i * 7 + 3);
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_compress_decompression, NULL, setup, NULL, NULL, NULL);
@@ -50,6 +50,28 @@ const uint8_t dummy_data_lzma1_input[] = {
 #include "dummy_data_input_lzma1.inc"
 };
 
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+/* Input valid lzma2 compressed data, DICT_READS_BLOCK_CNT copies of the same
+ * DICT_READS_BLOCK_SIZE bytes of random data, each one followed by DICT_READS_FILL_SIZE bytes
+ * filled with the index of the copy, compressed with lzma2_compress() from
+ * scripts/nrf_compress/delta_patch.py and a 16 KiB dictionary. Repeated blocks are further back
+ * than the dictionary cache reaches, so they are read from the external dictionary.
+ */
+const uint8_t dummy_data_dict_reads_input[] = {
+#include "dummy_data_dict_reads.inc"
+};
+
+#define DICT_READS_BLOCK_CNT 8
+#define DICT_READS_BLOCK_SIZE 256
+#define DICT_READS_FILL_SIZE 1024
+#define DICT_READS_OUTPUT_SIZE \
+	(DICT_READS_BLOCK_CNT * (DICT_READS_BLOCK_SIZE + DICT_READS_FILL_SIZE))
+/* Number of dictionary 'read' calls without the read cache, for the default chunk size
+ * and dictionary cache size.
+ */
+#define DICT_READS_UNCACHED_READ_CNT 1821
+#endif
+
 #if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
 
 #define LOCAL_DICT_SIZE 1024 * 128
@@ -347,8 +369,96 @@ ZTEST(nrf_compress_decompression, test_valid_data_large_decompression)
 		      "Expected 1 dictionary 'open' call");
 	zassert_equal(close_dict_cnt, 1,
 		      "Expected 1 dictionary 'close' call");
+
+	/* Report the cost of serving back-references from the external dictionary. */
+	TC_PRINT("Compressed %zu, decompressed %u bytes, %zu dictionary reads, "
+		 "%zu dictionary writes\n", sizeof(dummy_data_large_input),
+		 dummy_data_large_output_size, read_dict_cnt, write_dict_cnt);
+#endif
+}
+
+#if defined(CONFIG_NRF_COMPRESS_EXTERNAL_DICTIONARY)
+ZTEST(nrf_compress_decompression, test_valid_data_dictionary_reads)
+{
+	int rc;
+	uint32_t pos;
+	uint32_t offset;
+	uint8_t *output;
+	uint32_t output_size;
+	uint32_t total_output_size = 0;
+	struct nrf_compress_implementation *implementation;
+	void *inst = &lzma_inst;
+
+	if (!IS_ENABLED(CONFIG_NRF_COMPRESS_LZMA_VERSION_LZMA2) ||
+	    (CONFIG_NRF_COMPRESS_CHUNK_SIZE != 256) ||
+	    (CONFIG_NRF_COMPRESS_DICTIONARY_CACHE_SIZE != 1024)) {
+		ztest_test_skip();
+	}
+
+	reset_dictionary_counters();
+
+	implementation = nrf_compress_implementation_find(NRF_COMPRESS_TYPE_LZMA);
+
+	pos = 0;
+
+	rc = implementation->init(inst, DICT_READS_OUTPUT_SIZE);
+	zassert_ok(rc, "Expected init to be successful");
+
+	rc = implementation->decompress_bytes_needed(inst);
+	rc = implementation->decompress(inst, &dummy_data_dict_reads_input[pos], rc, false,
+					&offset, &output, &output_size);
+	zassert_ok(rc, "Expected header decompress to be successful");
+	pos += offset;
+
+	while (pos < sizeof(dummy_data_dict_reads_input)) {
+		rc = implementation->decompress_bytes_needed(inst);
+
+		if ((pos + rc) > sizeof(dummy_data_dict_reads_input)) {
+			rc = implementation->decompress(inst, &dummy_data_dict_reads_input[pos],
+							(sizeof(dummy_data_dict_reads_input) - pos),
+							true, &offset, &output, &output_size);
+		} else {
+			rc = implementation->decompress(inst, &dummy_data_dict_reads_input[pos], rc,
+							false, &offset, &output, &output_size);
+		}
+
+		zassert_ok(rc, "Expected data decompress to be successful");
+
+		total_output_size += output_size;
+		pos += offset;
+	}
+
+	(void)implementation->deinit(inst);
+
+	zassert_equal(total_output_size, DICT_READS_OUTPUT_SIZE,
+		      "Expected decompressed data size to match");
+
+	for (size_t i = 0; i < DICT_READS_BLOCK_CNT; i++) {
+		const uint8_t *block = &local_dictionary[i * (DICT_READS_BLOCK_SIZE +
+							      DICT_READS_FILL_SIZE)];
+
+		zassert_mem_equal(block, local_dictionary, DICT_READS_BLOCK_SIZE,
+				  "Expected block %zu to match the first one", i);
+
+		for (size_t j = 0; j < DICT_READS_FILL_SIZE; j++) {
+			zassert_equal(block[DICT_READS_BLOCK_SIZE + j], i,
+				      "Expected fill of block %zu to match", i);
+		}
+	}
+
+	TC_PRINT("%zu dictionary reads, %d without read cache\n", read_dict_cnt,
+		 DICT_READS_UNCACHED_READ_CNT);
+
+#if CONFIG_NRF_COMPRESS_DICTIONARY_READ_CACHE_LINES > 0
+	/* Every read cache line serves several bytes of the repeated blocks. */
+	zassert_true(read_dict_cnt * 4 < DICT_READS_UNCACHED_READ_CNT,
+		     "Expected read cache to reduce dictionary 'read' calls");
+#else
+	zassert_equal(read_dict_cnt, DICT_READS_UNCACHED_READ_CNT,
+		      "Expected different number of dictionary 'read' calls");
 #endif
 }
+#endif
 
 ZTEST(nrf_compress_decompression, test_invalid_data_decompression)
 {
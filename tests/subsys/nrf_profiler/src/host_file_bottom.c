@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_file_bottom.h"
+
+long host_file_read(const char *path, void *data, size_t len)
+{
+	int fd = open(path, O_RDONLY);
+	long ret;
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	ret = read(fd, data, len);
+	close(fd);
+
+	return ret;
+}
@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _HOST_FILE_BOTTOM_H_
+#define _HOST_FILE_BOTTOM_H_
+
+#include <stddef.h>
+
+/** @brief Read a host file.
+ *
+ * @param path Path to the file.
+ * @param data Buffer for the file content.
+ * @param len Size of the buffer.
+ *
+ * @return Number of bytes read, negative value on error.
+ */
+long host_file_read(const char *path, void *data, size_t len);
+
+#endif /* _HOST_FILE_BOTTOM_H_ */
@@ -4,9 +4,16 @@
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
 
+#include <inttypes.h>
+#include <stdlib.h>
 #include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
 #include <nrf_profiler.h>
 
+#ifdef CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE
+#include "host_file_bottom.h"
+#endif
+
 #define PROFILED_EVENTS_NB 100
 #define U_VALUE_START 0
 #define S_VALUE_START -50
@@ -120,4 +127,153 @@ ZTEST(suite_nrf_profiler, test_performance_03)
 	       "Elapsed time [us]: %d\n", PROFILED_EVENTS_NB, elapsed_time_us);
 }
 
+#ifdef CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE
+#define OVERFLOW_EVENTS_NB 1500
+/* Event type ID and timestamp precede the event data. */
+#define EVENT_HDR_SIZE (sizeof(uint8_t) + sizeof(uint32_t))
+/* Every event in the staging buffer is preceded by its length. */
+#define STAGED_NO_DATA_EVENT_SIZE (sizeof(uint16_t) + EVENT_HDR_SIZE)
+#define STAGED_NO_DATA_EVENTS_MAX \
+	(CONFIG_NRF_PROFILER_NORDIC_STAGING_BUFFER_SIZE / STAGED_NO_DATA_EVENT_SIZE)
+/* Six values followed by the string length and the string. */
+#define BIG_EVENT_PAYLOAD_LEN (14 + sizeof(uint8_t) + strlen(EXAMPLE_STRING))
+#define DATA_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE_PATH ".bin"
+#define INFO_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE_PATH ".info"
+
+struct event_reader {
+	const uint8_t *data;
+	size_t len;
+	size_t pos;
+	uint32_t timestamp;
+	const uint8_t *payload;
+};
+
+static uint8_t file_data[16384];
+static char info_data[1024];
+
+static void event_read(struct event_reader *reader, uint16_t event_id, size_t payload_len)
+{
+	const uint8_t *event = &reader->data[reader->pos];
+	uint32_t timestamp;
+
+	zassert_true(reader->pos + EVENT_HDR_SIZE + payload_len <= reader->len,
+		     "Missing event at offset %zu", reader->pos);
+	zassert_equal(event[0], event_id, "Unexpected event type at offset %zu", reader->pos);
+
+	/* Events logged on a single CPU must be sent in the logging order. */
+	timestamp = sys_get_le32(&event[sizeof(uint8_t)]);
+	zassert_true((int32_t)(timestamp - reader->timestamp) >= 0,
+		     "Event at offset %zu out of order", reader->pos);
+
+	reader->timestamp = timestamp;
+	reader->payload = &event[EVENT_HDR_SIZE];
+	reader->pos += EVENT_HDR_SIZE + payload_len;
+}
+
+static void check_big_event(const uint8_t *payload, size_t i)
+{
+	zassert_equal(sys_get_le32(&payload[0]), U_VALUE_START + i);
+	zassert_equal((int32_t)sys_get_le32(&payload[4]), S_VALUE_START + (int32_t)i);
+	zassert_equal(sys_get_le16(&payload[8]), U_VALUE_START + i);
+	zassert_equal((int16_t)sys_get_le16(&payload[10]), S_VALUE_START + (int16_t)i);
+	zassert_equal(payload[12], U_VALUE_START + i);
+	zassert_equal((int8_t)payload[13], S_VALUE_START + (int8_t)i);
+	zassert_equal(payload[14], strlen(EXAMPLE_STRING));
+	zassert_mem_equal(&payload[15], EXAMPLE_STRING, strlen(EXAMPLE_STRING));
+}
+
+static void check_info(const char *expected)
+{
+	zassert_not_null(strstr(info_data, expected), "Missing \"%s\" in %s", expected,
+			 INFO_FILE_PATH);
+}
+
+ZTEST(suite_nrf_profiler, test_staging_overflow_04)
+{
+	/* Let the flush thread empty the staging buffer. */
+	k_sleep(K_MSEC(2 * CONFIG_NRF_PROFILER_NORDIC_FLUSH_INTERVAL_MS));
+
+	/* The flush thread cannot run until all of the events are logged, so the staging
+	 * buffer overflows.
+	 */
+	k_sched_lock();
+	for (size_t i = 0; i < OVERFLOW_EVENTS_NB; i++) {
+		struct log_event_buf buf;
+
+		nrf_profiler_log_start(&buf);
+		nrf_profiler_log_send(&buf, no_data_event_id);
+	}
+	k_sched_unlock();
+}
+
+ZTEST(suite_nrf_profiler, test_transport_file_05)
+{
+	struct event_reader reader = {.data = file_data};
+	char expected[128];
+	const char *dropped_descr;
+	uint16_t dropped_event_id;
+	long len;
+
+	/* Flushes all of the logged events and writes the final event descriptions. */
+	nrf_profiler_term();
+
+	len = host_file_read(INFO_FILE_PATH, info_data, sizeof(info_data) - 1);
+	zassert_true(len > 0, "Cannot read %s", INFO_FILE_PATH);
+	info_data[len] = '\0';
+
+	snprintf(expected, sizeof(expected), "\nno data event,%u\n", no_data_event_id);
+	check_info(expected);
+	snprintf(expected, sizeof(expected), "\ndata event,%u,u32,value1\n", data_event_id);
+	check_info(expected);
+	snprintf(expected, sizeof(expected),
+		 "\nbig event,%u,u32,s32,u16,s16,u8,s8,s,"
+		 "value1,value2,value3,value4,value5,value6,string\n", big_event_id);
+	check_info(expected);
+	snprintf(expected, sizeof(expected),
+		 "<sys_config_start>\nsys_clock_hw_cycles_per_sec,%" PRIu32 "\n<sys_config_stop>\n",
+		 (uint32_t)sys_clock_hw_cycles_per_sec());
+	check_info(expected);
+
+	dropped_descr = strstr(info_data, "\n_nrf_profiler_dropped_events_,");
+	zassert_not_null(dropped_descr, "Missing dropped events description");
+	dropped_event_id = strtoul(dropped_descr + strlen("\n_nrf_profiler_dropped_events_,"),
+				   NULL, 10);
+	snprintf(expected, sizeof(expected), "\n_nrf_profiler_dropped_events_,%u,u32,count\n",
+		 dropped_event_id);
+	check_info(expected);
+
+	len = host_file_read(DATA_FILE_PATH, file_data, sizeof(file_data));
+	zassert_true(len > 0, "Cannot read %s", DATA_FILE_PATH);
+	zassert_true((size_t)len < sizeof(file_data), "%s too big for the test buffer", DATA_FILE_PATH);
+	reader.len = len;
+	reader.timestamp = sys_get_le32(&file_data[sizeof(uint8_t)]);
+
+	for (size_t i = 0; i < PROFILED_EVENTS_NB; i++) {
+		event_read(&reader, no_data_event_id, 0);
+	}
+
+	for (size_t i = 0; i < PROFILED_EVENTS_NB; i++) {
+		event_read(&reader, data_event_id, sizeof(uint32_t));
+		zassert_equal(sys_get_le32(reader.payload), i);
+	}
+
+	for (size_t i = 0; i < PROFILED_EVENTS_NB; i++) {
+		event_read(&reader, big_event_id, BIG_EVENT_PAYLOAD_LEN);
+		check_big_event(reader.payload, i);
+	}
+
+	/* Events that fit in the staging buffer are sent before the dropped events report. */
+	for (size_t i = 0; i < STAGED_NO_DATA_EVENTS_MAX; i++) {
+		event_read(&reader, no_data_event_id, 0);
+	}
+
+	event_read(&reader, dropped_event_id, sizeof(uint32_t));
+	zassert_equal(sys_get_le32(reader.payload), OVERFLOW_EVENTS_NB - STAGED_NO_DATA_EVENTS_MAX,
+		      "Wrong number of dropped events");
+
+	zassert_equal(reader.pos, reader.len, "Unexpected events at the end of %s",
+		      DATA_FILE_PATH);
+}
+#endif /* CONFIG_NRF_PROFILER_NORDIC_TRANSPORT_FILE */
+
 ZTEST_SUITE(suite_nrf_profiler, NULL, test_init, NULL, NULL, NULL);